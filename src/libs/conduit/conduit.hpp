@@ -62,7 +62,12 @@
 #include "conduit_data_type.hpp"
 #include "conduit_data_array.hpp"
 #include "conduit_schema.hpp"
+#include "conduit_flat_schema.hpp"
+#include "conduit_memory.hpp"
+#include "conduit_type_traits.hpp"
 #include "conduit_node.hpp"
+#include "conduit_node_view.hpp"
+#include "conduit_packed_node.hpp"
 #include "conduit_generator.hpp"
 #include "conduit_utils.hpp"
 
@@ -53,6 +53,7 @@
 // -- standard includes -- 
 //-----------------------------------------------------------------------------
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <limits>
 
@@ -74,6 +75,315 @@ namespace conduit
 {
 
 
+
+//-----------------------------------------------------------------------------
+//
+// -- diff summary helpers --
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// leaves are compared in blocks of this many elements, blocks are the unit
+// of early exit and of work sharing when openmp is enabled
+//-----------------------------------------------------------------------------
+static const index_t DIFF_SUMMARY_BLOCK_SIZE = 4096;
+
+//-----------------------------------------------------------------------------
+// leaves with fewer elements than this are always compared by one thread
+//-----------------------------------------------------------------------------
+static const index_t DIFF_SUMMARY_PARALLEL_THRESHOLD = 1048576;
+
+//---------------------------------------------------------------------------//
+template <typename T>
+inline bool
+diff_summary_mismatch(T t_val, T o_val, float64 epsilon)
+{
+    if(std::numeric_limits<T>::is_integer)
+    {
+        return t_val != o_val;
+    }
+    else
+    {
+        return std::fabs((float64)t_val - (float64)o_val) > epsilon;
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Compares elements [start,end) of two (possibly strided) arrays of T.
+// Returns the number of mismatched elements and updates the running max
+// absolute and relative differences. The loop body is branch free so the
+// compiler can vectorize the contiguous case.
+//---------------------------------------------------------------------------//
+template <typename T>
+index_t
+diff_summary_block(const uint8 *t_data, index_t t_stride,
+                   const uint8 *o_data, index_t o_stride,
+                   index_t start, index_t end,
+                   float64 epsilon,
+                   float64 &max_abs_diff,
+                   float64 &max_rel_diff)
+{
+    index_t num_mismatches = 0;
+    float64 blk_max_abs = max_abs_diff;
+    float64 blk_max_rel = max_rel_diff;
+
+    if(t_stride == (index_t)sizeof(T) && o_stride == (index_t)sizeof(T))
+    {
+        const T *t_ptr = (const T*)t_data;
+        const T *o_ptr = (const T*)o_data;
+
+        for(index_t i = start; i < end; i++)
+        {
+            const float64 t_val = (float64)t_ptr[i];
+            const float64 o_val = (float64)o_ptr[i];
+            const float64 a_diff = std::fabs(t_val - o_val);
+            const float64 a_mag  = std::max(std::fabs(t_val),
+                                            std::fabs(o_val));
+            const float64 r_diff = a_mag > 0.0 ? a_diff / a_mag : 0.0;
+
+            num_mismatches += diff_summary_mismatch(t_ptr[i],
+                                                    o_ptr[i],
+                                                    epsilon) ? 1 : 0;
+            blk_max_abs = a_diff > blk_max_abs ? a_diff : blk_max_abs;
+            blk_max_rel = r_diff > blk_max_rel ? r_diff : blk_max_rel;
+        }
+    }
+    else
+    {
+        for(index_t i = start; i < end; i++)
+        {
+            const T t_elem = *(const T*)(t_data + i * t_stride);
+            const T o_elem = *(const T*)(o_data + i * o_stride);
+            const float64 t_val = (float64)t_elem;
+            const float64 o_val = (float64)o_elem;
+            const float64 a_diff = std::fabs(t_val - o_val);
+            const float64 a_mag  = std::max(std::fabs(t_val),
+                                            std::fabs(o_val));
+            const float64 r_diff = a_mag > 0.0 ? a_diff / a_mag : 0.0;
+
+            num_mismatches += diff_summary_mismatch(t_elem,
+                                                    o_elem,
+                                                    epsilon) ? 1 : 0;
+            blk_max_abs = a_diff > blk_max_abs ? a_diff : blk_max_abs;
+            blk_max_rel = r_diff > blk_max_rel ? r_diff : blk_max_rel;
+        }
+    }
+
+    max_abs_diff = blk_max_abs;
+    max_rel_diff = blk_max_rel;
+
+    return num_mismatches;
+}
+
+//---------------------------------------------------------------------------//
+// Returns the index of the first mismatched element in [start,end),
+// only called for blocks that are known to contain a mismatch.
+//---------------------------------------------------------------------------//
+template <typename T>
+index_t
+diff_summary_first_mismatch(const uint8 *t_data, index_t t_stride,
+                            const uint8 *o_data, index_t o_stride,
+                            index_t start, index_t end,
+                            float64 epsilon)
+{
+    for(index_t i = start; i < end; i++)
+    {
+        if(diff_summary_mismatch(*(const T*)(t_data + i * t_stride),
+                                 *(const T*)(o_data + i * o_stride),
+                                 epsilon))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//---------------------------------------------------------------------------//
+// Summary-only comparison of the first `nelems` elements of two arrays.
+//
+// Records first mismatch index, mismatch count and max abs / rel error
+// under info["summary"] when the arrays differ, without allocating a
+// per-element "value" result. With `early_exit`, blocks after the first
+// block that contains a mismatch are skipped and the stats only cover the
+// elements compared (reported as "num_compared"). first_mismatch is
+// always the first mismatch of the arrays.
+//---------------------------------------------------------------------------//
+template <typename T>
+bool
+diff_summary(const DataArray<T> &t_array,
+             const DataArray<T> &o_array,
+             index_t nelems,
+             Node &info,
+             const std::string &protocol,
+             const float64 epsilon,
+             bool early_exit)
+{
+    const uint8 *t_data = (const uint8*)t_array.element_ptr(0);
+    const uint8 *o_data = (const uint8*)o_array.element_ptr(0);
+    const index_t t_stride = t_array.dtype().stride();
+    const index_t o_stride = o_array.dtype().stride();
+
+    const index_t num_blocks = (nelems + DIFF_SUMMARY_BLOCK_SIZE - 1) /
+                               DIFF_SUMMARY_BLOCK_SIZE;
+
+    index_t first_mismatch = nelems;
+    index_t num_mismatches = 0;
+    index_t num_compared   = 0;
+    float64 max_abs_diff   = 0.0;
+    float64 max_rel_diff   = 0.0;
+
+// min/max reductions require openmp 3.1
+#if defined(_OPENMP) && (_OPENMP >= 201107)
+    if(nelems >= DIFF_SUMMARY_PARALLEL_THRESHOLD)
+    {
+        // lowest block found to contain a mismatch: with early_exit,
+        // only the blocks after it are skipped, so the blocks before it
+        // (which may hold an earlier mismatch) are always scanned
+        index_t stop_block = num_blocks;
+
+        #pragma omp parallel for schedule(static) \
+                    reduction(min:first_mismatch) \
+                    reduction(+:num_mismatches,num_compared) \
+                    reduction(max:max_abs_diff,max_rel_diff)
+        for(index_t b = 0; b < num_blocks; b++)
+        {
+            index_t blk_stop = num_blocks;
+            #pragma omp atomic read
+            blk_stop = stop_block;
+
+            if(b > blk_stop)
+            {
+                continue;
+            }
+
+            const index_t start = b * DIFF_SUMMARY_BLOCK_SIZE;
+            const index_t end   = std::min(start + DIFF_SUMMARY_BLOCK_SIZE,
+                                           nelems);
+
+            index_t blk_mismatches = diff_summary_block<T>(t_data, t_stride,
+                                                           o_data, o_stride,
+                                                           start, end,
+                                                           epsilon,
+                                                           max_abs_diff,
+                                                           max_rel_diff);
+            num_compared += end - start;
+
+            if(blk_mismatches > 0)
+            {
+                num_mismatches += blk_mismatches;
+                first_mismatch = std::min(first_mismatch,
+                                          diff_summary_first_mismatch<T>(
+                                                        t_data, t_stride,
+                                                        o_data, o_stride,
+                                                        start, end,
+                                                        epsilon));
+                if(early_exit)
+                {
+                    #pragma omp critical(conduit_diff_summary_stop)
+                    {
+                        if(b < stop_block)
+                        {
+                            #pragma omp atomic write
+                            stop_block = b;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
+#endif
+    {
+        for(index_t b = 0; b < num_blocks; b++)
+        {
+            const index_t start = b * DIFF_SUMMARY_BLOCK_SIZE;
+            const index_t end   = std::min(start + DIFF_SUMMARY_BLOCK_SIZE,
+                                           nelems);
+
+            index_t blk_mismatches = diff_summary_block<T>(t_data, t_stride,
+                                                           o_data, o_stride,
+                                                           start, end,
+                                                           epsilon,
+                                                           max_abs_diff,
+                                                           max_rel_diff);
+            num_compared += end - start;
+
+            if(blk_mismatches > 0)
+            {
+                if(num_mismatches == 0)
+                {
+                    first_mismatch = diff_summary_first_mismatch<T>(
+                                                        t_data, t_stride,
+                                                        o_data, o_stride,
+                                                        start, end,
+                                                        epsilon);
+                }
+
+                num_mismatches += blk_mismatches;
+
+                if(early_exit)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    bool res = num_mismatches > 0;
+
+    if(res)
+    {
+        Node &info_summary = info["summary"];
+        info_summary["first_mismatch"] = first_mismatch;
+        info_summary["num_mismatches"] = num_mismatches;
+        info_summary["num_compared"]   = num_compared;
+        info_summary["max_abs_diff"]   = max_abs_diff;
+        info_summary["max_rel_diff"]   = max_rel_diff;
+
+        log::error(info, protocol,
+                   "data item(s) mismatch; see 'summary' section");
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+// Early exit comparison of the first `nelems` elements of two arrays, used
+// when a per-element result isn't requested. Stops at the first mismatch
+// and records only its index (info["first_mismatch"]).
+//---------------------------------------------------------------------------//
+template <typename T>
+bool
+diff_early_exit(const DataArray<T> &t_array,
+                const DataArray<T> &o_array,
+                index_t nelems,
+                Node &info,
+                const std::string &protocol,
+                const float64 epsilon)
+{
+    index_t first_mismatch = diff_summary_first_mismatch<T>(
+                                    (const uint8*)t_array.element_ptr(0),
+                                    t_array.dtype().stride(),
+                                    (const uint8*)o_array.element_ptr(0),
+                                    o_array.dtype().stride(),
+                                    0, nelems,
+                                    epsilon);
+
+    bool res = first_mismatch >= 0;
+
+    if(res)
+    {
+        info["first_mismatch"] = first_mismatch;
+
+        std::ostringstream oss;
+        oss << "data item mismatch at index " << first_mismatch
+            << "; see 'first_mismatch'";
+        log::error(info, protocol, oss.str());
+    }
+
+    return res;
+}
+
 //-----------------------------------------------------------------------------
 //
 // -- conduit::DataArray public methods --
@@ -154,7 +464,11 @@ DataArray<T>::compatible(const DataArray<T> &array) const
 //---------------------------------------------------------------------------//
 template <typename T> 
 bool
-DataArray<T>::diff(const DataArray<T> &array, Node &info, const float64 epsilon) const 
+DataArray<T>::diff(const DataArray<T> &array,
+                   Node &info,
+                   const float64 epsilon,
+                   bool summary,
+                   bool early_exit) const 
 { 
     const std::string protocol = "data_array::diff";
     bool res = false;
@@ -201,6 +515,18 @@ DataArray<T>::diff(const DataArray<T> &array, Node &info, const float64 epsilon)
             delete [] t_compact_data;
             delete [] o_compact_data;
         }
+        else if(summary)
+        {
+            res = diff_summary(*this, array, t_nelems,
+                               info, protocol,
+                               epsilon, early_exit);
+        }
+        else if(early_exit)
+        {
+            res = diff_early_exit(*this, array, t_nelems,
+                                  info, protocol,
+                                  epsilon);
+        }
         else
         {
             Node &info_value = info["value"];
@@ -235,7 +561,11 @@ DataArray<T>::diff(const DataArray<T> &array, Node &info, const float64 epsilon)
 //---------------------------------------------------------------------------//
 template <typename T> 
 bool
-DataArray<T>::diff_compatible(const DataArray<T> &array, Node &info, const float64 epsilon) const 
+DataArray<T>::diff_compatible(const DataArray<T> &array,
+                              Node &info,
+                              const float64 epsilon,
+                              bool summary,
+                              bool early_exit) const 
 { 
     const std::string protocol = "data_array::diff_compatible";
     bool res = false;
@@ -288,6 +618,18 @@ DataArray<T>::diff_compatible(const DataArray<T> &array, Node &info, const float
             delete [] t_compact_data;
             delete [] o_compact_data;
         }
+        else if(summary)
+        {
+            res = diff_summary(*this, array, t_nelems,
+                               info, protocol,
+                               epsilon, early_exit);
+        }
+        else if(early_exit)
+        {
+            res = diff_early_exit(*this, array, t_nelems,
+                                  info, protocol,
+                                  epsilon);
+        }
         else
         {
             Node &info_value = info["value"];
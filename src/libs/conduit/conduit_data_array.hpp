@@ -132,12 +132,22 @@ public:
                         { return m_data;}
 
     bool            compatible(const DataArray<T> &array) const;
+    /// when summary is true, numeric diffs record the first mismatch index,
+    /// mismatch count and max abs/rel error under info["summary"] instead of
+    /// a per-element info["value"] array. early_exit stops the comparison 
+    /// at the first block containing a mismatch. Without summary, 
+    /// early_exit stops at the first mismatch and records only its index
+    /// (info["first_mismatch"]) instead of the info["value"] array.
     bool            diff(const DataArray<T> &array,
                          Node &info,
-                         const float64 epsilon = CONDUIT_EPSILON) const;
+                         const float64 epsilon = CONDUIT_EPSILON,
+                         bool summary = false,
+                         bool early_exit = false) const;
     bool            diff_compatible(const DataArray<T> &array,
                                     Node &info,
-                                    const float64 epsilon = CONDUIT_EPSILON) const;
+                                    const float64 epsilon = CONDUIT_EPSILON,
+                                    bool summary = false,
+                                    bool early_exit = false) const;
 
 //-----------------------------------------------------------------------------
 // Setters
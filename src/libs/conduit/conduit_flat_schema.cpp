@@ -0,0 +1,1407 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_flat_schema.cpp
+///
+//-----------------------------------------------------------------------------
+#include "conduit_flat_schema.hpp"
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include <algorithm>
+#include <limits>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_error.hpp"
+#include "conduit_utils.hpp"
+
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// helpers used for serialization and child name lookup
+//-----------------------------------------------------------------------------
+
+// marks a binary flat schema image, also used to detect byte order
+// mismatches (the value reads back differently when swapped)
+static const int64 FLAT_SCHEMA_MAGIC = 0x46534331;
+// magic, number of entries, number of child ids, number of name bytes
+static const index_t FLAT_SCHEMA_HEADER_BYTES = 4 * sizeof(int64);
+
+//---------------------------------------------------------------------------//
+// overflow checked arithmetic for non-negative sizes, used to validate
+// deserialized entries
+//---------------------------------------------------------------------------//
+static bool
+flat_schema_add(index_t a, index_t b, index_t &res)
+{
+    if(a < 0 || b < 0 || a > std::numeric_limits<index_t>::max() - b)
+        return false;
+    res = a + b;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+static bool
+flat_schema_mult(index_t a, index_t b, index_t &res)
+{
+    if(a < 0 || b < 0 ||
+       (a != 0 && b > std::numeric_limits<index_t>::max() / a))
+        return false;
+    res = a * b;
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// orders entry indices by their name in the string table
+//---------------------------------------------------------------------------//
+struct FlatSchemaNameLess
+{
+    FlatSchemaNameLess(const std::vector<FlatSchema::Entry> &entries,
+                       const std::vector<char> &names)
+    : m_entries(entries),
+      m_names(names)
+    {}
+
+    bool operator()(int32 a, int32 b) const
+    {
+        return strcmp(&m_names[m_entries[a].name],
+                      &m_names[m_entries[b].name]) < 0;
+    }
+
+    const std::vector<FlatSchema::Entry> &m_entries;
+    const std::vector<char>              &m_names;
+};
+
+//---------------------------------------------------------------------------//
+// offset of the first leaf found in a depth first walk, returns false
+// if the schema has no leaves
+//---------------------------------------------------------------------------//
+static bool
+first_leaf_offset(const Schema &schema, index_t &offset)
+{
+    const DataType &dt = schema.dtype();
+    if(dt.is_object() || dt.is_list())
+    {
+        index_t nchld = schema.number_of_children();
+        for(index_t i = 0; i < nchld; i++)
+        {
+            if(first_leaf_offset(schema.child(i),offset))
+                return true;
+        }
+        return false;
+    }
+    offset = dt.offset();
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// checks if b has the same structure as a, with all offsets shifted
+//---------------------------------------------------------------------------//
+static bool
+same_shape(const Schema &a, const Schema &b, index_t shift)
+{
+    const DataType &a_dt = a.dtype();
+    const DataType &b_dt = b.dtype();
+
+    if(a_dt.id() != b_dt.id())
+        return false;
+
+    if(a_dt.is_object() || a_dt.is_list())
+    {
+        index_t nchld = a.number_of_children();
+        if(b.number_of_children() != nchld)
+            return false;
+
+        if(a_dt.is_object() && a.child_names() != b.child_names())
+            return false;
+
+        for(index_t i = 0; i < nchld; i++)
+        {
+            if(!same_shape(a.child(i),b.child(i),shift))
+                return false;
+        }
+        return true;
+    }
+
+    return ( (a_dt.number_of_elements() == b_dt.number_of_elements()) &&
+             (a_dt.stride()             == b_dt.stride()) &&
+             (a_dt.element_bytes()      == b_dt.element_bytes()) &&
+             (a_dt.endianness()         == b_dt.endianness()) &&
+             (a_dt.offset() + shift     == b_dt.offset()) );
+}
+
+//---------------------------------------------------------------------------//
+// returns true if the children of the given list can share one subtree,
+// and if so the offset shift between consecutive children
+//---------------------------------------------------------------------------//
+static bool
+repeated_children(const Schema &schema, index_t &repeat_stride)
+{
+    index_t nchld = schema.number_of_children();
+    repeat_stride = 0;
+
+    if(nchld < 2)
+        return false;
+
+    const Schema &first = schema.child(0);
+
+    index_t first_offset  = 0;
+    index_t second_offset = 0;
+    if(first_leaf_offset(first,first_offset) &&
+       first_leaf_offset(schema.child(1),second_offset))
+    {
+        repeat_stride = second_offset - first_offset;
+    }
+
+    if(repeat_stride < 0)
+        return false;
+
+    for(index_t i = 1; i < nchld; i++)
+    {
+        if(!same_shape(first,schema.child(i),i * repeat_stride))
+            return false;
+    }
+
+    return true;
+}
+
+
+//=============================================================================
+//-----------------------------------------------------------------------------
+//
+//
+// -- begin conduit::FlatSchema public methods --
+//
+//
+//-----------------------------------------------------------------------------
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+//
+/// FlatSchema construction and destruction.
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+FlatSchema::FlatSchema()
+: m_entries(),
+  m_children(),
+  m_sorted_children(),
+  m_names()
+{}
+
+//---------------------------------------------------------------------------//
+FlatSchema::FlatSchema(const FlatSchema &flat_schema)
+: m_entries(flat_schema.m_entries),
+  m_children(flat_schema.m_children),
+  m_sorted_children(flat_schema.m_sorted_children),
+  m_names(flat_schema.m_names)
+{}
+
+//---------------------------------------------------------------------------//
+FlatSchema::FlatSchema(const Schema &schema)
+{
+    set(schema);
+}
+
+//---------------------------------------------------------------------------//
+FlatSchema::~FlatSchema()
+{}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::reset()
+{
+    m_entries.clear();
+    m_children.clear();
+    m_sorted_children.clear();
+    m_names.clear();
+}
+
+//-----------------------------------------------------------------------------
+//
+/// FlatSchema set methods
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::set(const FlatSchema &flat_schema)
+{
+    if(this == &flat_schema)
+        return;
+
+    m_entries         = flat_schema.m_entries;
+    m_children        = flat_schema.m_children;
+    m_sorted_children = flat_schema.m_sorted_children;
+    m_names           = flat_schema.m_names;
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::set(const Schema &schema)
+{
+    reset();
+    std::map<std::string,int32> names;
+    freeze(schema,-1,-1,names);
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::list_of(const Schema &schema,
+                    index_t num_entries)
+{
+    if(num_entries < 0 ||
+       num_entries > (index_t)std::numeric_limits<int32>::max())
+    {
+        CONDUIT_ERROR("FlatSchema::list_of: invalid number of entries: "
+                      << num_entries);
+    }
+
+    reset();
+
+    Schema s_compact;
+    schema.compact_to(s_compact);
+
+    // the root list, laid out like the compact form of Node::list_of()
+    DataType dt = DataType::list();
+    Entry e;
+    e.number_of_elements = dt.number_of_elements();
+    e.offset             = dt.offset();
+    e.stride             = dt.stride();
+    e.element_bytes      = dt.element_bytes();
+    e.repeat_stride      = 0;
+    e.dtype_id           = (int32)dt.id();
+    e.endianness         = (int16)dt.endianness();
+    e.flags              = 0;
+    e.parent             = -1;
+    e.name               = -1;
+    e.children_begin     = 0;
+    e.number_of_children = (int32)num_entries;
+
+    if(num_entries > 1)
+    {
+        e.flags        |= REPEATED;
+        e.repeat_stride = s_compact.total_bytes_compact();
+    }
+
+    m_entries.push_back(e);
+
+    if(num_entries == 0)
+        return;
+
+    // all entries share the one subtree, no per entry schemas are built
+    m_children.resize(1);
+    m_sorted_children.resize(1);
+
+    std::map<std::string,int32> names;
+    m_children[0] = (int32)freeze(s_compact,0,-1,names);
+    m_sorted_children[0] = m_children[0];
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::list_of(const DataType &dtype,
+                    index_t num_entries)
+{
+    Schema s(dtype);
+    list_of(s,num_entries);
+}
+
+//---------------------------------------------------------------------------//
+FlatSchema &
+FlatSchema::operator=(const FlatSchema &flat_schema)
+{
+    set(flat_schema);
+    return *this;
+}
+
+//---------------------------------------------------------------------------//
+FlatSchema &
+FlatSchema::operator=(const Schema &schema)
+{
+    set(schema);
+    return *this;
+}
+
+//-----------------------------------------------------------------------------
+//
+/// Transformation Methods
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::to_schema(Schema &schema) const
+{
+    schema.reset();
+    if(!m_entries.empty())
+    {
+        thaw(0,0,schema);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::to_schema(index_t idx,
+                      index_t shift,
+                      Schema &schema) const
+{
+    if(idx < 0 || idx >= number_of_entries())
+    {
+        CONDUIT_ERROR("Invalid entry index: " << idx
+                      << " (flat schema has " << number_of_entries() 
+                      << " entries)");
+    }
+    schema.reset();
+    thaw(idx,shift,schema);
+}
+
+//---------------------------------------------------------------------------//
+std::string
+FlatSchema::to_json(index_t indent, 
+                    index_t depth,
+                    const std::string &pad,
+                    const std::string &eoe) const
+{
+   std::ostringstream oss;
+   to_json_stream(oss,indent,depth,pad,eoe);
+   return oss.str();
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::to_json_stream(std::ostream &os,
+                           index_t indent, 
+                           index_t depth,
+                           const std::string &pad,
+                           const std::string &eoe) const
+{
+    if(m_entries.empty())
+    {
+        DataType::empty().to_json_stream(os);
+    }
+    else
+    {
+        to_json_stream(0,0,os,indent,depth,pad,eoe);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+/// Entry access methods
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+DataType
+FlatSchema::dtype(index_t idx) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+    return DataType(e.dtype_id,
+                    e.number_of_elements,
+                    e.offset,
+                    e.stride,
+                    e.element_bytes,
+                    e.endianness);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::child(index_t idx, index_t i) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+    if(i < 0 || i >= e.number_of_children)
+    {
+        CONDUIT_ERROR("Invalid child index: " << i
+                      << " (entry " << idx << " has "
+                      << e.number_of_children << " children)");
+    }
+
+    if(e.flags & REPEATED)
+        return m_children[(size_t)e.children_begin];
+
+    return m_children[(size_t)(e.children_begin + i)];
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::child_offset(index_t idx, index_t i) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+    if(e.flags & REPEATED)
+        return i * e.repeat_stride;
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+const char *
+FlatSchema::name(index_t idx) const
+{
+    int32 n = m_entries[(size_t)idx].name;
+    if(n < 0)
+        return "";
+    return &m_names[(size_t)n];
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::child_index(index_t idx, const std::string &name) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+
+    if(e.dtype_id != DataType::OBJECT_ID)
+        return -1;
+
+    // binary search over the name sorted child ids
+    const char *key = name.c_str();
+    index_t lo = e.children_begin;
+    index_t hi = e.children_begin + e.number_of_children;
+    while(lo < hi)
+    {
+        index_t mid = lo + (hi - lo) / 2;
+        int32 cidx = m_sorted_children[(size_t)mid];
+        int cmp = strcmp(&m_names[m_entries[cidx].name], key);
+        if(cmp == 0)
+        {
+            return cidx;
+        }
+        else if(cmp < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::fetch_index(const std::string &path, index_t idx) const
+{
+    if(m_entries.empty())
+        return -1;
+
+    std::string p_curr;
+    std::string p_next;
+    std::string p = path;
+
+    while(!p.empty() && idx != -1)
+    {
+        utils::split_path(p,p_curr,p_next);
+        if(p_curr == "..")
+        {
+            idx = parent(idx);
+        }
+        else
+        {
+            idx = child_index(idx,p_curr);
+        }
+        p = p_next;
+    }
+
+    return idx;
+}
+
+//---------------------------------------------------------------------------//
+std::string
+FlatSchema::path(index_t idx) const
+{
+    index_t p = parent(idx);
+    if(p == -1)
+    {
+        return "";
+    }
+
+    std::ostringstream oss;
+    std::string parent_path = path(p);
+    if(parent_path.size() > 0)
+        oss << parent_path << "/";
+
+    if(dtype_id(p) == DataType::OBJECT_ID)
+    {
+        oss << name(idx);
+    }
+    else
+    {
+        // use order in the list
+        index_t nchld = number_of_children(p);
+        for(index_t i = 0; i < nchld; i++)
+        {
+            if(child(p,i) == idx)
+            {
+                oss << "[" << i << "]";
+                break;
+            }
+        }
+    }
+
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+//
+/// Information Methods
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::compatible(const FlatSchema &s) const
+{
+    if(m_entries.empty() || s.m_entries.empty())
+        return m_entries.empty() && s.m_entries.empty();
+
+    return compatible(0,s,0);
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::equals(const FlatSchema &s) const
+{
+    if(m_entries.empty() || s.m_entries.empty())
+        return m_entries.empty() && s.m_entries.empty();
+
+    return equals(0,0,s,0,0);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::total_strided_bytes() const
+{
+    std::vector<index_t> counts;
+    std::vector<index_t> max_shifts;
+    repeat_info(counts,max_shifts);
+
+    index_t res = 0;
+    size_t nentries = m_entries.size();
+    for(size_t i = 0; i < nentries; i++)
+    {
+        const Entry &e = m_entries[i];
+        if(e.dtype_id != DataType::OBJECT_ID &&
+           e.dtype_id != DataType::LIST_ID &&
+           e.dtype_id != DataType::EMPTY_ID)
+        {
+            res += counts[i] * 
+                   (e.stride * (e.number_of_elements - 1) + e.element_bytes);
+        }
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::total_bytes_compact() const
+{
+    std::vector<index_t> counts;
+    std::vector<index_t> max_shifts;
+    repeat_info(counts,max_shifts);
+
+    index_t res = 0;
+    size_t nentries = m_entries.size();
+    for(size_t i = 0; i < nentries; i++)
+    {
+        const Entry &e = m_entries[i];
+        if(e.dtype_id != DataType::OBJECT_ID &&
+           e.dtype_id != DataType::LIST_ID &&
+           e.dtype_id != DataType::EMPTY_ID)
+        {
+            res += counts[i] *
+                   DataType::default_bytes(e.dtype_id) * 
+                   e.number_of_elements;
+        }
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::spanned_bytes() const
+{
+    std::vector<index_t> counts;
+    std::vector<index_t> max_shifts;
+    repeat_info(counts,max_shifts);
+
+    index_t res = 0;
+    size_t nentries = m_entries.size();
+    for(size_t i = 0; i < nentries; i++)
+    {
+        const Entry &e = m_entries[i];
+        if(e.dtype_id != DataType::OBJECT_ID &&
+           e.dtype_id != DataType::LIST_ID)
+        {
+            index_t curr_span = max_shifts[i] + e.offset + 
+                                e.stride * (e.number_of_elements - 1) +
+                                e.element_bytes;
+            if(curr_span > res)
+            {
+                res = curr_span;
+            }
+        }
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::is_compact() const
+{
+    return total_bytes_compact() == total_strided_bytes();
+}
+
+//-----------------------------------------------------------------------------
+//
+/// Serialization Methods
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::serialized_size() const
+{
+    return FLAT_SCHEMA_HEADER_BYTES +
+           (index_t)(m_entries.size() * sizeof(Entry)) +
+           (index_t)(m_children.size() * sizeof(int32) * 2) +
+           (index_t)m_names.size();
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::serialize(std::vector<uint8> &data) const
+{
+    data.resize((size_t)serialized_size());
+    serialize(&data[0]);
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::serialize(void *data) const
+{
+    uint8 *ptr = (uint8*)data;
+
+    int64 header[4];
+    header[0] = FLAT_SCHEMA_MAGIC;
+    header[1] = (int64)m_entries.size();
+    header[2] = (int64)m_children.size();
+    header[3] = (int64)m_names.size();
+    memcpy(ptr,header,sizeof(header));
+    ptr += sizeof(header);
+
+    if(!m_entries.empty())
+    {
+        size_t nbytes = m_entries.size() * sizeof(Entry);
+        memcpy(ptr,&m_entries[0],nbytes);
+        ptr += nbytes;
+    }
+
+    if(!m_children.empty())
+    {
+        size_t nbytes = m_children.size() * sizeof(int32);
+        memcpy(ptr,&m_children[0],nbytes);
+        ptr += nbytes;
+        memcpy(ptr,&m_sorted_children[0],nbytes);
+        ptr += nbytes;
+    }
+
+    if(!m_names.empty())
+    {
+        memcpy(ptr,&m_names[0],m_names.size());
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::deserialize(const void *data, index_t data_size)
+{
+    reset();
+
+    if(data_size < FLAT_SCHEMA_HEADER_BYTES)
+    {
+        CONDUIT_ERROR("FlatSchema::deserialize: buffer is too small ("
+                      << data_size << " bytes) to hold a flat schema");
+    }
+
+    const uint8 *ptr = (const uint8*)data;
+
+    int64 header[4];
+    memcpy(header,ptr,sizeof(header));
+    ptr += sizeof(header);
+
+    if(header[0] != FLAT_SCHEMA_MAGIC)
+    {
+        CONDUIT_ERROR("FlatSchema::deserialize: buffer does not hold a "
+                      "flat schema, or was written with a different "
+                      "byte order");
+    }
+
+    index_t nentries = (index_t)header[1];
+    index_t nchildren = (index_t)header[2];
+    index_t nnames = (index_t)header[3];
+
+    // check each block against the remaining bytes, so the counts
+    // can't overflow the size computation
+    index_t remaining = data_size - FLAT_SCHEMA_HEADER_BYTES;
+    bool fits = nentries >= 0 && nchildren >= 0 && nnames >= 0 &&
+                nentries <= remaining / (index_t)sizeof(Entry);
+    if(fits)
+    {
+        remaining -= nentries * (index_t)sizeof(Entry);
+        fits = nchildren <= remaining / ((index_t)sizeof(int32) * 2);
+    }
+    if(fits)
+    {
+        remaining -= nchildren * (index_t)sizeof(int32) * 2;
+        fits = nnames <= remaining;
+    }
+
+    if(!fits)
+    {
+        CONDUIT_ERROR("FlatSchema::deserialize: buffer is too small ("
+                      << data_size << " bytes) to hold flat schema with "
+                      << nentries << " entries, " << nchildren 
+                      << " children and " << nnames << " name bytes");
+    }
+
+    m_entries.resize((size_t)nentries);
+    m_children.resize((size_t)nchildren);
+    m_sorted_children.resize((size_t)nchildren);
+    m_names.resize((size_t)nnames);
+
+    if(nentries > 0)
+    {
+        size_t nbytes = m_entries.size() * sizeof(Entry);
+        memcpy(&m_entries[0],ptr,nbytes);
+        ptr += nbytes;
+    }
+
+    if(nchildren > 0)
+    {
+        size_t nbytes = m_children.size() * sizeof(int32);
+        memcpy(&m_children[0],ptr,nbytes);
+        ptr += nbytes;
+        memcpy(&m_sorted_children[0],ptr,nbytes);
+        ptr += nbytes;
+    }
+
+    if(nnames > 0)
+    {
+        memcpy(&m_names[0],ptr,(size_t)nnames);
+    }
+
+    // the entries index the child and name tables directly, make sure
+    // a malformed image can't lead any method out of bounds
+    std::string msg;
+    if(!validate(msg))
+    {
+        reset();
+        CONDUIT_ERROR("FlatSchema::deserialize: invalid flat schema: "
+                      << msg);
+    }
+}
+
+
+//=============================================================================
+//-----------------------------------------------------------------------------
+//
+//
+// -- begin conduit::FlatSchema private methods --
+//
+//
+//-----------------------------------------------------------------------------
+//=============================================================================
+
+//---------------------------------------------------------------------------//
+index_t
+FlatSchema::freeze(const Schema &schema,
+                   int32 parent,
+                   int32 name,
+                   std::map<std::string,int32> &names)
+{
+    const DataType &dt = schema.dtype();
+    index_t idx = (index_t)m_entries.size();
+
+    Entry e;
+    e.number_of_elements = dt.number_of_elements();
+    e.offset             = dt.offset();
+    e.stride             = dt.stride();
+    e.element_bytes      = dt.element_bytes();
+    e.repeat_stride      = 0;
+    e.dtype_id           = (int32)dt.id();
+    e.endianness         = (int16)dt.endianness();
+    e.flags              = 0;
+    e.parent             = parent;
+    e.name               = name;
+    e.children_begin     = (int32)m_children.size();
+    e.number_of_children = 0;
+
+    if(dt.id() == DataType::OBJECT_ID || dt.id() == DataType::LIST_ID)
+    {
+        e.number_of_children = (int32)schema.number_of_children();
+    }
+
+    if(dt.id() == DataType::LIST_ID &&
+       repeated_children(schema,e.repeat_stride))
+    {
+        e.flags |= REPEATED;
+    }
+
+    m_entries.push_back(e);
+
+    if(e.number_of_children == 0)
+        return idx;
+
+    // reserve our slots in the child index arrays, our children's
+    // children will be placed after them
+    size_t cbegin = (size_t)e.children_begin;
+    size_t nchld  = (size_t)e.number_of_children;
+
+    // the children of a repeated list share the first child's subtree
+    if(e.flags & REPEATED)
+        nchld = 1;
+
+    m_children.resize(cbegin + nchld);
+    m_sorted_children.resize(cbegin + nchld);
+
+    const std::vector<Schema*> &chld = schema.children();
+    bool is_obj = (dt.id() == DataType::OBJECT_ID);
+
+    for(size_t i = 0; i < nchld; i++)
+    {
+        int32 cname = -1;
+        if(is_obj)
+        {
+            const std::string &cname_str = schema.object_order()[i];
+            std::map<std::string,int32>::iterator itr = names.find(cname_str);
+            if(itr == names.end())
+            {
+                cname = (int32)m_names.size();
+                m_names.insert(m_names.end(),
+                               cname_str.begin(),
+                               cname_str.end());
+                m_names.push_back('\0');
+                names[cname_str] = cname;
+            }
+            else
+            {
+                cname = itr->second;
+            }
+        }
+
+        m_children[cbegin + i] = (int32)freeze(*chld[i],
+                                               (int32)idx,
+                                               cname,
+                                               names);
+    }
+
+    std::copy(m_children.begin() + cbegin,
+              m_children.begin() + cbegin + nchld,
+              m_sorted_children.begin() + cbegin);
+
+    if(is_obj)
+    {
+        std::sort(m_sorted_children.begin() + cbegin,
+                  m_sorted_children.begin() + cbegin + nchld,
+                  FlatSchemaNameLess(m_entries,m_names));
+    }
+
+    return idx;
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::thaw(index_t idx,
+                 index_t shift,
+                 Schema &schema) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+
+    if(e.dtype_id == DataType::OBJECT_ID)
+    {
+        schema.init_object();
+        std::vector<Schema*>           &chld  = schema.children();
+        std::map<std::string, index_t> &omap  = schema.object_map();
+        std::vector<std::string>       &order = schema.object_order();
+
+        chld.reserve((size_t)e.number_of_children);
+        order.reserve((size_t)e.number_of_children);
+
+        for(index_t i = 0; i < e.number_of_children; i++)
+        {
+            index_t cidx = m_children[(size_t)(e.children_begin + i)];
+            Schema *c = new Schema();
+            c->m_parent = &schema;
+            chld.push_back(c);
+            order.push_back(name(cidx));
+            omap[order.back()] = i;
+            thaw(cidx,shift,*c);
+        }
+    }
+    else if(e.dtype_id == DataType::LIST_ID)
+    {
+        schema.init_list();
+        std::vector<Schema*> &chld = schema.children();
+        chld.reserve((size_t)e.number_of_children);
+
+        for(index_t i = 0; i < e.number_of_children; i++)
+        {
+            Schema *c = new Schema();
+            c->m_parent = &schema;
+            chld.push_back(c);
+            thaw(child(idx,i),shift + child_offset(idx,i),*c);
+        }
+    }
+    else
+    {
+        DataType dt = dtype(idx);
+        dt.set_offset(dt.offset() + shift);
+        schema.set(dt);
+    }
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::compatible(index_t idx,
+                       const FlatSchema &s,
+                       index_t s_idx) const
+{
+    const Entry &e   = m_entries[(size_t)idx];
+    const Entry &s_e = s.m_entries[(size_t)s_idx];
+
+    if(e.dtype_id != s_e.dtype_id)
+        return false;
+
+    bool res = true;
+
+    if(e.dtype_id == DataType::OBJECT_ID)
+    {
+        // each of s's entries that match paths must have dtypes that match
+        for(index_t i = 0; i < s_e.number_of_children && res; i++)
+        {
+            index_t s_cidx = s.m_children[(size_t)(s_e.children_begin + i)];
+            const char *s_cname = s.name(s_cidx);
+
+            // common case: children are in the same order
+            index_t cidx = -1;
+            if(i < e.number_of_children)
+            {
+                cidx = m_children[(size_t)(e.children_begin + i)];
+                if(strcmp(name(cidx),s_cname) != 0)
+                    cidx = -1;
+            }
+
+            if(cidx == -1)
+                cidx = child_index(idx,s_cname);
+
+            if(cidx != -1)
+                res = compatible(cidx,s,s_cidx);
+        }
+    }
+    else if(e.dtype_id == DataType::LIST_ID)
+    {
+        // can't be compatible in this case
+        if(e.number_of_children < s_e.number_of_children)
+            return false;
+
+        // offsets don't matter here, so shared children only need
+        // to be checked once
+        index_t nchld = s_e.number_of_children;
+        if( (e.flags & REPEATED) && (s_e.flags & REPEATED) )
+            nchld = std::min(nchld,(index_t)1);
+
+        for(index_t i = 0; i < nchld && res; i++)
+        {
+            res = compatible(child(idx,i),s,s.child(s_idx,i));
+        }
+    }
+    else
+    {
+        res = ( (e.element_bytes == s_e.element_bytes) &&
+                (e.number_of_elements >= s_e.number_of_elements) );
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::equals(index_t idx,
+                   index_t shift,
+                   const FlatSchema &s,
+                   index_t s_idx,
+                   index_t s_shift) const
+{
+    const Entry &e   = m_entries[(size_t)idx];
+    const Entry &s_e = s.m_entries[(size_t)s_idx];
+
+    if(e.dtype_id != s_e.dtype_id)
+        return false;
+
+    // for objects, names are unique, so the same number of children 
+    // and finding all of s's children implies the name sets match
+    if( (e.dtype_id == DataType::OBJECT_ID || 
+         e.dtype_id == DataType::LIST_ID ) &&
+        e.number_of_children != s_e.number_of_children)
+        return false;
+
+    bool res = true;
+
+    if(e.dtype_id == DataType::OBJECT_ID)
+    {
+        for(index_t i = 0; i < s_e.number_of_children && res; i++)
+        {
+            index_t s_cidx = s.m_children[(size_t)(s_e.children_begin + i)];
+            const char *s_cname = s.name(s_cidx);
+
+            index_t cidx = m_children[(size_t)(e.children_begin + i)];
+            if(strcmp(name(cidx),s_cname) != 0)
+                cidx = child_index(idx,s_cname);
+
+            if(cidx != -1)
+            {
+                res = equals(cidx,shift,s,s_cidx,s_shift);
+            }
+            else
+            {
+                res = false;
+            }
+        }
+    }
+    else if(e.dtype_id == DataType::LIST_ID)
+    {
+        // shared children with the same offset shifts only need
+        // to be checked once
+        index_t nchld = s_e.number_of_children;
+        if( (e.flags & REPEATED) && (s_e.flags & REPEATED) &&
+            e.repeat_stride == s_e.repeat_stride)
+            nchld = std::min(nchld,(index_t)1);
+
+        for(index_t i = 0; i < nchld && res; i++)
+        {
+            res = equals(child(idx,i),
+                         shift + child_offset(idx,i),
+                         s,
+                         s.child(s_idx,i),
+                         s_shift + s.child_offset(s_idx,i));
+        }
+    }
+    else
+    {
+        res = ( (e.number_of_elements == s_e.number_of_elements) &&
+                (e.offset + shift == s_e.offset + s_shift) &&
+                (e.element_bytes == s_e.element_bytes) &&
+                (e.endianness == s_e.endianness) );
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::repeat_info(std::vector<index_t> &counts,
+                        std::vector<index_t> &max_shifts) const
+{
+    size_t nentries = m_entries.size();
+    counts.resize(nentries);
+    max_shifts.resize(nentries);
+
+    // parents always precede their children
+    for(size_t i = 0; i < nentries; i++)
+    {
+        const Entry &e = m_entries[i];
+        if(e.parent == -1)
+        {
+            counts[i]     = 1;
+            max_shifts[i] = 0;
+        }
+        else
+        {
+            const Entry &p = m_entries[(size_t)e.parent];
+            counts[i]     = counts[(size_t)e.parent];
+            max_shifts[i] = max_shifts[(size_t)e.parent];
+            if(p.flags & REPEATED)
+            {
+                counts[i]     *= p.number_of_children;
+                max_shifts[i] += (p.number_of_children - 1) * p.repeat_stride;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatSchema::validate(std::string &msg) const
+{
+    std::ostringstream oss;
+
+    index_t nentries  = (index_t)m_entries.size();
+    index_t nchildren = (index_t)m_children.size();
+    index_t nnames    = (index_t)m_names.size();
+
+    // all names are null terminated if the table is
+    if(nnames > 0 && m_names[(size_t)(nnames - 1)] != '\0')
+    {
+        msg = "name table is not null terminated";
+        return false;
+    }
+
+    if(nentries == 0 && nchildren > 0)
+    {
+        msg = "child table without entries";
+        return false;
+    }
+
+    // per entry repeat counts and max offset shifts (see repeat_info()),
+    // computed here with overflow checks
+    std::vector<index_t> counts((size_t)nentries,1);
+    std::vector<index_t> max_shifts((size_t)nentries,0);
+
+    index_t total_bytes = 0;
+
+    for(index_t i = 0; i < nentries; i++)
+    {
+        const Entry &e = m_entries[(size_t)i];
+
+        // parents precede their children
+        bool parent_ok = (i == 0) ? (e.parent == -1) :
+                                    (e.parent >= 0 && e.parent < i);
+        if(!parent_ok)
+        {
+            oss << "entry " << i << " has an invalid parent: " << e.parent;
+            msg = oss.str();
+            return false;
+        }
+
+        if(e.dtype_id < DataType::EMPTY_ID ||
+           e.dtype_id > DataType::CHAR8_STR_ID)
+        {
+            oss << "entry " << i << " has an invalid dtype id: "
+                << e.dtype_id;
+            msg = oss.str();
+            return false;
+        }
+
+        // only object children are named
+        bool obj_child = e.parent >= 0 &&
+            m_entries[(size_t)e.parent].dtype_id == DataType::OBJECT_ID;
+        bool name_ok = obj_child ? (e.name >= 0 && e.name < nnames) :
+                                   (e.name == -1);
+        if(!name_ok)
+        {
+            oss << "entry " << i << " has an invalid name offset: "
+                << e.name;
+            msg = oss.str();
+            return false;
+        }
+
+        if(e.parent >= 0)
+        {
+            const Entry &p = m_entries[(size_t)e.parent];
+            counts[(size_t)i]     = counts[(size_t)e.parent];
+            max_shifts[(size_t)i] = max_shifts[(size_t)e.parent];
+            index_t shift = 0;
+            if( (p.flags & REPEATED) &&
+                ( !flat_schema_mult(counts[(size_t)i],
+                                    p.number_of_children,
+                                    counts[(size_t)i]) ||
+                  !flat_schema_mult(p.number_of_children - 1,
+                                    p.repeat_stride,
+                                    shift) ||
+                  !flat_schema_add(max_shifts[(size_t)i],
+                                   shift,
+                                   max_shifts[(size_t)i]) ) )
+            {
+                oss << "entry " << i << " repeats overflow";
+                msg = oss.str();
+                return false;
+            }
+        }
+
+        if(e.dtype_id == DataType::OBJECT_ID ||
+           e.dtype_id == DataType::LIST_ID)
+        {
+            bool repeated = (e.flags & REPEATED) != 0;
+            if((e.flags & ~REPEATED) != 0 ||
+               (repeated && (e.dtype_id != DataType::LIST_ID ||
+                             e.number_of_children < 1 ||
+                             e.repeat_stride < 0)))
+            {
+                oss << "entry " << i << " has invalid flags: " << e.flags;
+                msg = oss.str();
+                return false;
+            }
+
+            index_t nslots = repeated ? 1 : (index_t)e.number_of_children;
+            if(e.number_of_children < 0 ||
+               e.children_begin < 0 ||
+               (index_t)e.children_begin + nslots > nchildren)
+            {
+                oss << "entry " << i << " has an invalid child range: ["
+                    << e.children_begin << ","
+                    << (index_t)e.children_begin + nslots << ")";
+                msg = oss.str();
+                return false;
+            }
+
+            for(index_t j = 0; j < nslots; j++)
+            {
+                size_t slot = (size_t)(e.children_begin + j);
+                int32 c  = m_children[slot];
+                int32 sc = m_sorted_children[slot];
+                // children follow their parent, which also rules out
+                // cycles
+                if(c  <= i || c  >= nentries ||
+                   sc <= i || sc >= nentries ||
+                   m_entries[(size_t)c].parent  != i ||
+                   m_entries[(size_t)sc].parent != i)
+                {
+                    oss << "entry " << i << " has an invalid child id";
+                    msg = oss.str();
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            index_t def_bytes = DataType::default_bytes(e.dtype_id);
+            index_t nele  = e.number_of_elements;
+            index_t span  = 0;
+            index_t bytes = 0;
+            if(e.number_of_children != 0 || e.flags != 0 ||
+               nele < 0 || e.offset < 0 || e.stride < 0 ||
+               e.element_bytes < def_bytes ||
+               !flat_schema_mult(e.stride, nele > 0 ? nele - 1 : 0, span) ||
+               !flat_schema_add(span,e.offset,span) ||
+               !flat_schema_add(span,e.element_bytes,span) ||
+               !flat_schema_add(span,max_shifts[(size_t)i],span) ||
+               !flat_schema_mult(def_bytes,nele,bytes) ||
+               !flat_schema_mult(bytes,counts[(size_t)i],bytes) ||
+               !flat_schema_add(total_bytes,bytes,total_bytes))
+            {
+                oss << "entry " << i << " has an invalid data layout";
+                msg = oss.str();
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatSchema::to_json_stream(index_t idx,
+                           index_t shift,
+                           std::ostream &os,
+                           index_t indent, 
+                           index_t depth,
+                           const std::string &pad,
+                           const std::string &eoe) const
+{
+    const Entry &e = m_entries[(size_t)idx];
+    index_t nchildren = e.number_of_children;
+
+    if(e.dtype_id == DataType::OBJECT_ID)
+    {
+        os << eoe;
+        utils::indent(os,indent,depth,pad);
+        os << "{" << eoe;
+
+        for(index_t i=0; i < nchildren;i++)
+        {
+            index_t cidx = m_children[(size_t)(e.children_begin + i)];
+            utils::indent(os,indent,depth+1,pad);
+            os << "\""<< name(cidx) << "\": ";
+            to_json_stream(cidx,shift,os,indent,depth+1,pad,eoe);
+            if(i < nchildren-1)
+                os << ",";
+            os << eoe;
+        }
+        utils::indent(os,indent,depth,pad);
+        os << "}";
+    }
+    else if(e.dtype_id == DataType::LIST_ID)
+    {
+        os << eoe;
+        utils::indent(os,indent,depth,pad);
+        os << "[" << eoe;
+
+        for(index_t i=0; i < nchildren;i++)
+        {
+            utils::indent(os,indent,depth+1,pad);
+            to_json_stream(child(idx,i),
+                           shift + child_offset(idx,i),
+                           os,indent,depth+1,pad,eoe);
+            if(i < nchildren-1)
+                os << ",";
+            os << eoe;
+        }
+        utils::indent(os,indent,depth,pad);
+        os << "]";
+    }
+    else // assume leaf data type
+    {
+        DataType dt = dtype(idx);
+        dt.set_offset(dt.offset() + shift);
+        dt.to_json_stream(os);
+    }
+}
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
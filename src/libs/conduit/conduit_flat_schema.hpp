@@ -0,0 +1,347 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_flat_schema.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef CONDUIT_FLAT_SCHEMA_HPP
+#define CONDUIT_FLAT_SCHEMA_HPP
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <map>
+#include <vector>
+#include <string>
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_core.hpp"
+#include "conduit_data_type.hpp"
+#include "conduit_schema.hpp"
+
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::FlatSchema --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::FlatSchema
+///
+/// description:
+///  An immutable, contiguous representation of a Schema tree.
+///
+///  Entries are stored in depth-first (pre-order) order in a single array
+///  of fixed size records, entry 0 is the root. Parent links and child
+///  lists are stored as indices, and object child names live in a shared
+///  (de-duplicated) string table. Walking a FlatSchema touches a handful
+///  of contiguous arrays instead of a graph of heap allocated Schemas.
+///
+///  A FlatSchema is created by freezing a Schema, and can be thawed back
+///  into a Schema with to_schema().
+///
+///  Lists whose children all share the same structure, and only differ
+///  by a constant offset shift (for example the result of
+///  Node::list_of()), are stored once: the children of such a "repeated"
+///  list share a single entry subtree, and child_offset() provides the
+///  offset shift for each child.
+///
+///  Sharing only applies to this frozen form, and only to list children:
+///  freezing a Schema still walks all of its children, and Schema, Node
+///  (including Node::list_of()) and Schema::to_json() are unchanged.
+///  Identical object subtrees are not shared. Use list_of() to build a
+///  repeated list without creating the per entry Schemas.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API FlatSchema
+{
+public:
+
+//-----------------------------------------------------------------------------
+/// Record describing a single schema entry.
+//-----------------------------------------------------------------------------
+    struct Entry
+    {
+        int64 number_of_elements;
+        int64 offset;
+        int64 stride;
+        int64 element_bytes;
+        /// offset shift between the children of a repeated list
+        int64 repeat_stride;
+        int32 dtype_id;
+        int16 endianness;
+        int16 flags;
+        /// index of the parent entry (-1 for the root)
+        int32 parent;
+        /// offset of the name in the string table (-1 if not an obj child)
+        int32 name;
+        /// offset of this entry's children in the child index arrays
+        int32 children_begin;
+        int32 number_of_children;
+    };
+
+    /// Entry flags
+    static const int16 REPEATED = 1;
+
+//----------------------------------------------------------------------------
+//
+/// FlatSchema construction and destruction.
+//
+//----------------------------------------------------------------------------
+    /// create an empty flat schema
+    FlatSchema();
+    /// flat schema copy constructor
+    FlatSchema(const FlatSchema &flat_schema);
+    /// freeze the passed schema
+    explicit FlatSchema(const Schema &schema);
+
+    /// FlatSchema Destructor
+    ~FlatSchema();
+    /// return to the default (empty) state
+    void        reset();
+
+//-----------------------------------------------------------------------------
+//
+/// FlatSchema set methods
+//
+//-----------------------------------------------------------------------------
+    void        set(const FlatSchema &flat_schema);
+    /// freeze the passed schema
+    void        set(const Schema &schema);
+
+    /// build the flat form of a compact list of num_entries copies of
+    /// schema (the layout used by Node::list_of()), the entries share
+    /// one subtree and no per entry Schemas are created
+    void        list_of(const Schema &schema,
+                        index_t num_entries);
+    void        list_of(const DataType &dtype,
+                        index_t num_entries);
+
+    FlatSchema &operator=(const FlatSchema &flat_schema);
+    FlatSchema &operator=(const Schema &schema);
+
+//-----------------------------------------------------------------------------
+//
+/// Transformation Methods
+//
+//-----------------------------------------------------------------------------
+    /// thaw into a (tree) Schema
+    void        to_schema(Schema &schema) const;
+    /// thaw the subtree rooted at the entry idx, with shift added to 
+    /// the offsets of its leaves (see child_offset())
+    void        to_schema(index_t idx,
+                          index_t shift,
+                          Schema &schema) const;
+
+    std::string to_json(index_t indent=2, 
+                        index_t depth=0,
+                        const std::string &pad=" ",
+                        const std::string &eoe="\n") const;
+
+    void        to_json_stream(std::ostream &os,
+                               index_t indent=2, 
+                               index_t depth=0,
+                               const std::string &pad=" ",
+                               const std::string &eoe="\n") const;
+
+//-----------------------------------------------------------------------------
+//
+/// Entry access methods
+//
+//-----------------------------------------------------------------------------
+    /// number of entries (the root counts as one)
+    index_t      number_of_entries() const
+                    { return (index_t)m_entries.size();}
+
+    const Entry &entry(index_t idx) const
+                    { return m_entries[(size_t)idx];}
+
+    /// full data type of the entry at the given index
+    DataType     dtype(index_t idx) const;
+
+    index_t      dtype_id(index_t idx) const
+                    { return m_entries[(size_t)idx].dtype_id;}
+
+    /// index of the parent entry, -1 for the root
+    index_t      parent(index_t idx) const
+                    { return m_entries[(size_t)idx].parent;}
+
+    index_t      number_of_children(index_t idx) const
+                    { return m_entries[(size_t)idx].number_of_children;}
+
+    /// true if the children of the list entry at idx share one entry
+    bool         is_repeated(index_t idx) const
+                    { return (m_entries[(size_t)idx].flags & REPEATED) != 0;}
+
+    /// entry index of the i-th child of the entry at the given index
+    /// (for a repeated list, this is the same entry for all children)
+    index_t      child(index_t idx, index_t i) const;
+    /// offset shift to apply to the i-th child's subtree
+    /// (non-zero only for the children of a repeated list)
+    index_t      child_offset(index_t idx, index_t i) const;
+
+    /// name of an object child entry, empty string otherwise
+    const char  *name(index_t idx) const;
+
+    /// entry index of the named child of the entry at idx, -1 if missing
+    index_t      child_index(index_t idx, const std::string &name) const;
+
+    /// entry index of path (relative to the entry at idx), -1 if missing
+    index_t      fetch_index(const std::string &path,
+                             index_t idx = 0) const;
+
+    bool         has_path(const std::string &path) const
+                    { return fetch_index(path) != -1;}
+
+    /// path of the entry at the given index (the first child is used
+    /// for entries shared by a repeated list)
+    std::string  path(index_t idx) const;
+
+//-----------------------------------------------------------------------------
+//
+/// Information Methods
+//
+//-----------------------------------------------------------------------------
+    /// is this flat schema compatible with given flat schema
+    bool         compatible(const FlatSchema &s) const;
+    /// is this flat schema equal to given flat schema
+    bool         equals(const FlatSchema &s) const;
+
+    /// sum of the strided bytes of all leaves
+    index_t      total_strided_bytes() const;
+    /// sum of the bytes of the compact form of all leaves
+    index_t      total_bytes_compact() const;
+    /// max of the spanned bytes of all leaves
+    index_t      spanned_bytes() const;
+    /// returns if this schema represents are compact layout
+    bool         is_compact() const;
+
+//-----------------------------------------------------------------------------
+//
+/// Serialization Methods
+//
+//-----------------------------------------------------------------------------
+    /// number of bytes used by serialize()
+    index_t      serialized_size() const;
+    /// binary image of the flat schema
+    void         serialize(std::vector<uint8> &data) const;
+    void         serialize(void *data) const;
+    /// init from a binary image created with serialize()
+    void         deserialize(const void *data, index_t data_size);
+
+private:
+//-----------------------------------------------------------------------------
+//
+// -- private helpers --
+//
+//-----------------------------------------------------------------------------
+    index_t      freeze(const Schema &schema,
+                        int32 parent,
+                        int32 name,
+                        std::map<std::string,int32> &names);
+    void         thaw(index_t idx,
+                      index_t shift,
+                      Schema &schema) const;
+
+    bool         compatible(index_t idx,
+                            const FlatSchema &s,
+                            index_t s_idx) const;
+    bool         equals(index_t idx,
+                        index_t shift,
+                        const FlatSchema &s,
+                        index_t s_idx,
+                        index_t s_shift) const;
+
+    /// number of times each entry is repeated, and the max offset shift
+    /// applied to it (both only differ from 1 and 0 for repeated lists)
+    void         repeat_info(std::vector<index_t> &counts,
+                             std::vector<index_t> &max_shifts) const;
+
+    /// checks that all entry links and names are in bounds, and that
+    /// the data layout sizes can't overflow (used by deserialize())
+    bool         validate(std::string &msg) const;
+
+    void         to_json_stream(index_t idx,
+                                index_t shift,
+                                std::ostream &os,
+                                index_t indent, 
+                                index_t depth,
+                                const std::string &pad,
+                                const std::string &eoe) const;
+
+//-----------------------------------------------------------------------------
+//
+// -- conduit::FlatSchema private data members --
+//
+//-----------------------------------------------------------------------------
+    /// entries in depth-first order
+    std::vector<Entry>  m_entries;
+    /// entry indices of children, in child order
+    std::vector<int32>  m_children;
+    /// entry indices of children, sorted by name for objects
+    std::vector<int32>  m_sorted_children;
+    /// null terminated names
+    std::vector<char>   m_names;
+
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::FlatSchema --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
+
+#endif
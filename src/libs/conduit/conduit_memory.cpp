@@ -0,0 +1,305 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_memory.cpp
+///
+//-----------------------------------------------------------------------------
+#include "conduit_memory.hpp"
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+// for madvise
+#include <sys/mman.h>
+#else
+// for _aligned_malloc
+#include <malloc.h>
+#endif
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_error.hpp"
+#include "conduit_utils.hpp"
+
+// granularity used for page related logic (first touch and madvise)
+#define CONDUIT_MEMORY_PAGE_BYTES      4096
+// size of a transparent huge page (x86_64 and most aarch64 configs)
+#define CONDUIT_MEMORY_HUGE_PAGE_BYTES 2097152
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::MemoryPolicy --
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+MemoryPolicy::MemoryPolicy()
+: alignment(0),
+  huge_pages(false),
+  init(ZERO)
+{}
+
+//---------------------------------------------------------------------------//
+MemoryPolicy::MemoryPolicy(InitMode init_mode,
+                           index_t  alignment_bytes,
+                           bool     use_huge_pages)
+: alignment(alignment_bytes),
+  huge_pages(use_huge_pages),
+  init(init_mode)
+{}
+
+//---------------------------------------------------------------------------//
+MemoryPolicy::~MemoryPolicy()
+{}
+
+//---------------------------------------------------------------------------//
+// holds the global default policy 
+static MemoryPolicy &
+default_policy_instance()
+{
+    static MemoryPolicy policy;
+    return policy;
+}
+
+//---------------------------------------------------------------------------//
+const MemoryPolicy &
+MemoryPolicy::default_policy()
+{
+    return default_policy_instance();
+}
+
+//---------------------------------------------------------------------------//
+void
+MemoryPolicy::set_default(const MemoryPolicy &policy)
+{
+    default_policy_instance() = policy;
+}
+
+//---------------------------------------------------------------------------//
+void
+MemoryPolicy::reset_default()
+{
+    default_policy_instance() = MemoryPolicy();
+}
+
+//---------------------------------------------------------------------------//
+MemoryPolicy
+MemoryPolicy::default_uninitialized()
+{
+    MemoryPolicy res = default_policy_instance();
+    res.init = NONE;
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+// -- end conduit::MemoryPolicy --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::memory --
+//-----------------------------------------------------------------------------
+namespace memory
+{
+
+//---------------------------------------------------------------------------//
+// hint the OS to use transparent huge pages for the (page aligned) 
+// portion of the buffer
+//---------------------------------------------------------------------------//
+static void
+advise_huge_pages(void *data, size_t nbytes)
+{
+#if defined(MADV_HUGEPAGE)
+    size_t page  = CONDUIT_MEMORY_PAGE_BYTES;
+    size_t start = ((size_t)data + page - 1) & ~(page - 1);
+    size_t end   = ((size_t)data + nbytes) & ~(page - 1);
+    if(end > start)
+    {
+        // this is only a hint, so errors are ignored
+        madvise((void*)start, end - start, MADV_HUGEPAGE);
+    }
+#else
+    // not supported
+    (void)data;
+    (void)nbytes;
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void *
+allocate(index_t nbytes,
+         const MemoryPolicy &policy,
+         bool &needs_deallocate)
+{
+    needs_deallocate = false;
+
+    size_t alloc_bytes = nbytes > 0 ? (size_t)nbytes : 1;
+    size_t alignment   = policy.alignment > 0 ? (size_t)policy.alignment : 0;
+
+    if( (alignment & (alignment - 1)) != 0 )
+    {
+        CONDUIT_ERROR("<memory::allocate> alignment (" << alignment << ")"
+                      " is not a power of two");
+    }
+
+#if defined(MADV_HUGEPAGE)
+    // huge pages can only back huge page aligned regions
+    if(policy.huge_pages &&
+       alloc_bytes >= CONDUIT_MEMORY_HUGE_PAGE_BYTES &&
+       alignment < CONDUIT_MEMORY_HUGE_PAGE_BYTES)
+    {
+        alignment = CONDUIT_MEMORY_HUGE_PAGE_BYTES;
+    }
+#endif
+
+    void *res = NULL;
+
+    if(alignment == 0)
+    {
+        if(policy.init == MemoryPolicy::ZERO && !policy.huge_pages)
+        {
+            // calloc can avoid touching memory it knows is zeroed
+            return calloc(alloc_bytes,(size_t)1);
+        }
+        res = malloc(alloc_bytes);
+    }
+    else
+    {
+        if(alignment < sizeof(void*))
+        {
+            alignment = sizeof(void*);
+        }
+#if defined(CONDUIT_PLATFORM_WINDOWS)
+        res = _aligned_malloc(alloc_bytes,alignment);
+        needs_deallocate = true;
+#else
+        if(posix_memalign(&res,alignment,alloc_bytes) != 0)
+        {
+            res = NULL;
+        }
+#endif
+    }
+
+    if(res == NULL)
+    {
+        CONDUIT_ERROR("<memory::allocate> failed to allocate "
+                      << nbytes << " bytes"
+                      << " (alignment: " << alignment << ")");
+    }
+
+    // must happen before pages are touched 
+    if(policy.huge_pages)
+    {
+        advise_huge_pages(res,alloc_bytes);
+    }
+
+    if(policy.init == MemoryPolicy::ZERO)
+    {
+        memset(res,0,alloc_bytes);
+    }
+    else if(policy.init == MemoryPolicy::PARALLEL_ZERO)
+    {
+        parallel_zero(res,(index_t)alloc_bytes);
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+void
+deallocate(void *data)
+{
+#if defined(CONDUIT_PLATFORM_WINDOWS)
+    _aligned_free(data);
+#else
+    free(data);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void
+parallel_zero(void *data,
+              index_t nbytes)
+{
+    uint8 *ptr = (uint8*)data;
+#if defined(_OPENMP)
+    // zero in page sized blocks, with a static schedule each thread 
+    // touches (and places) a contiguous range of pages
+    index_t block   = CONDUIT_MEMORY_PAGE_BYTES;
+    index_t nblocks = (nbytes + block - 1) / block;
+    #pragma omp parallel for schedule(static)
+    for(index_t i = 0; i < nblocks; i++)
+    {
+        index_t start = i * block;
+        index_t count = (start + block <= nbytes) ? block : nbytes - start;
+        memset(ptr + start,0,(size_t)count);
+    }
+#else
+    memset(ptr,0,(size_t)nbytes);
+#endif
+}
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit::memory --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,164 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_memory.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef CONDUIT_MEMORY_HPP
+#define CONDUIT_MEMORY_HPP
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_core.hpp"
+
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::MemoryPolicy --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::MemoryPolicy
+///
+/// description:
+///  Describes how Nodes allocate and initialize the buffers that hold
+///  their data. A global default policy is used for all allocations, 
+///  it can be changed with MemoryPolicy::set_default(), and overridden
+///  for a single call with the Node::set_schema() and Node::set_dtype()
+///  variants that accept a policy.
+///
+///  alignment:  
+///     byte alignment of the buffer (0 uses the system allocator's
+///     default alignment). Must be a power of two.
+///  huge_pages:
+///     hint the OS to back the buffer with transparent huge pages
+///     (only supported on linux, ignored elsewhere).
+///  init:
+///     ZERO          - zero the buffer
+///     PARALLEL_ZERO - zero the buffer in parallel, using OpenMP threads,
+///                     so pages are first-touched (and placed) across 
+///                     NUMA domains the same way parallel kernels will
+///                     later use them (serial when OpenMP is disabled)
+///     NONE          - leave the buffer uninitialized, for callers that
+///                     will overwrite it
+///
+///  Small leaves that fit in a Node's inline storage use it when the 
+///  policy asks for at most 8 byte alignment and no huge pages.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API MemoryPolicy
+{
+public:
+    typedef enum
+    {
+        ZERO = 0,
+        PARALLEL_ZERO,
+        NONE
+    } InitMode;
+
+    MemoryPolicy();
+    explicit MemoryPolicy(InitMode init_mode,
+                          index_t  alignment_bytes = 0,
+                          bool     use_huge_pages = false);
+    ~MemoryPolicy();
+
+    index_t     alignment;
+    bool        huge_pages;
+    InitMode    init;
+
+    /// the policy used when none is passed
+    static const MemoryPolicy &default_policy();
+    static void                set_default(const MemoryPolicy &policy);
+    /// restore the default policy to calloc like behavior
+    static void                reset_default();
+    /// the default policy, without initialization (used for buffers
+    /// that are immediately overwritten, for example by loaders)
+    static MemoryPolicy        default_uninitialized();
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::MemoryPolicy --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::memory --
+//-----------------------------------------------------------------------------
+namespace memory
+{
+
+//-----------------------------------------------------------------------------
+/// Allocates nbytes according to the passed policy. 
+///
+/// If needs_deallocate is set on return, the buffer must be released with
+/// memory::deallocate(), otherwise it can be released with free().
+//-----------------------------------------------------------------------------
+    void  CONDUIT_API *allocate(index_t nbytes,
+                                const MemoryPolicy &policy,
+                                bool &needs_deallocate);
+
+    /// releases buffers returned by allocate() with needs_deallocate set.
+    void  CONDUIT_API  deallocate(void *data);
+
+    /// zeros a buffer, in parallel when OpenMP is enabled
+    void  CONDUIT_API  parallel_zero(void *data,
+                                     index_t nbytes);
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit::memory --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
+
+#endif
@@ -55,7 +55,10 @@
 // mmap interface not available on windows
 // 
 #include <sys/mman.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#include <limits.h>
+#include <errno.h>
 #else
 #define NOMINMAX
 #undef min
@@ -85,6 +88,7 @@
 // -- conduit includes -- 
 //-----------------------------------------------------------------------------
 #include "conduit_error.hpp"
+#include "conduit_packed_node.hpp"
 #include "conduit_utils.hpp"
 
 // Easier access to the Conduit logging functions
@@ -320,21 +324,53 @@ Node::generate_external(const std::string &json_schema,
 //-----------------------------------------------------------------------------
 
 //---------------------------------------------------------------------------//
-void 
-Node::load(const std::string &stream_path,
-           const Schema &schema)
+// helper that opens a file for binary reads
+//---------------------------------------------------------------------------//
+static void
+node_open_file(std::ifstream &ifs,
+               const std::string &stream_path)
+{
+    ifs.open(stream_path.c_str(), std::ios_base::binary);
+    if(!ifs.is_open())
+        CONDUIT_ERROR("<Node::load> failed to open: " << stream_path);
+}
+
+//---------------------------------------------------------------------------//
+// helper that reads dsize bytes of an open file into data, zeroing 
+// anything a short file doesn't provide
+//---------------------------------------------------------------------------//
+static void
+node_read_stream(std::ifstream &ifs,
+                 void *data,
+                 index_t dsize)
 {
+    ifs.read((char *)data,dsize);
+    index_t nread = (index_t)ifs.gcount();
+    if(nread < dsize)
+    {
+        memset((char *)data + nread,0,(size_t)(dsize - nread));
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::load_stream(std::ifstream &ifs,
+                  const Schema &schema,
+                  bool reuse)
+{
+    if(reuse && has_reusable_layout(schema))
+    {
+        node_read_stream(ifs,m_data,schema.spanned_bytes());
+        return;
+    }
+
     // clear out any existing structure
     reset();
     index_t dsize = schema.spanned_bytes();
 
-    allocate(dsize);
-    std::ifstream ifs;
-    ifs.open(stream_path.c_str(), std::ios_base::binary);
-    if(!ifs.is_open())
-        CONDUIT_ERROR("<Node::load> failed to open: " << stream_path);
-    ifs.read((char *)m_data,dsize);
-    ifs.close();
+    // no need to init, we read over all of it
+    allocate(dsize,MemoryPolicy::default_uninitialized());
+    node_read_stream(ifs,m_data,dsize);
 
     //
     // See Below
@@ -354,19 +390,40 @@ Node::load(const std::string &stream_path,
     m_alloced = true;
 }
 
+//---------------------------------------------------------------------------//
+void 
+Node::load(const std::string &stream_path,
+           const Schema &schema)
+{
+    std::ifstream ifs;
+    node_open_file(ifs,stream_path);
+    load_stream(ifs,schema,false);
+}
+
 //---------------------------------------------------------------------------//
 void
 Node::load(const std::string &ibase,
            const std::string &protocol)
 {
-    if(protocol == "conduit_bin")
+    if(protocol == "conduit_packed")
     {
-        // TODO: use generator?
-        Schema s;
-        std::string ifschema = ibase + "_json";
+        PackedNode::load(ibase,*this);
+    }
+    else if(protocol == "conduit_bin")
+    {
+        // packed files are self describing, so "conduit_bin" also reads
+        // them, detected using the same open we read the data with
+        std::ifstream ifs;
+        node_open_file(ifs,ibase);
+        if(!PackedNode::load_if_packed(ifs,ibase,*this,false))
+        {
+            // TODO: use generator?
+            Schema s;
+            std::string ifschema = ibase + "_json";
 
-        s.load(ifschema);
-        load(ibase,s);
+            s.load(ifschema);
+            load_stream(ifs,s,false);
+        }
     }
     // single file json cases
     else
@@ -384,19 +441,66 @@ Node::load(const std::string &ibase,
         
 }
 
+//---------------------------------------------------------------------------//
+void
+Node::load_into(const std::string &stream_path,
+                const Schema &schema)
+{
+    std::ifstream ifs;
+    node_open_file(ifs,stream_path);
+    load_stream(ifs,schema,true);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::load_into(const std::string &ibase,
+                const std::string &protocol)
+{
+    if(protocol == "conduit_packed")
+    {
+        PackedNode::load_into(ibase,*this);
+    }
+    else if(protocol == "conduit_bin")
+    {
+        std::ifstream ifs;
+        node_open_file(ifs,ibase);
+        if(!PackedNode::load_if_packed(ifs,ibase,*this,true))
+        {
+            Schema s;
+            std::string ifschema = ibase + "_json";
+
+            s.load(ifschema);
+            load_stream(ifs,s,true);
+        }
+    }
+    // json cases are parsed into a temp node
+    else
+    {
+        Node n;
+        n.load(ibase,protocol);
+        set_compatible(n);
+    }
+}
+
 //---------------------------------------------------------------------------//
 void
 Node::save(const std::string &obase,
            const std::string &protocol) const
 {
-    if(protocol == "conduit_bin")
+    if(protocol == "conduit_packed")
+    {
+        PackedNode::save(*this,obase);
+    }
+    else if(protocol == "conduit_bin")
     {
-        Node res;
-        compact_to(res);
+        // only the schema is compacted, the data is written from
+        // this node's memory
+        Schema s_compact;
+        schema().compact_to(s_compact);
         std::string ofschema = obase + "_json";
 
-        res.schema().save(ofschema);
-        res.serialize(obase);
+        s_compact.save(ofschema);
+        serialize(obase);
     }
     // single file json cases
     else
@@ -409,12 +513,30 @@ Node::save(const std::string &obase,
 void
 Node::mmap(const std::string &stream_path)
 {
-    std::string ifschema = stream_path + "_json";
+    mmap(stream_path,std::string("conduit_bin"));
+}
 
+//---------------------------------------------------------------------------//
+void
+Node::mmap(const std::string &stream_path,
+           const std::string &protocol)
+{
+    if(protocol == "conduit_packed")
+    {
+        PackedNode::mmap(stream_path,*this);
+    }
+    else if(protocol == "conduit_bin")
+    {
+        std::string ifschema = stream_path + "_json";
 
-    Schema s;
-    s.load(ifschema);
-    mmap(stream_path,s);
+        Schema s;
+        s.load(ifschema);
+        mmap(stream_path,s);
+    }
+    else
+    {
+        CONDUIT_ERROR("<Node::mmap> unsupported protocol: " << protocol);
+    }
 }
 
 
@@ -518,6 +640,91 @@ Node::set(const Node &node)
     set_node(node);
 }
 
+//---------------------------------------------------------------------------//
+void
+Node::set_compatible(const Node &node)
+{
+    index_t dtype_id = node.dtype().id();
+    if(dtype_id == DataType::OBJECT_ID)
+    {
+        if(!dtype().is_object() || child_names() != node.child_names())
+        {
+            set_node(node);
+            return;
+        }
+
+        for(size_t i=0; i < m_children.size(); i++)
+        {
+            m_children[i]->set_compatible(*node.m_children[i]);
+        }
+    }
+    else if(dtype_id == DataType::LIST_ID)
+    {
+        if(!dtype().is_list() ||
+           m_children.size() != node.m_children.size())
+        {
+            set_node(node);
+            return;
+        }
+
+        for(size_t i=0; i < m_children.size(); i++)
+        {
+            m_children[i]->set_compatible(*node.m_children[i]);
+        }
+    }
+    else if(dtype_id == DataType::EMPTY_ID)
+    {
+        reset();
+    }
+    else
+    {
+        const DataType &dt     = dtype();
+        const DataType &src_dt = node.dtype();
+        index_t num_ele = src_dt.number_of_elements();
+
+        if(dt.id()            == src_dt.id()            &&
+           dt.number_of_elements() == num_ele          &&
+           dt.element_bytes() == src_dt.element_bytes() &&
+           dt.endianness()    == src_dt.endianness())
+        {
+            // same values, copy into our current layout
+            if(dt.is_compact() && src_dt.is_compact())
+            {
+                memcpy(element_ptr(0),
+                       node.element_ptr(0),
+                       (size_t)dt.bytes_compact());
+            }
+            else
+            {
+                for(index_t idx = 0; idx < num_ele; idx++)
+                {
+                    memcpy(element_ptr(idx),
+                           node.element_ptr(idx),
+                           (size_t)dt.element_bytes());
+                }
+            }
+        }
+        else if(m_alloced &&
+                !dt.is_object() &&
+                !dt.is_list()   &&
+                m_data_size >= node.total_bytes_compact())
+        {
+            // retain capacity: switch to the compact form of the
+            // source dtype in the buffer we already own
+            // (only for leaves, an object or list that owns its buffer
+            //  still has child nodes that would outlive their schemas)
+            DataType dt_compact;
+            src_dt.compact_to(dt_compact);
+            m_schema->set(dt_compact);
+            node.compact_elements_to((uint8*)m_data);
+        }
+        else
+        {
+            set_node(node);
+        }
+    }
+}
+
 //---------------------------------------------------------------------------//
 void 
 Node::set_dtype(const DataType &dtype)
@@ -532,26 +739,71 @@ Node::set(const DataType &dtype)
     set_dtype(dtype);
 }
 
+//---------------------------------------------------------------------------//
+void
+Node::set_dtype(const DataType &dtype,
+                const MemoryPolicy &policy)
+{
+    init(dtype,policy);
+}
+
+//---------------------------------------------------------------------------//
+void 
+Node::set(const DataType &dtype,
+          const MemoryPolicy &policy)
+{
+    set_dtype(dtype,policy);
+}
+
 //---------------------------------------------------------------------------//
 void
 Node::set_schema(const Schema &schema)
+{
+    set_schema(schema,MemoryPolicy::default_policy());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set(const Schema &schema)
+{
+    set_schema(schema);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_schema(const Schema &schema,
+                 const MemoryPolicy &policy)
 {
     release();
     m_schema->set(schema);
     // allocate data 
     // for this case, we need the total bytes spanned by the schema
-    size_t nbytes =(size_t) m_schema->spanned_bytes();
-    allocate(nbytes);
-    memset(m_data,0,nbytes);
+    // (the policy controls how the data is initialized)
+    allocate(m_schema->spanned_bytes(),policy);
     // call walk w/ internal data pointer
     walk_schema(this,m_schema,m_data);
 }
 
 //---------------------------------------------------------------------------//
 void
-Node::set(const Schema &schema)
+Node::set(const Schema &schema,
+          const MemoryPolicy &policy)
 {
-    set_schema(schema);
+    set_schema(schema,policy);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_uninitialized(const DataType &dtype)
+{
+    set_dtype(dtype,MemoryPolicy::default_uninitialized());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_uninitialized(const Schema &schema)
+{
+    set_schema(schema,MemoryPolicy::default_uninitialized());
 }
 
 
@@ -564,7 +816,7 @@ Node::set_data_using_schema(const Schema &schema,
     m_schema->set(schema);   
     // for this case, we need the total bytes spanned by the schema
     size_t nbytes = (size_t)m_schema->spanned_bytes();
-    allocate(nbytes);
+    allocate(nbytes,MemoryPolicy::default_uninitialized());
     memcpy(m_data, data, nbytes);
     walk_schema(this,m_schema,m_data);
 }
@@ -584,7 +836,7 @@ Node::set_data_using_dtype(const DataType &dtype,
 {
     release();
     m_schema->set(dtype);
-    allocate(m_schema->spanned_bytes());
+    allocate(m_schema->spanned_bytes(),MemoryPolicy::default_uninitialized());
     memcpy(m_data, data, (size_t) m_schema->spanned_bytes());
     walk_schema(this,m_schema,m_data);
 }
@@ -1982,34 +2234,432 @@ Node::set(const float *data,
                                            element_bytes,
                                            endianness)));
 }
-//-----------------------------------------------------------------------------
-#endif // end use float check
-//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+#endif // end use float check
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+#ifndef CONDUIT_USE_DOUBLE
+//-----------------------------------------------------------------------------
+void
+Node::set(const double *data,
+          index_t num_elements,
+          index_t offset,
+          index_t stride,
+          index_t element_bytes,
+          index_t endianness)
+{
+    set(double_array(data,DataType::c_double(num_elements,
+                                             offset,
+                                             stride,
+                                             element_bytes,
+                                             endianness)));
+}
+//-----------------------------------------------------------------------------
+#endif // end use double check
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+//
+// -- end definition of Node set methods --
+//
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+//
+// -- begin definition of Node leaf growth methods --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::reserve(index_t num_elements)
+{
+    const DataType &dt = dtype();
+    if(dt.is_empty() || dt.is_object() || dt.is_list())
+    {
+        CONDUIT_ERROR("Node::reserve: cannot reserve elements for a "
+                      "non-leaf node (dtype: " << dt.name() << ")");
+    }
+
+    reserve_leaf(num_elements,false);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::resize(index_t num_elements)
+{
+    const DataType &dt = dtype();
+    if(dt.is_empty() || dt.is_object() || dt.is_list())
+    {
+        CONDUIT_ERROR("Node::resize: cannot resize a "
+                      "non-leaf node (dtype: " << dt.name() << ")");
+    }
+
+    if(num_elements < 0)
+    {
+        CONDUIT_ERROR("Node::resize: invalid number of elements: "
+                      << num_elements);
+    }
+
+    index_t num_ele = dt.number_of_elements();
+
+    if(num_elements > num_ele)
+    {
+        reserve_leaf(num_elements,true);
+        // zero the new elements, the buffer may hold stale values 
+        // if the leaf was shrunk before
+        index_t ele_bytes = dt.element_bytes();
+        memset((uint8*)m_data + num_ele * ele_bytes,
+               0,
+               (size_t)((num_elements - num_ele) * ele_bytes));
+    }
+
+    m_schema->dtype().set_number_of_elements(num_elements);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+Node::capacity() const
+{
+    const DataType &dt = dtype();
+    if(dt.is_empty() || dt.is_object() || dt.is_list())
+    {
+        return 0;
+    }
+
+    index_t ele_bytes = dt.element_bytes();
+    if(m_alloced &&
+       ele_bytes > 0 &&
+       dt.offset() == 0 &&
+       dt.stride() == ele_bytes)
+    {
+        return m_data_size / ele_bytes;
+    }
+
+    return dt.number_of_elements();
+}
+
+//-----------------------------------------------------------------------------
+// signed integer types
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(int8 value)
+{
+    append_leaf_values(DataType::int8(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(int16 value)
+{
+    append_leaf_values(DataType::int16(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(int32 value)
+{
+    append_leaf_values(DataType::int32(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(int64 value)
+{
+    append_leaf_values(DataType::int64(1),&value);
+}
+
+//-----------------------------------------------------------------------------
+// unsigned integer types
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(uint8 value)
+{
+    append_leaf_values(DataType::uint8(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(uint16 value)
+{
+    append_leaf_values(DataType::uint16(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(uint32 value)
+{
+    append_leaf_values(DataType::uint32(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(uint64 value)
+{
+    append_leaf_values(DataType::uint64(1),&value);
+}
+
+//-----------------------------------------------------------------------------
+// floating point types
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(float32 value)
+{
+    append_leaf_values(DataType::float32(1),&value);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::push_back(float64 value)
+{
+    append_leaf_values(DataType::float64(1),&value);
+}
+
+//-----------------------------------------------------------------------------
+// signed integer types via conduit::DataArray
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const int8_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const int16_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const int32_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const int64_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//-----------------------------------------------------------------------------
+// unsigned integer types via conduit::DataArray
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const uint8_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const uint16_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const uint32_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const uint64_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//-----------------------------------------------------------------------------
+// floating point types via conduit::DataArray
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const float32_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const float64_array &data)
+{
+    append_leaf_values(data.dtype(),data.data_ptr());
+}
+
+//-----------------------------------------------------------------------------
+// signed integer types via std::vector
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<int8> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::int8(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::int8(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<int16> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::int16(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::int16(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<int32> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::int32(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::int32(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<int64> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::int64(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::int64(data.size()),&data[0]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// unsigned integer types via std::vector
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<uint8> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::uint8(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::uint8(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<uint16> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::uint16(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::uint16(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<uint32> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::uint32(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::uint32(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<uint64> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::uint64(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::uint64(data.size()),&data[0]);
+    }
+}
 
 //-----------------------------------------------------------------------------
-#ifndef CONDUIT_USE_DOUBLE
+// floating point types via std::vector
 //-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
 void
-Node::set(const double *data,
-          index_t num_elements,
-          index_t offset,
-          index_t stride,
-          index_t element_bytes,
-          index_t endianness)
+Node::append_values(const std::vector<float32> &data)
 {
-    set(double_array(data,DataType::c_double(num_elements,
-                                             offset,
-                                             stride,
-                                             element_bytes,
-                                             endianness)));
+    if(data.empty())
+    {
+        append_leaf_values(DataType::float32(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::float32(data.size()),&data[0]);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_values(const std::vector<float64> &data)
+{
+    if(data.empty())
+    {
+        append_leaf_values(DataType::float64(0),NULL);
+    }
+    else
+    {
+        append_leaf_values(DataType::float64(data.size()),&data[0]);
+    }
 }
-//-----------------------------------------------------------------------------
-#endif // end use double check
-//-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 //
-// -- end definition of Node set methods --
+// -- end definition of Node leaf growth methods --
 //
 //-----------------------------------------------------------------------------
 
@@ -4934,6 +5584,286 @@ Node::set_external(const std::vector<double> &data)
 //-----------------------------------------------------------------------------
 
 
+//-----------------------------------------------------------------------------
+//
+// -- begin definition of Node set_owned methods --
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// deleters used for adopted data
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+static void
+free_owned_data(void *data)
+{
+    free(data);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+static void
+delete_owned_vector(void *vec)
+{
+    delete static_cast<std::vector<T>*>(vec);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_data_using_schema(const Schema &schema,
+                                  void *data,
+                                  DataDeleter deleter)
+{
+    set_owned_data(schema,data,deleter,data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(const Schema &schema,
+                void *data,
+                DataDeleter deleter)
+{
+    set_owned_data_using_schema(schema,data,deleter);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_data_using_dtype(const DataType &dtype,
+                                 void *data,
+                                 DataDeleter deleter)
+{
+    set_owned_data(Schema(dtype),data,deleter,data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(const DataType &dtype,
+                void *data,
+                DataDeleter deleter)
+{
+    set_owned_data_using_dtype(dtype,data,deleter);
+}
+
+//-----------------------------------------------------------------------------
+// signed integer std::vector cases
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_int8_vector(std::vector<int8> &data)
+{
+    std::vector<int8> *owned = new std::vector<int8>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::int8(owned->size())),
+                   owned_data,
+                   delete_owned_vector<int8>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<int8> &data)
+{
+    set_owned_int8_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_int16_vector(std::vector<int16> &data)
+{
+    std::vector<int16> *owned = new std::vector<int16>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::int16(owned->size())),
+                   owned_data,
+                   delete_owned_vector<int16>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<int16> &data)
+{
+    set_owned_int16_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_int32_vector(std::vector<int32> &data)
+{
+    std::vector<int32> *owned = new std::vector<int32>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::int32(owned->size())),
+                   owned_data,
+                   delete_owned_vector<int32>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<int32> &data)
+{
+    set_owned_int32_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_int64_vector(std::vector<int64> &data)
+{
+    std::vector<int64> *owned = new std::vector<int64>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::int64(owned->size())),
+                   owned_data,
+                   delete_owned_vector<int64>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<int64> &data)
+{
+    set_owned_int64_vector(data);
+}
+
+//-----------------------------------------------------------------------------
+// unsigned integer std::vector cases
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_uint8_vector(std::vector<uint8> &data)
+{
+    std::vector<uint8> *owned = new std::vector<uint8>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::uint8(owned->size())),
+                   owned_data,
+                   delete_owned_vector<uint8>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<uint8> &data)
+{
+    set_owned_uint8_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_uint16_vector(std::vector<uint16> &data)
+{
+    std::vector<uint16> *owned = new std::vector<uint16>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::uint16(owned->size())),
+                   owned_data,
+                   delete_owned_vector<uint16>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<uint16> &data)
+{
+    set_owned_uint16_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_uint32_vector(std::vector<uint32> &data)
+{
+    std::vector<uint32> *owned = new std::vector<uint32>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::uint32(owned->size())),
+                   owned_data,
+                   delete_owned_vector<uint32>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<uint32> &data)
+{
+    set_owned_uint32_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_uint64_vector(std::vector<uint64> &data)
+{
+    std::vector<uint64> *owned = new std::vector<uint64>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::uint64(owned->size())),
+                   owned_data,
+                   delete_owned_vector<uint64>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<uint64> &data)
+{
+    set_owned_uint64_vector(data);
+}
+
+//-----------------------------------------------------------------------------
+// floating point std::vector cases
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_float32_vector(std::vector<float32> &data)
+{
+    std::vector<float32> *owned = new std::vector<float32>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::float32(owned->size())),
+                   owned_data,
+                   delete_owned_vector<float32>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<float32> &data)
+{
+    set_owned_float32_vector(data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_float64_vector(std::vector<float64> &data)
+{
+    std::vector<float64> *owned = new std::vector<float64>();
+    owned->swap(data);
+    void *owned_data = owned->empty() ? NULL : (void*)&(*owned)[0];
+    set_owned_data(Schema(DataType::float64(owned->size())),
+                   owned_data,
+                   delete_owned_vector<float64>,
+                   owned);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_owned(std::vector<float64> &data)
+{
+    set_owned_float64_vector(data);
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- end definition of Node set_owned methods --
+//
+//-----------------------------------------------------------------------------
+
+
 //-----------------------------------------------------------------------------
 //
 // -- begin definition of Node set_path_external methods --
@@ -6924,20 +7854,44 @@ Node::operator=(const std::vector<double> &data)
 void
 Node::serialize(std::vector<uint8> &data) const
 {
-    data = std::vector<uint8>((size_t)total_bytes_compact(),0);
-    serialize(&data[0],0);
+    // resize keeps any existing capacity, so reusing the same vector
+    // for same sized trees does not reallocate
+    size_t nbytes = (size_t)serialized_size();
+    data.resize(nbytes);
+    if(nbytes > 0)
+    {
+        serialize(&data[0],0);
+    }
 }
 
 //---------------------------------------------------------------------------//
 void
 Node::serialize(const std::string &stream_path) const
 {
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+    int fd = ::open(stream_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0)
+        CONDUIT_ERROR("<Node::serialize> failed to open: " << stream_path);
+    try
+    {
+        write_compact_data(fd,stream_path);
+    }
+    catch(...)
+    {
+        // don't leak the fd when the write fails
+        ::close(fd);
+        throw;
+    }
+    if(::close(fd) != 0)
+        CONDUIT_ERROR("<Node::serialize> failed to close: " << stream_path);
+#else
     std::ofstream ofs;
     ofs.open(stream_path.c_str(), std::ios_base::binary);
     if(!ofs.is_open())
         CONDUIT_ERROR("<Node::serialize> failed to open: " << stream_path);
     serialize(ofs);
     ofs.close();
+#endif
 }
 
 
@@ -6977,6 +7931,119 @@ Node::serialize(std::ofstream &ofs) const
     }
 }
 
+//---------------------------------------------------------------------------//
+index_t
+Node::serialized_size() const
+{
+    return m_schema->total_bytes_compact();
+}
+
+//---------------------------------------------------------------------------//
+index_t
+Node::serialize_to(void *dst,
+                   index_t capacity) const
+{
+    index_t nbytes = serialized_size();
+    if(nbytes > capacity)
+    {
+        CONDUIT_ERROR("<Node::serialize_to> buffer capacity (" << capacity
+                      << " bytes) is smaller than the serialized size ("
+                      << nbytes << " bytes)");
+    }
+
+    if(nbytes > 0)
+    {
+        serialize(static_cast<uint8*>(dst),0);
+    }
+    return nbytes;
+}
+
+//---------------------------------------------------------------------------//
+// helper used to check if a node's data can be overwritten in place with
+// data described by the given schema: same layout (names, order and all
+// dtype params) and every node in the tree points to the same base buffer.
+// unlike Schema::equals, this does not allocate.
+//---------------------------------------------------------------------------//
+static bool
+serialized_layout_matches(const Node &n,
+                          const Schema &s,
+                          const void *base)
+{
+    const DataType &n_dt = n.dtype();
+    const DataType &s_dt = s.dtype();
+
+    if(n_dt.id() != s_dt.id())
+    {
+        return false;
+    }
+
+    if(n_dt.is_object() || n_dt.is_list())
+    {
+        index_t num_children = n.number_of_children();
+        if(num_children != s.number_of_children())
+        {
+            return false;
+        }
+
+        if(n_dt.is_object() &&
+           n.schema().child_names() != s.child_names())
+        {
+            return false;
+        }
+
+        for(index_t i = 0; i < num_children; i++)
+        {
+            if(!serialized_layout_matches(n.child(i),s.child(i),base))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return n.data_ptr() == base && n_dt.equals(s_dt);
+}
+
+//---------------------------------------------------------------------------//
+bool
+Node::has_reusable_layout(const Schema &schema) const
+{
+    return m_alloced &&
+           m_data != NULL &&
+           m_data_size >= schema.spanned_bytes() &&
+           serialized_layout_matches(*this,schema,m_data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::deserialize_from(const Schema &schema,
+                       const void *src,
+                       index_t nbytes)
+{
+    index_t span = schema.spanned_bytes();
+    if(span > nbytes)
+    {
+        CONDUIT_ERROR("<Node::deserialize_from> schema spans " << span
+                      << " bytes, but only " << nbytes 
+                      << " bytes were provided");
+    }
+
+    if(has_reusable_layout(schema))
+    {
+        memcpy(m_data,src,(size_t)span);
+        return;
+    }
+
+    release();
+    m_schema->set(schema);
+    allocate(span,MemoryPolicy::default_uninitialized());
+    if(span > 0)
+    {
+        memcpy(m_data,src,(size_t)span);
+    }
+    walk_schema(this,m_schema,m_data);
+}
+
 //-----------------------------------------------------------------------------
 // -- compaction methods ---
 //-----------------------------------------------------------------------------
@@ -6988,7 +8055,8 @@ Node::compact_to(Node &n_dest) const
     n_dest.reset();
     index_t c_size = total_bytes_compact();
     m_schema->compact_to(*n_dest.schema_ptr());
-    n_dest.allocate(c_size);
+    // compaction writes every byte
+    n_dest.allocate(c_size,MemoryPolicy::default_uninitialized());
     
     uint8 *n_dest_data = (uint8*)n_dest.m_data;
     compact_to(n_dest_data,0);
@@ -13007,10 +14075,23 @@ Node::MMap::close()
 void
 Node::init(const DataType& dtype)
 {
+    // callers overwrite the data, so a compatible buffer is reused as is
     if(this->dtype().compatible(dtype))
         return;
+
+    init(dtype,MemoryPolicy::default_policy());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::init(const DataType& dtype,
+           const MemoryPolicy &policy)
+{
+    if(this->dtype().compatible(dtype) && reuse_leaf(policy))
+        return;
     
-    if(m_data != NULL)
+    // (adopted data may be empty, but still needs its deleter called)
+    if(m_data != NULL || m_deleter != NULL)
     {
         release();
     }
@@ -13023,13 +14104,62 @@ Node::init(const DataType& dtype)
     }
     else if(dt_id != DataType::EMPTY_ID)
     {
-        allocate(dtype);
+        allocate(dtype.spanned_bytes(),policy);
     }
     
     m_schema->set(dtype); 
 }
 
 
+//---------------------------------------------------------------------------//
+bool
+Node::reuse_leaf(const MemoryPolicy &policy)
+{
+    const DataType &dt = dtype();
+    if(dt.is_empty() || dt.is_object() || dt.is_list())
+        return true;
+
+    if(m_data == NULL)
+        return false;
+
+    uint8 *ele_ptr = (uint8*)element_ptr(0);
+
+    // a misaligned buffer can't be reused, fall back to a fresh allocation
+    if(policy.alignment > 0 &&
+       ((size_t)ele_ptr % (size_t)policy.alignment) != 0)
+        return false;
+
+    // external memory and buffers owned by a parent are reused as is,
+    // like set(DataType) does, we only initialize what we allocated
+    if(policy.init == MemoryPolicy::NONE || !m_alloced)
+        return true;
+
+    index_t num_ele   = dt.number_of_elements();
+    index_t ele_bytes = dt.element_bytes();
+
+    if(dt.is_compact())
+    {
+        if(policy.init == MemoryPolicy::PARALLEL_ZERO)
+        {
+            memory::parallel_zero(ele_ptr,num_ele * ele_bytes);
+        }
+        else
+        {
+            memset(ele_ptr,0,(size_t)(num_ele * ele_bytes));
+        }
+    }
+    else
+    {
+        // only zero our elements, the gaps may belong to other nodes
+        for(index_t i = 0; i < num_ele; i++)
+        {
+            memset(element_ptr(i),0,(size_t)ele_bytes);
+        }
+    }
+
+    return true;
+}
+
 //---------------------------------------------------------------------------//
 void
 Node::allocate(const DataType &dtype)
@@ -13041,13 +14171,298 @@ Node::allocate(const DataType &dtype)
 void
 Node::allocate(index_t dsize)
 {
-    m_data      = calloc((size_t)dsize,(size_t)1);
+    allocate(dsize,MemoryPolicy::default_policy());
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::allocate(index_t dsize,
+               const MemoryPolicy &policy)
+{
+    // small buffers use the node's inline storage, avoiding a heap
+    // allocation for the common case of scalar leaves. the inline
+    // storage is only float64 aligned, so policies that ask for more
+    // (or for huge pages) go to the heap
+    if(dsize <= (index_t)sizeof(m_inline_data) &&
+       policy.alignment <= (index_t)sizeof(m_inline_align) &&
+       !policy.huge_pages)
+    {
+        if(policy.init != MemoryPolicy::NONE)
+        {
+            memset(m_inline_data,0,sizeof(m_inline_data));
+        }
+        m_data = m_inline_data;
+    }
+    else
+    {
+        bool needs_deallocate = false;
+        m_data = memory::allocate(dsize,policy,needs_deallocate);
+        if(needs_deallocate)
+        {
+            m_deleter         = memory::deallocate;
+            m_deleter_context = m_data;
+        }
+    }
     m_data_size = dsize;
     m_alloced   = true;
     m_mmaped    = false;
 }
 
 
+//---------------------------------------------------------------------------//
+void
+Node::set_owned_data(const Schema &schema,
+                     void *data,
+                     DataDeleter deleter,
+                     void *context)
+{
+    release();
+    m_schema->set(schema);
+
+    m_data_size = m_schema->spanned_bytes();
+    m_alloced   = true;
+    m_mmaped    = false;
+
+    m_deleter         = deleter != NULL ? deleter : free_owned_data;
+    m_deleter_context = context;
+
+    walk_schema(this,m_schema,data);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::reserve_leaf(index_t num_elements,
+                   bool geometric)
+{
+    DataType &dt = m_schema->dtype();
+
+    index_t ele_bytes = dt.element_bytes();
+    index_t num_ele   = dt.number_of_elements();
+    index_t curr_cap  = capacity();
+
+    bool owns_compact = m_alloced &&
+                        dt.offset() == 0 &&
+                        dt.stride() == ele_bytes;
+
+    if(owns_compact && num_elements <= curr_cap)
+        return;
+
+    index_t new_cap = num_elements;
+    if(geometric && 2 * curr_cap > new_cap)
+        new_cap = 2 * curr_cap;
+    if(new_cap < num_ele)
+        new_cap = num_ele;
+
+    index_t nbytes = new_cap * ele_bytes;
+
+    // stage small buffers on the stack, since the current data
+    // may already live in our inline storage
+    uint8  inline_tmp[sizeof(m_inline_data)];
+    bool   use_inline = nbytes <= (index_t)sizeof(m_inline_data);
+    uint8 *new_data   = inline_tmp;
+    bool   needs_deallocate = false;
+
+    if(use_inline)
+    {
+        memset(inline_tmp,0,sizeof(inline_tmp));
+    }
+    else
+    {
+        new_data = (uint8*)memory::allocate(nbytes,
+                                            MemoryPolicy::default_policy(),
+                                            needs_deallocate);
+    }
+
+    // compact the existing elements into the new buffer
+    for(index_t i = 0; i < num_ele; i++)
+    {
+        memcpy(new_data + i * ele_bytes,
+               element_ptr(i),
+               (size_t)ele_bytes);
+    }
+
+    release();
+
+    if(use_inline)
+    {
+        memcpy(m_inline_data,inline_tmp,sizeof(m_inline_data));
+        m_data = m_inline_data;
+    }
+    else
+    {
+        m_data = new_data;
+        if(needs_deallocate)
+        {
+            m_deleter         = memory::deallocate;
+            m_deleter_context = m_data;
+        }
+    }
+
+    m_data_size = nbytes;
+    m_alloced   = true;
+    m_mmaped    = false;
+
+    dt.set_offset(0);
+    dt.set_stride(ele_bytes);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::append_leaf_values(const DataType &src_dtype,
+                         const void *src_data)
+{
+    if(dtype().is_empty())
+    {
+        init(DataType(src_dtype.id(),0));
+    }
+
+    const DataType &dt = dtype();
+
+    if(dt.id() != src_dtype.id() ||
+       dt.element_bytes() != src_dtype.element_bytes())
+    {
+        CONDUIT_ERROR("Node::append_values: cannot append " 
+                      << src_dtype.name() << " values to a leaf of type "
+                      << dt.name());
+    }
+
+    if(dt.endianness_matches_machine() != 
+       src_dtype.endianness_matches_machine())
+    {
+        CONDUIT_ERROR("Node::append_values: endianness of appended values "
+                      "does not match the leaf's endianness");
+    }
+
+    index_t ele_bytes = dt.element_bytes();
+    index_t num_ele   = dt.number_of_elements();
+    index_t src_num   = src_dtype.number_of_elements();
+
+    if(src_num <= 0)
+        return;
+
+    // the source may point into our own buffer, which can be 
+    // reallocated below, if so work from a compact copy
+    const uint8 *src_ptr = (const uint8*)src_data;
+    DataType src_dt(src_dtype);
+    std::vector<uint8> src_copy;
+
+    if(m_data != NULL &&
+       src_ptr >= (const uint8*)m_data &&
+       src_ptr <  (const uint8*)m_data + m_data_size)
+    {
+        src_copy.resize((size_t)(src_num * ele_bytes));
+        for(index_t i = 0; i < src_num; i++)
+        {
+            memcpy(&src_copy[(size_t)(i * ele_bytes)],
+                   src_ptr + src_dt.element_index(i),
+                   (size_t)ele_bytes);
+        }
+        src_ptr = &src_copy[0];
+        src_dt.set_offset(0);
+        src_dt.set_stride(ele_bytes);
+    }
+
+    reserve_leaf(num_ele + src_num,true);
+
+    uint8 *dest_ptr = (uint8*)m_data + num_ele * ele_bytes;
+
+    if(src_dt.is_compact())
+    {
+        memcpy(dest_ptr,
+               src_ptr + src_dt.offset(),
+               (size_t)(src_num * ele_bytes));
+    }
+    else
+    {
+        for(index_t i = 0; i < src_num; i++)
+        {
+            memcpy(dest_ptr + i * ele_bytes,
+                   src_ptr + src_dt.element_index(i),
+                   (size_t)ele_bytes);
+        }
+    }
+
+    m_schema->dtype().set_number_of_elements(num_ele + src_num);
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::set_struct_data(const Schema &schema,
+                      const void *data,
+                      index_t nbytes)
+{
+    release();
+    m_schema->set(schema);
+    // nbytes covers whole structs (including any trailing padding that 
+    // the schema does not span), so the data can be accessed as structs
+    allocate(nbytes,MemoryPolicy::default_uninitialized());
+    memcpy(m_data, data, (size_t) nbytes);
+    walk_schema(this,m_schema,m_data);
+}
+
+//---------------------------------------------------------------------------//
+bool
+Node::check_dtype_id(index_t dtype_id,
+                     const std::string &method) const
+{
+    CONDUIT_CHECK_DTYPE(this,
+                        dtype_id,
+                        method,
+                        false);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// checks that the fields described by expected exist in actual with the
+// same layout (number of elements is not checked)
+//---------------------------------------------------------------------------//
+static bool
+struct_layout_matches(const Schema &expected,
+                      const Schema &actual)
+{
+    const DataType &e_dt = expected.dtype();
+    const DataType &a_dt = actual.dtype();
+
+    if(e_dt.is_object())
+    {
+        if(!a_dt.is_object())
+        {
+            return false;
+        }
+
+        const std::vector<std::string> &names = expected.child_names();
+        for(size_t i=0; i < names.size(); i++)
+        {
+            if(!actual.has_child(names[i]) ||
+               !struct_layout_matches(expected.child((index_t)i),
+                                      actual.fetch_child(names[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return e_dt.id()            == a_dt.id()            &&
+           e_dt.offset()        == a_dt.offset()        &&
+           e_dt.stride()        == a_dt.stride()        &&
+           e_dt.element_bytes() == a_dt.element_bytes() &&
+           e_dt.endianness()    == a_dt.endianness();
+}
+
+//---------------------------------------------------------------------------//
+bool
+Node::check_struct_schema(const Schema &schema,
+                          const std::string &method) const
+{
+    bool res = struct_layout_matches(schema,*m_schema);
+    CONDUIT_CHECK( res ,
+                   "Node::" << method << " -- Schema at path " << path()
+                   << " does not match the struct layout "
+                   << schema.to_json());
+    return res;
+}
+
 //---------------------------------------------------------------------------//
 void
 Node::mmap(const std::string &stream_path, index_t data_size)
@@ -13074,7 +14489,20 @@ Node::release()
     m_children.clear();
 
     // clean up any allocated or mmaped buffers
-    if(m_alloced && m_data)
+    if(m_deleter != NULL)
+    {
+        // adopted data, the deleter may also clean up other state
+        // so it is called even if m_data is NULL
+        DataDeleter deleter = m_deleter;
+        void *context       = m_deleter_context;
+        m_deleter           = NULL;
+        m_deleter_context   = NULL;
+        m_data      = NULL;
+        m_data_size = 0;
+        m_alloced   = false;
+        deleter(context);
+    }
+    else if(m_alloced && m_data)
     {
         ///
         /// TODO: why do we need to check for empty here?
@@ -13082,7 +14510,10 @@ Node::release()
         if(dtype().id() != DataType::EMPTY_ID)
         {   
             // clean up our storage
-            free(m_data);
+            if(!is_data_inline())
+            {
+                free(m_data);
+            }
             m_data = NULL;
             m_data_size = 0;
             m_alloced   = false;
@@ -13145,6 +14576,9 @@ Node::init_defaults()
     m_mmaped    = false;
     m_mmap      = NULL;
 
+    m_deleter         = NULL;
+    m_deleter_context = NULL;
+
     m_schema = new Schema(DataType::EMPTY_ID);
     m_owns_schema = true;
     
@@ -13298,6 +14732,174 @@ Node::compact_elements_to(uint8 *data) const
 }
 
 
+//---------------------------------------------------------------------------//
+void
+Node::collect_leaves(std::vector<const Node*> &leaves) const
+{
+    index_t dtype_id = dtype().id();
+    if(dtype_id == DataType::OBJECT_ID ||
+       dtype_id == DataType::LIST_ID)
+    {
+        std::vector<Node*>::const_iterator itr;
+        for(itr = m_children.begin(); itr < m_children.end(); ++itr)
+        {
+            (*itr)->collect_leaves(leaves);
+        }
+    }
+    else if(dtype_id != DataType::EMPTY_ID &&
+            dtype().number_of_elements() > 0)
+    {
+        leaves.push_back(this);
+    }
+}
+
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+
+//---------------------------------------------------------------------------//
+// number of iovecs passed to each writev call
+//---------------------------------------------------------------------------//
+#if defined(IOV_MAX) && IOV_MAX < 512
+static const int NODE_WRITEV_BATCH = IOV_MAX;
+#else
+static const int NODE_WRITEV_BATCH = 512;
+#endif
+
+// size of the buffer used to stage the elements of strided leaves
+static const size_t NODE_WRITEV_STAGING_BYTES = 1 << 20;
+
+//---------------------------------------------------------------------------//
+// writev all of iov, handling partial writes
+//---------------------------------------------------------------------------//
+static void
+node_writev_all(int fd,
+                struct iovec *iov,
+                int iov_count,
+                const std::string &path)
+{
+    while(iov_count > 0)
+    {
+        ssize_t nwritten = ::writev(fd,iov,iov_count);
+        if(nwritten < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            CONDUIT_ERROR("<Node::serialize> failed to write: " << path);
+        }
+
+        // skip fully written iovecs, advance into a partial one
+        size_t remaining = (size_t)nwritten;
+        while(iov_count > 0 && remaining >= iov->iov_len)
+        {
+            remaining -= iov->iov_len;
+            iov++;
+            iov_count--;
+        }
+        if(iov_count > 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+Node::write_compact_data(int fd,
+                         const std::string &path) const
+{
+    std::vector<const Node*> leaves;
+    collect_leaves(leaves);
+
+    std::vector<struct iovec> iov;
+    iov.reserve(NODE_WRITEV_BATCH);
+
+    // strided leaves are staged, the staging buffer is only allocated
+    // if needed, and is reused once the iovecs that point to it are 
+    // written
+    std::vector<uint8> staging;
+    size_t staging_used = 0;
+
+    for(size_t i=0; i < leaves.size(); i++)
+    {
+        const Node    *leaf = leaves[i];
+        const DataType &dt  = leaf->dtype();
+
+        if(leaf->is_compact())
+        {
+            uint8  *ptr    = (uint8*)leaf->element_ptr(0);
+            size_t nbytes = (size_t)leaf->total_bytes_compact();
+
+            // merge with the previous segment if they are adjacent
+            if(!iov.empty() &&
+               (uint8*)iov.back().iov_base + iov.back().iov_len == ptr)
+            {
+                iov.back().iov_len += nbytes;
+            }
+            else
+            {
+                if((int)iov.size() == NODE_WRITEV_BATCH)
+                {
+                    node_writev_all(fd,&iov[0],(int)iov.size(),path);
+                    iov.clear();
+                    staging_used = 0;
+                }
+                struct iovec seg;
+                seg.iov_base = ptr;
+                seg.iov_len  = nbytes;
+                iov.push_back(seg);
+            }
+            continue;
+        }
+
+        // strided leaf: copy elements into staging, in chunks
+        if(staging.empty())
+        {
+            staging.resize(NODE_WRITEV_STAGING_BYTES);
+        }
+
+        index_t num_ele   = dt.number_of_elements();
+        index_t ele_bytes = DataType::default_bytes(dt.id());
+        index_t ele_idx   = 0;
+        while(ele_idx < num_ele)
+        {
+            size_t avail = staging.size() - staging_used;
+            if(avail < (size_t)ele_bytes || 
+               (int)iov.size() == NODE_WRITEV_BATCH)
+            {
+                node_writev_all(fd,&iov[0],(int)iov.size(),path);
+                iov.clear();
+                staging_used = 0;
+                avail = staging.size();
+            }
+
+            index_t count = std::min((index_t)(avail / (size_t)ele_bytes),
+                                     num_ele - ele_idx);
+            uint8 *dest = &staging[staging_used];
+            for(index_t j=0; j < count; j++)
+            {
+                memcpy(dest + j * ele_bytes,
+                       leaf->element_ptr(ele_idx + j),
+                       (size_t)ele_bytes);
+            }
+
+            struct iovec seg;
+            seg.iov_base = dest;
+            seg.iov_len  = (size_t)(count * ele_bytes);
+            iov.push_back(seg);
+
+            staging_used += (size_t)(count * ele_bytes);
+            ele_idx      += count;
+        }
+    }
+
+    if(!iov.empty())
+    {
+        node_writev_all(fd,&iov[0],(int)iov.size(),path);
+    }
+}
+
+#endif
+
 //---------------------------------------------------------------------------//
 void
 Node::serialize(uint8 *data,index_t curr_offset) const
@@ -13309,7 +14911,7 @@ Node::serialize(uint8 *data,index_t curr_offset) const
         for(itr = m_children.begin(); itr < m_children.end(); ++itr)
         {
             (*itr)->serialize(&data[0],curr_offset);
-            curr_offset+=(*itr)->total_strided_bytes();
+            curr_offset+=(*itr)->total_bytes_compact();
         }
     }
     else
@@ -13528,7 +15130,11 @@ Node::find_first_data_ptr() const
 
 //---------------------------------------------------------------------------//
 bool
-Node::diff(const Node &n, Node &info, const float64 epsilon) const
+Node::diff(const Node &n,
+           Node &info,
+           const float64 epsilon,
+           bool summary,
+           bool early_exit) const
 {
     const std::string protocol = "node::diff";
     bool res = false;
@@ -13558,7 +15164,7 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
 
         NodeConstIterator child_itr;
         child_itr = children();
-        while(child_itr.has_next())
+        while(child_itr.has_next() && !(res && early_exit))
         {
             const conduit::Node &t_child = child_itr.next();
             const std::string child_path = child_itr.name();
@@ -13571,14 +15177,20 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
             else
             {
                 Node &info_child = info_children["diff"][child_path];
-                res |= t_child.diff(n.fetch(child_path), info_child, epsilon);
+                res |= t_child.diff(n.fetch(child_path),
+                                    info_child,
+                                    epsilon,
+                                    summary,
+                                    early_exit);
             }
         }
 
+        // shared children were already compared above, we only need to
+        // look for children that exist in n but not in this node
         child_itr = n.children();
-        while(child_itr.has_next())
+        while(child_itr.has_next() && !(res && early_exit))
         {
-            const conduit::Node &n_child = child_itr.next();
+            child_itr.next();
             const std::string child_path = child_itr.name();
 
             if(!has_child(child_path))
@@ -13586,11 +15198,6 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
                 info_children["missing"].append().set(child_path);
                 res = true;
             }
-            else
-            {
-                Node &info_child = info_children["diff"][child_path];
-                res |= fetch(child_path).diff(n_child, info_child, epsilon);
-            }
         }
     }
     else if(t_dtid == DataType::LIST_ID)
@@ -13601,11 +15208,15 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
         index_t n_nchild = n.number_of_children();
 
         index_t i = 0;
-        for(; i < std::min(t_nchild, n_nchild); i++)
+        for(; i < std::min(t_nchild, n_nchild) && !(res && early_exit); i++)
         {
             const Node &t_child = child(i);
             const Node &n_child = n.child(i);
-            res |= t_child.diff(n_child, info_children["diff"].append(), epsilon);
+            res |= t_child.diff(n_child,
+                                info_children["diff"].append(),
+                                epsilon,
+                                summary,
+                                early_exit);
         }
         for(; i < std::max(t_nchild, n_nchild); i++)
         {
@@ -13620,61 +15231,61 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
         {
             int8_array t_array = value();
             int8_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int16())
         {
             int16_array t_array = value();
             int16_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int32())
         {
             int32_array t_array = value();
             int32_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int64())
         {
             int64_array t_array = value();
             int64_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint8())
         {
             uint8_array t_array = value();
             uint8_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint16())
         {
             uint16_array t_array = value();
             uint16_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint32())
         {
             uint32_array t_array = value();
             uint32_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint64())
         {
             uint64_array t_array = value();
             uint64_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_float32())
         {
             float32_array t_array = value();
             float32_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_float64())
         {
             float64_array t_array = value();
             float64_array n_array = n.value();
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_char8_str())
         {
@@ -13682,7 +15293,7 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
             // confuse the 'char' type on various platforms.
             char_array t_array((const void*)m_data, dtype());
             char_array n_array((const void*)n.m_data, n.dtype());
-            res |= t_array.diff(n_array, info, epsilon);
+            res |= t_array.diff(n_array, info, epsilon, summary, early_exit);
         }
         else
         {
@@ -13698,7 +15309,11 @@ Node::diff(const Node &n, Node &info, const float64 epsilon) const
 
 //---------------------------------------------------------------------------//
 bool
-Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
+Node::diff_compatible(const Node &n,
+                      Node &info,
+                      const float64 epsilon,
+                      bool summary,
+                      bool early_exit) const
 {
     const std::string protocol = "node::diff_compatible";
     bool res = false;
@@ -13727,7 +15342,7 @@ Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
         Node &info_children = info["children"];
 
         NodeConstIterator child_itr = children();
-        while(child_itr.has_next())
+        while(child_itr.has_next() && !(res && early_exit))
         {
             const conduit::Node &t_child = child_itr.next();
             const std::string child_path = child_itr.name();
@@ -13740,7 +15355,11 @@ Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
             else
             {
                 Node &info_child = info_children["diff"][child_path];
-                res |= t_child.diff_compatible(n.fetch(child_path), info_child, epsilon);
+                res |= t_child.diff_compatible(n.fetch(child_path),
+                                               info_child,
+                                               epsilon,
+                                               summary,
+                                               early_exit);
             }
         }
     }
@@ -13752,11 +15371,15 @@ Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
         index_t n_nchild = n.number_of_children();
 
         index_t i = 0;
-        for(; i < std::min(t_nchild, n_nchild); i++)
+        for(; i < std::min(t_nchild, n_nchild) && !(res && early_exit); i++)
         {
             const Node &t_child = child(i);
             const Node &n_child = n.child(i);
-            res |= t_child.diff_compatible(n_child, info_children["diff"].append(), epsilon);
+            res |= t_child.diff_compatible(n_child,
+                                           info_children["diff"].append(),
+                                           epsilon,
+                                           summary,
+                                           early_exit);
         }
         for(; i < t_nchild; i++)
         {
@@ -13770,61 +15393,61 @@ Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
         {
             int8_array t_array = value();
             int8_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int16())
         {
             int16_array t_array = value();
             int16_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int32())
         {
             int32_array t_array = value();
             int32_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_int64())
         {
             int64_array t_array = value();
             int64_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint8())
         {
             uint8_array t_array = value();
             uint8_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint16())
         {
             uint16_array t_array = value();
             uint16_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint32())
         {
             uint32_array t_array = value();
             uint32_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_uint64())
         {
             uint64_array t_array = value();
             uint64_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_float32())
         {
             float32_array t_array = value();
             float32_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_float64())
         {
             float64_array t_array = value();
             float64_array n_array = n.value();
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else if(dtype().is_char8_str())
         {
@@ -13832,7 +15455,7 @@ Node::diff_compatible(const Node &n, Node &info, const float64 epsilon) const
             // confuse the 'char' type on various platforms.
             char_array t_array((const void*)m_data, dtype());
             char_array n_array((const void*)n.m_data, n.dtype());
-            res |= t_array.diff_compatible(n_array, info, epsilon);
+            res |= t_array.diff_compatible(n_array, info, epsilon, summary, early_exit);
         }
         else
         {
@@ -68,6 +68,8 @@
 #include "conduit_data_type.hpp"
 #include "conduit_data_array.hpp"
 #include "conduit_schema.hpp"
+#include "conduit_memory.hpp"
+#include "conduit_type_traits.hpp"
 #include "conduit_generator.hpp"
 #include "conduit_node_iterator.hpp"
 #include "conduit_utils.hpp"
@@ -117,6 +119,9 @@ public:
     friend class NodeIterator;
     friend class NodeConstIterator;
     friend class Generator;
+    ///  PackedNode writes the compact data of a Node directly into
+    ///   its packed image
+    friend class PackedNode;
 
 //-----------------------------------------------------------------------------
 //
@@ -231,7 +236,19 @@ public:
 ///@{
 //-----------------------------------------------------------------------------
 /// description:
+///  protocols:
+///   "conduit_bin":    data in stream_path, schema in stream_path + "_json"
+///   "conduit_packed": schema and data in a single packed file 
+///                     (see conduit::PackedNode)
+///   json protocols:   "json", "conduit_json", "conduit_base64_json"
 ///
+///  Loading with "conduit_bin" also reads packed files, detected from the
+///  start of the file when it is opened. mmap(stream_path) uses 
+///  "conduit_bin", mmap(stream_path,protocol) accepts either protocol.
+///
+///  load_into() variants read into this node's existing buffers when it
+///  already holds data with the layout being loaded (e.g. the same file
+///  loaded every time step), and only reallocate when needed.
 //-----------------------------------------------------------------------------
     void load(const std::string &stream_path,
               const std::string &protocol="conduit_bin");
@@ -239,11 +256,20 @@ public:
     void load(const std::string &stream_path,
               const Schema &schema);
 
+    void load_into(const std::string &stream_path,
+                   const std::string &protocol="conduit_bin");
+
+    void load_into(const std::string &stream_path,
+                   const Schema &schema);
+
     void save(const std::string &stream_path,
               const std::string &protocol="conduit_bin") const;
 
     void mmap(const std::string &stream_path);
 
+    void mmap(const std::string &stream_path,
+              const std::string &protocol);
+
     void mmap(const std::string &stream_path,
               const Schema &schema);
 
@@ -274,6 +300,12 @@ public:
 //-----------------------------------------------------------------------------
     void set_node(const Node &data);
     void set(const Node &data);
+
+    /// like set(const Node &), but if this node already has the same 
+    /// tree structure as data, leaf values are copied into the existing 
+    /// buffers (respecting their strides). A leaf only reallocates when
+    /// its type or size changes and its buffer is too small.
+    void set_compatible(const Node &data);
     
     void set_dtype(const DataType &dtype);
     void set(const DataType &dtype);
@@ -281,6 +313,28 @@ public:
     void set_schema(const Schema &schema);    
     void set(const Schema &schema);
 
+    /// these variants allocate data using the passed memory policy, 
+    /// instead of the default (see conduit::MemoryPolicy)
+    /// if a leaf's existing buffer is compatible with dtype it is reused:
+    /// a buffer the node allocated is initialized according to the policy,
+    /// external or parent owned memory is left untouched (as with
+    /// set(DataType)). It is only reallocated when it does not have the
+    /// requested alignment (huge pages only apply to new allocations)
+    void set_dtype(const DataType &dtype,
+                   const MemoryPolicy &policy);
+    void set(const DataType &dtype,
+             const MemoryPolicy &policy);
+
+    void set_schema(const Schema &schema,
+                    const MemoryPolicy &policy);
+    void set(const Schema &schema,
+             const MemoryPolicy &policy);
+
+    /// these variants leave the data uninitialized, for callers that
+    /// will overwrite all of it
+    void set_uninitialized(const DataType &dtype);
+    void set_uninitialized(const Schema &schema);
+
     void set_data_using_schema(const Schema &schema, void *data);
     void set(const Schema &schema, void *data);
 
@@ -780,6 +834,91 @@ public:
 //
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+//
+// -- begin declaration of Node leaf growth methods --
+//
+//-----------------------------------------------------------------------------
+///@name Growable Leaves
+///@{
+//-----------------------------------------------------------------------------
+/// description:
+///  Methods that grow (or shrink) the number of elements in a leaf, 
+///  while keeping the allocated capacity separate from the number of
+///  elements described by the leaf's dtype.
+///
+///  Growing a leaf that does not own a compact allocation (external,
+///  mmaped, strided, or part of a parent's buffer) first copies its 
+///  elements into a compact buffer owned by this node.
+///
+///  push_back() and append_values() grow the capacity geometrically, 
+///  so repeated appends have amortized constant cost. Calling them on 
+///  an empty node creates a leaf of the passed type. The type of the 
+///  passed values must match the leaf's type.
+//-----------------------------------------------------------------------------
+    /// ensure capacity for at least num_elements elements
+    void     reserve(index_t num_elements);
+    /// change the number of elements, new elements are zero initialized
+    void     resize(index_t num_elements);
+    /// number of elements that fit in the leaf's current allocation
+    index_t  capacity() const;
+
+    // signed integer types
+    void push_back(int8 value);
+    void push_back(int16 value);
+    void push_back(int32 value);
+    void push_back(int64 value);
+
+    // unsigned integer types
+    void push_back(uint8 value);
+    void push_back(uint16 value);
+    void push_back(uint32 value);
+    void push_back(uint64 value);
+
+    // floating point types
+    void push_back(float32 value);
+    void push_back(float64 value);
+
+    // signed integer types via conduit::DataArray
+    void append_values(const int8_array &data);
+    void append_values(const int16_array &data);
+    void append_values(const int32_array &data);
+    void append_values(const int64_array &data);
+
+    // unsigned integer types via conduit::DataArray
+    void append_values(const uint8_array &data);
+    void append_values(const uint16_array &data);
+    void append_values(const uint32_array &data);
+    void append_values(const uint64_array &data);
+
+    // floating point types via conduit::DataArray
+    void append_values(const float32_array &data);
+    void append_values(const float64_array &data);
+
+    // signed integer types via std::vector
+    void append_values(const std::vector<int8> &data);
+    void append_values(const std::vector<int16> &data);
+    void append_values(const std::vector<int32> &data);
+    void append_values(const std::vector<int64> &data);
+
+    // unsigned integer types via std::vector
+    void append_values(const std::vector<uint8> &data);
+    void append_values(const std::vector<uint16> &data);
+    void append_values(const std::vector<uint32> &data);
+    void append_values(const std::vector<uint64> &data);
+
+    // floating point types via std::vector
+    void append_values(const std::vector<float32> &data);
+    void append_values(const std::vector<float64> &data);
+
+//-----------------------------------------------------------------------------
+///@}
+//-----------------------------------------------------------------------------
+//
+// -- end declaration of Node leaf growth methods --
+//
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 //
 // -- begin declaration of Node set_path methods --
@@ -1901,6 +2040,93 @@ public:
 //
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+//
+// -- begin declaration of Node set_owned methods --
+//
+//-----------------------------------------------------------------------------
+///@name Node::set_owned(...)
+///@{
+//-----------------------------------------------------------------------------
+/// description:
+///   set_owned(...) methods adopt the passed memory: the node points to 
+///   the data (like set_external) but takes ownership of it, and frees it
+///   with the passed deleter when the node releases its data.
+///
+///   When no deleter is passed, the data is freed with free(), so it must
+///   have been allocated with malloc, calloc or realloc.
+///
+///   The std::vector cases take the vector's storage (via swap), the
+///   passed vector is left empty.
+//-----------------------------------------------------------------------------
+    /// signature of functions used to free data adopted via set_owned
+    typedef void (*DataDeleter)(void *data);
+
+    //-------------------------------------------------------------------------
+    void set_owned_data_using_schema(const Schema &schema,
+                                     void *data,
+                                     DataDeleter deleter = NULL);
+
+    void set_owned(const Schema &schema,
+                   void *data,
+                   DataDeleter deleter = NULL);
+
+    //-------------------------------------------------------------------------
+    void set_owned_data_using_dtype(const DataType &dtype,
+                                    void *data,
+                                    DataDeleter deleter = NULL);
+
+    void set_owned(const DataType &dtype,
+                   void *data,
+                   DataDeleter deleter = NULL);
+
+    //-------------------------------------------------------------------------
+    // signed integer std::vector cases
+    //-------------------------------------------------------------------------
+    void set_owned_int8_vector(std::vector<int8> &data);
+    void set_owned(std::vector<int8> &data);
+
+    void set_owned_int16_vector(std::vector<int16> &data);
+    void set_owned(std::vector<int16> &data);
+
+    void set_owned_int32_vector(std::vector<int32> &data);
+    void set_owned(std::vector<int32> &data);
+
+    void set_owned_int64_vector(std::vector<int64> &data);
+    void set_owned(std::vector<int64> &data);
+
+    //-------------------------------------------------------------------------
+    // unsigned integer std::vector cases
+    //-------------------------------------------------------------------------
+    void set_owned_uint8_vector(std::vector<uint8> &data);
+    void set_owned(std::vector<uint8> &data);
+
+    void set_owned_uint16_vector(std::vector<uint16> &data);
+    void set_owned(std::vector<uint16> &data);
+
+    void set_owned_uint32_vector(std::vector<uint32> &data);
+    void set_owned(std::vector<uint32> &data);
+
+    void set_owned_uint64_vector(std::vector<uint64> &data);
+    void set_owned(std::vector<uint64> &data);
+
+    //-------------------------------------------------------------------------
+    // floating point std::vector cases
+    //-------------------------------------------------------------------------
+    void set_owned_float32_vector(std::vector<float32> &data);
+    void set_owned(std::vector<float32> &data);
+
+    void set_owned_float64_vector(std::vector<float64> &data);
+    void set_owned(std::vector<float64> &data);
+
+//-----------------------------------------------------------------------------
+///@}                      
+//-----------------------------------------------------------------------------
+//
+// -- end declaration of Node set_owned methods --
+//
+//-----------------------------------------------------------------------------
+
 //-----------------------------------------------------------------------------
 //
 // -- begin declaration of Node set_path_external methods --
@@ -2698,6 +2924,21 @@ public:
     void        serialize(const std::string &stream_path) const;
     /// serialize to an output stream
     void        serialize(std::ofstream &ofs) const;
+    /// number of bytes serialize() produces (the compact bytes of all
+    /// leaves). Computed from the schema on each call, no data is read.
+    index_t     serialized_size() const;
+    /// serialize into a caller provided buffer (pre-allocated, pinned,
+    /// shared memory, ...) that holds at least `capacity` bytes.
+    /// returns the number of bytes written, errors if capacity is too small
+    index_t     serialize_to(void *dst,
+                             index_t capacity) const;
+    /// set this node from `nbytes` of serialized data described by schema.
+    /// if this node already owns a buffer with the same layout (e.g. from
+    /// a prior call with the same schema) the data is copied into it
+    /// in place, without any allocation.
+    void        deserialize_from(const Schema &schema,
+                                 const void *src,
+                                 index_t nbytes);
 
 //-----------------------------------------------------------------------------
 // -- compaction methods ---
@@ -3116,7 +3357,7 @@ public:
                         { return *m_schema;}
 
     const DataType   &dtype() const
-                        { return m_schema->dtype();}
+                        { return schema().dtype();}
 
     Schema          *schema_ptr() 
                         {return m_schema;}
@@ -3200,16 +3441,29 @@ public:
 
     /// check for differences between this node and the given node, storing
     //  the results digest in the provided data node
+    ///
+    /// summary: numeric leaves report only first mismatch index, mismatch 
+    ///  count and max abs/rel error (info["summary"]) rather than allocating
+    ///  a per-element info["value"] array.
+    /// early_exit: stop at the first difference found (the info digest then
+    ///  only covers what was compared before the exit). Without summary, 
+    ///  numeric leaves then report only the index of their first mismatch
+    ///  (info["first_mismatch"]) instead of a per-element info["value"].
     bool             diff(const Node &n,
                           Node &info,
-                          const float64 epsilon = CONDUIT_EPSILON) const;
+                          const float64 epsilon = CONDUIT_EPSILON,
+                          bool summary = false,
+                          bool early_exit = false) const;
 
     /// diff this node to the given node for compatibility (i.e. validate it
     //  has everything that the instance node has), storing the results
     //  digest in the provided data node
+    //  (summary and early_exit are the same as for diff)
     bool             diff_compatible(const Node &n,
                                      Node &info,
-                                     const float64 epsilon = CONDUIT_EPSILON) const;
+                                     const float64 epsilon = CONDUIT_EPSILON,
+                                     bool summary = false,
+                                     bool early_exit = false) const;
 
     ///
     /// info() creates a node that contains metadata about the current
@@ -3555,6 +3809,100 @@ public:
 //
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+//
+// -- begin declaration of Node templated access methods --
+//
+//-----------------------------------------------------------------------------
+///@name Node Templated Access Methods
+///@{
+//-----------------------------------------------------------------------------
+/// description:
+///  Templated variants of the typed set and value access methods, for 
+///  generic code. The leaf type is selected at compile time via 
+///  conduit::DataTypeTraits<T>, and the calls resolve to the same 
+///  operations as the named methods (e.g. as<float64>() is as_float64()).
+///
+///  The template argument is never deduced, it must always be passed 
+///  explicitly: n.set<float32>(1.0) stores a float32.
+///
+///  The struct variants use the compile-time layout from 
+///  conduit::StructTraits<S> (see conduit_type_traits.hpp) to describe
+///  arrays of user structs.
+//-----------------------------------------------------------------------------
+    
+    /// scalar value
+    template<typename T>
+    T                     as() const;
+
+    /// pointer to the first element
+    template<typename T>
+    T                    *as_ptr();
+
+    template<typename T>
+    const T              *as_ptr() const;
+
+    /// array access (respects offset and stride)
+    template<typename T>
+    DataArray<T>          as_array();
+
+    template<typename T>
+    const DataArray<T>    as_array() const;
+
+    /// set a scalar value, converted to T
+    template<typename T>
+    void set(typename DataTypeTraits<T>::value_type data);
+
+    /// set from a std::vector
+    template<typename T>
+    void set(const std::vector<typename DataTypeTraits<T>::value_type> &data);
+
+    /// set from a pointer (copies the data)
+    template<typename T>
+    void set(const typename DataTypeTraits<T>::value_type *data,
+             index_t num_elements = 1,
+             index_t offset = 0,
+             index_t stride = sizeof(T),
+             index_t element_bytes = sizeof(T),
+             index_t endianness = Endianness::DEFAULT_ID);
+
+    /// point to external data (no copy)
+    template<typename T>
+    void set_external(typename DataTypeTraits<T>::value_type *data,
+                      index_t num_elements = 1,
+                      index_t offset = 0,
+                      index_t stride = sizeof(T),
+                      index_t element_bytes = sizeof(T),
+                      index_t endianness = Endianness::DEFAULT_ID);
+
+    /// copies num_structs structs (the buffer keeps the struct layout)
+    template<typename S>
+    void set_struct(const S *data,
+                    index_t num_structs = 1);
+
+    /// points to num_structs structs owned by the caller (no copy)
+    template<typename S>
+    void set_external_struct(S *data,
+                             index_t num_structs = 1);
+
+    /// returns a pointer to the structs described by this node.
+    /// The offsets, strides and types of the node's fields are checked 
+    /// against the layout of S (this visits each field), so fetch the 
+    /// pointer once, outside of loops.
+    template<typename S>
+    S                    *as_struct_ptr();
+
+    template<typename S>
+    const S              *as_struct_ptr() const;
+
+//-----------------------------------------------------------------------------
+///@}
+//-----------------------------------------------------------------------------
+//
+// -- end declaration of Node templated access methods --
+//
+//-----------------------------------------------------------------------------
+
 
 private:
 //-----------------------------------------------------------------------------
@@ -3722,13 +4070,53 @@ private:
 //-----------------------------------------------------------------------------
     // setup a node to at as a given type
     void             init(const DataType &dtype);
+    void             init(const DataType &dtype,
+                          const MemoryPolicy &policy);
+    // applies policy to a compatible owned leaf buffer that init will reuse,
+    // returns false if it can't be reused (for example misaligned)
+    bool             reuse_leaf(const MemoryPolicy &policy);
     // memory allocation and mapping routines
     void             allocate(index_t dsize);
+    void             allocate(index_t dsize,
+                              const MemoryPolicy &policy);
     void             allocate(const DataType &dtype);
     void             mmap(const std::string &stream_path,
                           index_t dsize);
     // release any alloced or memory mapped data
     void             release();
+    // true if this node owns a single buffer that all of its leaves 
+    // share, laid out exactly as described by schema
+    bool             has_reusable_layout(const Schema &schema) const;
+    // reads the data described by schema from an open file, into the
+    // existing buffer when reuse is true and the layout matches
+    void             load_stream(std::ifstream &ifs,
+                                 const Schema &schema,
+                                 bool reuse);
+    // grow a leaf to hold at least num_elements, optionally leaving
+    // room to grow geometrically
+    void             reserve_leaf(index_t num_elements,
+                                  bool geometric);
+    // adopt data, which is released by calling deleter(context)
+    void             set_owned_data(const Schema &schema,
+                                    void *data,
+                                    DataDeleter deleter,
+                                    void *context);
+    // append the elements described by src_dtype to this leaf
+    void             append_leaf_values(const DataType &src_dtype,
+                                        const void *src_data);
+    // copy nbytes of struct data described by schema (used by set_struct)
+    void             set_struct_data(const Schema &schema,
+                                     const void *data,
+                                     index_t nbytes);
+    // checks the leaf type used by the templated access methods
+    bool             check_dtype_id(index_t dtype_id,
+                                    const std::string &method) const;
+    // checks the schema used by as_struct_ptr
+    bool             check_struct_schema(const Schema &schema,
+                                         const std::string &method) const;
+    // true if m_data is this node's inline storage
+    bool             is_data_inline() const
+                        {return m_data == (const void*)m_inline_data;}
     // clean up everything (used by destructor)
     void             cleanup();
 
@@ -3762,6 +4150,14 @@ private:
                                  index_t curr_offset) const;
     /// compact helper for leaf types
     void              compact_elements_to(uint8 *data) const;
+    // writes the compact data of this node to a file descriptor with 
+    // gathered (writev) writes: contiguous leaves are written from their
+    // own memory, strided leaves are staged through a bounded buffer
+    // (not available on windows)
+    void              write_compact_data(int fd,
+                                         const std::string &path) const;
+    // collects the non-empty leaves of this node in serialization order
+    void              collect_leaves(std::vector<const Node*> &leaves) const;
 
 
     void              serialize(uint8 *data,
@@ -3910,6 +4306,21 @@ private:
     bool      m_alloced;
     // flag that indicates if m_data is memory-mapped
     bool      m_mmaped;
+
+    // storage for small allocations (scalars and short strings). When a
+    // node allocates no more than sizeof(m_inline_data) bytes, m_data
+    // points here instead of at a heap buffer (m_alloced is still true).
+    union
+    {
+        uint8    m_inline_data[16];
+        // forces alignment suitable for any leaf type
+        float64  m_inline_align;
+    };
+
+    // for data adopted via set_owned, the function used to release m_data
+    // (instead of free) and the argument passed to it
+    DataDeleter  m_deleter;
+    void        *m_deleter_context;
     
     // private class that implements a cross platform memory map interface
     class MMap;
@@ -3925,6 +4336,177 @@ private:
 // -- end conduit::Node --
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+// -- begin conduit::Node templated access methods --
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline T
+Node::as() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as<T>() const"))
+    {
+        return T(0);
+    }
+    return *((const T*)element_ptr(0));
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline T *
+Node::as_ptr()
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_ptr<T>()"))
+    {
+        return NULL;
+    }
+    return (T*)element_ptr(0);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline const T *
+Node::as_ptr() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_ptr<T>() const"))
+    {
+        return NULL;
+    }
+    return (const T*)element_ptr(0);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline DataArray<T>
+Node::as_array()
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_array<T>()"))
+    {
+        return DataArray<T>();
+    }
+    return DataArray<T>(m_data,dtype());
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline const DataArray<T>
+Node::as_array() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_array<T>() const"))
+    {
+        return DataArray<T>();
+    }
+    return DataArray<T>(m_data,dtype());
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline void
+Node::set(typename DataTypeTraits<T>::value_type data)
+{
+    // resolves to the typed set overload for T
+    set(data);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline void
+Node::set(const std::vector<typename DataTypeTraits<T>::value_type> &data)
+{
+    set(data);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline void
+Node::set(const typename DataTypeTraits<T>::value_type *data,
+          index_t num_elements,
+          index_t offset,
+          index_t stride,
+          index_t element_bytes,
+          index_t endianness)
+{
+    set(data,
+        num_elements,
+        offset,
+        stride,
+        element_bytes,
+        endianness);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline void
+Node::set_external(typename DataTypeTraits<T>::value_type *data,
+                   index_t num_elements,
+                   index_t offset,
+                   index_t stride,
+                   index_t element_bytes,
+                   index_t endianness)
+{
+    set_external(data,
+                 num_elements,
+                 offset,
+                 stride,
+                 element_bytes,
+                 endianness);
+}
+
+//---------------------------------------------------------------------------//
+template<typename S>
+inline void
+Node::set_struct(const S *data,
+                 index_t num_structs)
+{
+    Schema s;
+    StructTraits<S>::schema(s,num_structs);
+    set_struct_data(s,data,(index_t)sizeof(S) * num_structs);
+}
+
+//---------------------------------------------------------------------------//
+template<typename S>
+inline void
+Node::set_external_struct(S *data,
+                          index_t num_structs)
+{
+    Schema s;
+    StructTraits<S>::schema(s,num_structs);
+    set_external_data_using_schema(s,data);
+}
+
+//---------------------------------------------------------------------------//
+template<typename S>
+inline S *
+Node::as_struct_ptr()
+{
+    Schema s;
+    StructTraits<S>::schema(s);
+    if(!check_struct_schema(s,"as_struct_ptr<S>()"))
+    {
+        return NULL;
+    }
+    return (S*)m_data;
+}
+
+//---------------------------------------------------------------------------//
+template<typename S>
+inline const S *
+Node::as_struct_ptr() const
+{
+    Schema s;
+    StructTraits<S>::schema(s);
+    if(!check_struct_schema(s,"as_struct_ptr<S>() const"))
+    {
+        return NULL;
+    }
+    return (const S*)m_data;
+}
+
+//-----------------------------------------------------------------------------
+// -- end conduit::Node templated access methods --
+//-----------------------------------------------------------------------------
+
 }
 //-----------------------------------------------------------------------------
 // -- end conduit:: --
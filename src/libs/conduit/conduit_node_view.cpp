@@ -0,0 +1,583 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_node_view.cpp
+///
+//-----------------------------------------------------------------------------
+#include "conduit_node_view.hpp"
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <sstream>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_error.hpp"
+#include "conduit_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+// name returned for children that are not part of an object
+static const std::string node_view_empty_name;
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// NodeView
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// NodeView Construction
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+NodeView::NodeView()
+: m_schema(NULL),
+  m_data(NULL)
+{}
+
+//---------------------------------------------------------------------------//
+NodeView::NodeView(const Schema &schema,
+                   void *data)
+: m_schema(&schema),
+  m_data(data)
+{}
+
+//-----------------------------------------------------------------------------
+// Schema and data access
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+const Schema &
+NodeView::schema() const
+{
+    if(m_schema == NULL)
+    {
+        CONDUIT_ERROR("NodeView::schema() -- view is not valid");
+    }
+    return *m_schema;
+}
+
+//---------------------------------------------------------------------------//
+const DataType &
+NodeView::dtype() const
+{
+    return schema().dtype();
+}
+
+//---------------------------------------------------------------------------//
+void *
+NodeView::element_ptr(index_t idx) const
+{
+    return static_cast<char*>(m_data) + dtype().element_index(idx);
+}
+
+//-----------------------------------------------------------------------------
+// Child access
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+index_t
+NodeView::number_of_children() const
+{
+    if(m_schema == NULL)
+    {
+        return 0;
+    }
+    return m_schema->number_of_children();
+}
+
+//---------------------------------------------------------------------------//
+bool
+NodeView::has_child(const std::string &name) const
+{
+    if(m_schema == NULL)
+    {
+        return false;
+    }
+    return m_schema->has_child(name);
+}
+
+//---------------------------------------------------------------------------//
+bool
+NodeView::has_path(const std::string &path) const
+{
+    if(m_schema == NULL)
+    {
+        return false;
+    }
+    return m_schema->has_path(path);
+}
+
+//---------------------------------------------------------------------------//
+const std::vector<std::string> &
+NodeView::child_names() const
+{
+    return schema().child_names();
+}
+
+//---------------------------------------------------------------------------//
+const std::string &
+NodeView::child_name(index_t idx) const
+{
+    const std::vector<std::string> &names = child_names();
+    if(idx < 0 || idx >= (index_t)names.size())
+    {
+        return node_view_empty_name;
+    }
+    return names[(size_t)idx];
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeView::child(index_t idx) const
+{
+    return NodeView(schema().child(idx),m_data);
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeView::child(const std::string &name) const
+{
+    const Schema &s = schema();
+    if(!s.has_child(name))
+    {
+        CONDUIT_ERROR("NodeView::child -- no child named '" << name << "'");
+    }
+    return NodeView(s.fetch_child(name),m_data);
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeView::fetch(const std::string &path) const
+{
+    return NodeView(schema().fetch_child(path),m_data);
+}
+
+//-----------------------------------------------------------------------------
+// Conversion to Nodes
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+NodeView::to_node_external(Node &dest) const
+{
+    dest.set_external(schema(),m_data);
+}
+
+//---------------------------------------------------------------------------//
+void
+NodeView::compact_to(Node &dest) const
+{
+    Node n;
+    to_node_external(n);
+    n.compact_to(dest);
+}
+
+//---------------------------------------------------------------------------//
+std::string
+NodeView::to_json() const
+{
+    Node n;
+    to_node_external(n);
+    return n.to_json();
+}
+
+//---------------------------------------------------------------------------//
+bool
+NodeView::check_dtype_id(index_t dtype_id,
+                         const char *method) const
+{
+    index_t view_id = dtype().id();
+    CONDUIT_CHECK( (view_id == dtype_id) ,
+                    "NodeView::" << method << " -- DataType "
+                    << DataType::id_to_name(view_id)
+                    << " does not equal expected DataType "
+                    << DataType::id_to_name(dtype_id));
+    return view_id == dtype_id;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// ConstNodeView
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+ConstNodeView::ConstNodeView()
+: m_view()
+{}
+
+//---------------------------------------------------------------------------//
+ConstNodeView::ConstNodeView(const Schema &schema,
+                             const void *data)
+: m_view(schema,const_cast<void*>(data))
+{}
+
+//---------------------------------------------------------------------------//
+ConstNodeView::ConstNodeView(const NodeView &view)
+: m_view(view)
+{}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// FlatNodeView
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+FlatNodeView::FlatNodeView()
+: m_schema(NULL),
+  m_idx(0),
+  m_shift(0),
+  m_data(NULL)
+{}
+
+//---------------------------------------------------------------------------//
+FlatNodeView::FlatNodeView(const FlatSchema &schema,
+                           const void *data)
+: m_schema(&schema),
+  m_idx(0),
+  m_shift(0),
+  m_data(data)
+{
+    if(schema.number_of_entries() == 0)
+    {
+        m_schema = NULL;
+    }
+}
+
+//---------------------------------------------------------------------------//
+FlatNodeView::FlatNodeView(const FlatSchema &schema,
+                           index_t idx,
+                           index_t shift,
+                           const void *data)
+: m_schema(&schema),
+  m_idx(idx),
+  m_shift(shift),
+  m_data(data)
+{}
+
+//---------------------------------------------------------------------------//
+const FlatSchema &
+FlatNodeView::flat_schema() const
+{
+    if(m_schema == NULL)
+    {
+        CONDUIT_ERROR("FlatNodeView::flat_schema() -- view is not valid");
+    }
+    return *m_schema;
+}
+
+//---------------------------------------------------------------------------//
+DataType
+FlatNodeView::dtype() const
+{
+    if(m_schema == NULL)
+    {
+        return DataType::empty();
+    }
+    DataType res = m_schema->dtype(m_idx);
+    if(m_shift != 0 && !res.is_object() && !res.is_list())
+    {
+        res.set_offset(res.offset() + m_shift);
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatNodeView::dtype_id() const
+{
+    if(m_schema == NULL)
+    {
+        return DataType::EMPTY_ID;
+    }
+    return m_schema->dtype_id(m_idx);
+}
+
+//---------------------------------------------------------------------------//
+const void *
+FlatNodeView::element_ptr(index_t idx) const
+{
+    const FlatSchema::Entry &e = flat_schema().entry(m_idx);
+    return static_cast<const char*>(m_data) + 
+           e.offset + m_shift + idx * e.stride;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+FlatNodeView::number_of_children() const
+{
+    if(m_schema == NULL)
+    {
+        return 0;
+    }
+    return m_schema->number_of_children(m_idx);
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatNodeView::has_child(const std::string &name) const
+{
+    if(m_schema == NULL)
+    {
+        return false;
+    }
+    return m_schema->child_index(m_idx,name) != -1;
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatNodeView::has_path(const std::string &path) const
+{
+    index_t idx   = 0;
+    index_t shift = 0;
+    return fetch_entry(path,idx,shift);
+}
+
+//---------------------------------------------------------------------------//
+const char *
+FlatNodeView::child_name(index_t idx) const
+{
+    return flat_schema().name(m_schema->child(m_idx,idx));
+}
+
+//---------------------------------------------------------------------------//
+FlatNodeView
+FlatNodeView::child(index_t idx) const
+{
+    const FlatSchema &fs = flat_schema();
+    return FlatNodeView(fs,
+                        fs.child(m_idx,idx),
+                        m_shift + fs.child_offset(m_idx,idx),
+                        m_data);
+}
+
+//---------------------------------------------------------------------------//
+FlatNodeView
+FlatNodeView::child(const std::string &name) const
+{
+    index_t cidx = flat_schema().child_index(m_idx,name);
+    if(cidx == -1)
+    {
+        CONDUIT_ERROR("FlatNodeView::child -- no child named '"
+                      << name << "'");
+    }
+    // object children are never part of a repeated list entry, 
+    // so the shift passes through unchanged
+    return FlatNodeView(*m_schema,cidx,m_shift,m_data);
+}
+
+//---------------------------------------------------------------------------//
+FlatNodeView
+FlatNodeView::fetch(const std::string &path) const
+{
+    index_t idx   = 0;
+    index_t shift = 0;
+    if(!fetch_entry(path,idx,shift))
+    {
+        CONDUIT_ERROR("FlatNodeView::fetch -- path '" << path 
+                      << "' does not exist");
+    }
+    return FlatNodeView(*m_schema,idx,shift,m_data);
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatNodeView::fetch_entry(const std::string &path,
+                          index_t &idx,
+                          index_t &shift) const
+{
+    if(m_schema == NULL)
+    {
+        return false;
+    }
+
+    idx   = m_idx;
+    shift = m_shift;
+
+    std::string p_curr;
+    std::string p_next;
+    std::string p_rest = path;
+    while(!p_rest.empty())
+    {
+        utils::split_path(p_rest,p_curr,p_next);
+        p_rest = p_next;
+        if(p_curr.empty())
+        {
+            continue;
+        }
+        idx = m_schema->child_index(idx,p_curr);
+        if(idx == -1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatNodeView::to_node_external(Node &dest) const
+{
+    Schema s;
+    flat_schema().to_schema(m_idx,m_shift,s);
+    dest.set_external(s,const_cast<void*>(m_data));
+}
+
+//---------------------------------------------------------------------------//
+void
+FlatNodeView::compact_to(Node &dest) const
+{
+    Node n;
+    to_node_external(n);
+    n.compact_to(dest);
+}
+
+//---------------------------------------------------------------------------//
+std::string
+FlatNodeView::to_json() const
+{
+    Node n;
+    to_node_external(n);
+    return n.to_json();
+}
+
+//---------------------------------------------------------------------------//
+bool
+FlatNodeView::check_dtype_id(index_t dtype_id,
+                             const char *method) const
+{
+    index_t view_id = this->dtype_id();
+    CONDUIT_CHECK( (view_id == dtype_id) ,
+                    "FlatNodeView::" << method << " -- DataType "
+                    << DataType::id_to_name(view_id)
+                    << " does not equal expected DataType "
+                    << DataType::id_to_name(dtype_id));
+    return view_id == dtype_id;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// NodeViewIterator
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+NodeViewIterator::NodeViewIterator()
+: m_view(),
+  m_index(0),
+  m_num_children(0)
+{}
+
+//---------------------------------------------------------------------------//
+NodeViewIterator::NodeViewIterator(const NodeView &view,
+                                   index_t idx)
+: m_view(view),
+  m_index(idx),
+  m_num_children(view.number_of_children())
+{}
+
+//---------------------------------------------------------------------------//
+const std::string &
+NodeViewIterator::name() const
+{
+    return m_view.child_name(m_index-1);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+NodeViewIterator::index() const
+{
+    return m_index-1;
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeViewIterator::view() const
+{
+    return m_view.child(m_index-1);
+}
+
+//---------------------------------------------------------------------------//
+void
+NodeViewIterator::to_front()
+{
+    m_index = 0;
+}
+
+//---------------------------------------------------------------------------//
+bool
+NodeViewIterator::has_next() const
+{
+    return m_index < m_num_children;
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeViewIterator::next()
+{
+    m_index++;
+    return m_view.child(m_index-1);
+}
+
+//---------------------------------------------------------------------------//
+NodeView
+NodeViewIterator::peek_next() const
+{
+    return m_view.child(m_index);
+}
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
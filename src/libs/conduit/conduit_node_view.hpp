@@ -0,0 +1,515 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_node_view.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef CONDUIT_NODE_VIEW_HPP
+#define CONDUIT_NODE_VIEW_HPP
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_core.hpp"
+#include "conduit_data_type.hpp"
+#include "conduit_data_array.hpp"
+#include "conduit_schema.hpp"
+#include "conduit_flat_schema.hpp"
+#include "conduit_type_traits.hpp"
+#include "conduit_node.hpp"
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::NodeView --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::NodeView
+///
+/// description:
+///  A lightweight, non-owning view of data described by a Schema.
+///
+///  A NodeView is a pair of pointers: the Schema that describes the data
+///  and the base address the schema's offsets are relative to (the same 
+///  pair passed to Node::set_external(schema,data)). Views are cheap to 
+///  copy and child access returns a new view, so traversing a hierarchy 
+///  does not allocate Node objects. 
+///
+///  The view does not own the schema or the data, both must outlive it.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API NodeView
+{
+public:
+//-----------------------------------------------------------------------------
+/// NodeView Construction 
+//-----------------------------------------------------------------------------
+    /// creates an invalid (empty) view
+    NodeView();
+    /// view of the data at data described by schema
+    NodeView(const Schema &schema,
+             void *data);
+
+    /// true if the view points to a schema
+    bool                valid() const
+                            { return m_schema != NULL; }
+
+//-----------------------------------------------------------------------------
+/// Schema and data access
+//-----------------------------------------------------------------------------
+    const Schema       &schema() const;
+    const DataType     &dtype() const;
+    
+    /// base address the schema's offsets are relative to
+    void               *data_ptr() const
+                            { return m_data; }
+
+    /// address of a leaf element (respects offset and stride)
+    void               *element_ptr(index_t idx) const;
+
+//-----------------------------------------------------------------------------
+/// Child access
+//-----------------------------------------------------------------------------
+    index_t             number_of_children() const;
+    bool                has_child(const std::string &name) const;
+    bool                has_path(const std::string &path) const;
+
+    /// names of an object's children, returned by reference
+    const std::vector<std::string> &child_names() const;
+    /// name of the child at idx, empty for list children
+    const std::string  &child_name(index_t idx) const;
+
+    NodeView            child(index_t idx) const;
+    NodeView            child(const std::string &name) const;
+    /// fetch a descendant using a path ("a/b/c")
+    NodeView            fetch(const std::string &path) const;
+
+    NodeView            operator[](index_t idx) const
+                            { return child(idx); }
+    NodeView            operator[](const std::string &path) const
+                            { return fetch(path); }
+
+//-----------------------------------------------------------------------------
+/// Typed leaf access (see conduit::DataTypeTraits)
+//-----------------------------------------------------------------------------
+    /// scalar value
+    template<typename T>
+    T                   as() const;
+    /// pointer to the first element
+    template<typename T>
+    T                  *as_ptr() const;
+    /// array access (respects offset and stride)
+    template<typename T>
+    DataArray<T>        as_array() const;
+
+//-----------------------------------------------------------------------------
+/// Conversion to Nodes
+//-----------------------------------------------------------------------------
+    /// points dest to the viewed data (no copy)
+    void                to_node_external(Node &dest) const;
+    /// copies the viewed data into dest in compact form
+    void                compact_to(Node &dest) const;
+
+    std::string         to_json() const;
+
+private:
+    // checks the leaf type used by the templated access methods
+    bool                check_dtype_id(index_t dtype_id,
+                                       const char *method) const;
+
+    const Schema *m_schema;
+    void         *m_data;
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::NodeView --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::ConstNodeView --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::ConstNodeView
+///
+/// description:
+///  Read only variant of conduit::NodeView.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API ConstNodeView
+{
+public:
+//-----------------------------------------------------------------------------
+/// ConstNodeView Construction 
+//-----------------------------------------------------------------------------
+    /// creates an invalid (empty) view
+    ConstNodeView();
+    /// view of the data at data described by schema
+    ConstNodeView(const Schema &schema,
+                  const void *data);
+    /// read only view of a NodeView
+    ConstNodeView(const NodeView &view);
+
+    bool                valid() const
+                            { return m_view.valid(); }
+
+//-----------------------------------------------------------------------------
+/// Schema and data access
+//-----------------------------------------------------------------------------
+    const Schema       &schema() const
+                            { return m_view.schema(); }
+    const DataType     &dtype() const
+                            { return m_view.dtype(); }
+    const void         *data_ptr() const
+                            { return m_view.data_ptr(); }
+    const void         *element_ptr(index_t idx) const
+                            { return m_view.element_ptr(idx); }
+
+//-----------------------------------------------------------------------------
+/// Child access
+//-----------------------------------------------------------------------------
+    index_t             number_of_children() const
+                            { return m_view.number_of_children(); }
+    bool                has_child(const std::string &name) const
+                            { return m_view.has_child(name); }
+    bool                has_path(const std::string &path) const
+                            { return m_view.has_path(path); }
+
+    const std::vector<std::string> &child_names() const
+                            { return m_view.child_names(); }
+    const std::string  &child_name(index_t idx) const
+                            { return m_view.child_name(idx); }
+
+    ConstNodeView       child(index_t idx) const
+                            { return ConstNodeView(m_view.child(idx)); }
+    ConstNodeView       child(const std::string &name) const
+                            { return ConstNodeView(m_view.child(name)); }
+    ConstNodeView       fetch(const std::string &path) const
+                            { return ConstNodeView(m_view.fetch(path)); }
+
+    ConstNodeView       operator[](index_t idx) const
+                            { return child(idx); }
+    ConstNodeView       operator[](const std::string &path) const
+                            { return fetch(path); }
+
+//-----------------------------------------------------------------------------
+/// Typed leaf access (see conduit::DataTypeTraits)
+//-----------------------------------------------------------------------------
+    template<typename T>
+    T                   as() const
+                            { return m_view.as<T>(); }
+    template<typename T>
+    const T            *as_ptr() const
+                            { return m_view.as_ptr<T>(); }
+    template<typename T>
+    const DataArray<T>  as_array() const
+                            { return m_view.as_array<T>(); }
+
+//-----------------------------------------------------------------------------
+/// Conversion to Nodes
+//-----------------------------------------------------------------------------
+    void                compact_to(Node &dest) const
+                            { m_view.compact_to(dest); }
+
+    std::string         to_json() const
+                            { return m_view.to_json(); }
+
+private:
+    // a ConstNodeView only exposes const access to the wrapped view
+    NodeView m_view;
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::ConstNodeView --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::NodeViewIterator --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::NodeViewIterator
+///
+/// description:
+///  Iterates the children of a NodeView. Follows the NodeIterator 
+///  interface, but returns views and names by reference.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API NodeViewIterator
+{
+public:
+    NodeViewIterator();
+    NodeViewIterator(const NodeView &view,
+                     index_t idx=0);
+
+    const std::string  &name()  const;
+    index_t             index() const;
+    NodeView            view()  const;
+    void                to_front();
+
+    bool                has_next() const;
+    NodeView            next();
+    NodeView            peek_next() const;
+
+private:
+    NodeView m_view;
+    index_t  m_index;
+    index_t  m_num_children;
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::NodeViewIterator --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::FlatNodeView --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::FlatNodeView
+///
+/// description:
+///  Read only view of data described by a FlatSchema. 
+///
+///  A FlatNodeView holds a FlatSchema entry index, the offset shift for 
+///  children of repeated lists, and the data base address. Child access
+///  uses the FlatSchema's index arrays (object children are found with a 
+///  binary search), so traversal allocates neither Nodes nor Schemas.
+///
+///  Paths passed to fetch() may only descend ("a/b/c"), since the offset
+///  shifts of repeated lists are not known when walking up the tree.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API FlatNodeView
+{
+public:
+//-----------------------------------------------------------------------------
+/// FlatNodeView Construction 
+//-----------------------------------------------------------------------------
+    /// creates an invalid (empty) view
+    FlatNodeView();
+    /// view of the root entry of schema, over data
+    FlatNodeView(const FlatSchema &schema,
+                 const void *data);
+    /// view of the entry idx of schema, over data
+    FlatNodeView(const FlatSchema &schema,
+                 index_t idx,
+                 index_t shift,
+                 const void *data);
+
+    bool                valid() const
+                            { return m_schema != NULL; }
+
+//-----------------------------------------------------------------------------
+/// Schema and data access
+//-----------------------------------------------------------------------------
+    const FlatSchema   &flat_schema() const;
+    /// index of the viewed entry in the flat schema
+    index_t             entry_index() const
+                            { return m_idx; }
+    /// data type of the entry (including the offset shift)
+    DataType            dtype() const;
+    index_t             dtype_id() const;
+
+    const void         *data_ptr() const
+                            { return m_data; }
+    const void         *element_ptr(index_t idx) const;
+
+//-----------------------------------------------------------------------------
+/// Child access
+//-----------------------------------------------------------------------------
+    index_t             number_of_children() const;
+    bool                has_child(const std::string &name) const;
+    bool                has_path(const std::string &path) const;
+    /// name of the child at idx, empty for list children
+    const char         *child_name(index_t idx) const;
+
+    FlatNodeView        child(index_t idx) const;
+    FlatNodeView        child(const std::string &name) const;
+    /// fetch a descendant using a path ("a/b/c")
+    FlatNodeView        fetch(const std::string &path) const;
+
+    FlatNodeView        operator[](index_t idx) const
+                            { return child(idx); }
+    FlatNodeView        operator[](const std::string &path) const
+                            { return fetch(path); }
+
+//-----------------------------------------------------------------------------
+/// Typed leaf access (see conduit::DataTypeTraits)
+//-----------------------------------------------------------------------------
+    template<typename T>
+    T                   as() const;
+    template<typename T>
+    const T            *as_ptr() const;
+    template<typename T>
+    const DataArray<T>  as_array() const;
+
+//-----------------------------------------------------------------------------
+/// Conversion to Nodes (these thaw the viewed subtree into a Schema)
+//-----------------------------------------------------------------------------
+    /// points dest to the viewed data (no copy)
+    void                to_node_external(Node &dest) const;
+    /// copies the viewed data into dest in compact form
+    void                compact_to(Node &dest) const;
+
+    std::string         to_json() const;
+
+private:
+    // fetch entry index and shift of a descendant, false if missing
+    bool                fetch_entry(const std::string &path,
+                                    index_t &idx,
+                                    index_t &shift) const;
+    // checks the leaf type used by the templated access methods
+    bool                check_dtype_id(index_t dtype_id,
+                                       const char *method) const;
+
+    const FlatSchema *m_schema;
+    index_t           m_idx;
+    index_t           m_shift;
+    const void       *m_data;
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::FlatNodeView --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::NodeView templated access methods --
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline T
+NodeView::as() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as<T>()"))
+    {
+        return T(0);
+    }
+    return *((const T*)element_ptr(0));
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline T *
+NodeView::as_ptr() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_ptr<T>()"))
+    {
+        return NULL;
+    }
+    return (T*)element_ptr(0);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline DataArray<T>
+NodeView::as_array() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_array<T>()"))
+    {
+        return DataArray<T>();
+    }
+    return DataArray<T>(m_data,dtype());
+}
+
+//-----------------------------------------------------------------------------
+// -- end conduit::NodeView templated access methods --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::FlatNodeView templated access methods --
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline T
+FlatNodeView::as() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as<T>()"))
+    {
+        return T(0);
+    }
+    return *((const T*)element_ptr(0));
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline const T *
+FlatNodeView::as_ptr() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_ptr<T>()"))
+    {
+        return NULL;
+    }
+    return (const T*)element_ptr(0);
+}
+
+//---------------------------------------------------------------------------//
+template<typename T>
+inline const DataArray<T>
+FlatNodeView::as_array() const
+{
+    if(!check_dtype_id(DataTypeTraits<T>::id, "as_array<T>()"))
+    {
+        return DataArray<T>();
+    }
+    return DataArray<T>(const_cast<void*>(m_data),dtype());
+}
+
+//-----------------------------------------------------------------------------
+// -- end conduit::FlatNodeView templated access methods --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,728 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_packed_node.cpp
+///
+//-----------------------------------------------------------------------------
+#include "conduit_packed_node.hpp"
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <string.h>
+
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_endianness.hpp"
+#include "conduit_error.hpp"
+#include "conduit_utils.hpp"
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+// magic bytes at the start of every packed image
+static const char    PACKED_NODE_MAGIC[8] = {'C','N','D','T',
+                                             'P','A','C','K'};
+static const int32   PACKED_NODE_VERSION = 1;
+
+const int16   PackedNode::CHECKSUM;
+const index_t PackedNode::DATA_ALIGNMENT;
+
+//---------------------------------------------------------------------------//
+static index_t
+packed_node_align(index_t offset)
+{
+    index_t align = PackedNode::DATA_ALIGNMENT;
+    return ((offset + align - 1) / align) * align;
+}
+
+//---------------------------------------------------------------------------//
+// compact schema of node, and its frozen form
+//---------------------------------------------------------------------------//
+static void
+packed_node_schema(const Node &node,
+                   FlatSchema &flat_schema)
+{
+    Schema compact_schema;
+    node.schema().compact_to(compact_schema);
+    flat_schema.set(compact_schema);
+}
+
+//---------------------------------------------------------------------------//
+// fills the header for node's packed image, everything but the checksum
+//---------------------------------------------------------------------------//
+static void
+packed_node_header(const Node &node,
+                   const FlatSchema &flat_schema,
+                   bool checksum_data,
+                   PackedNode::Header &h)
+{
+    memset(&h,0,sizeof(PackedNode::Header));
+    memcpy(h.magic,PACKED_NODE_MAGIC,sizeof(h.magic));
+    h.version       = PACKED_NODE_VERSION;
+    h.flags         = checksum_data ? PackedNode::CHECKSUM : 0;
+    h.endianness    = (int16)Endianness::machine_default();
+    h.schema_offset = (int64)sizeof(PackedNode::Header);
+    h.schema_bytes  = flat_schema.serialized_size();
+    h.data_offset   = packed_node_align(h.schema_offset + h.schema_bytes);
+    h.data_bytes    = node.total_bytes_compact();
+}
+
+//---------------------------------------------------------------------------//
+// 64-bit FNV-1a, continuing from hash (the offset basis and prime are built
+// from 32-bit halves, since c++98 lacks 64-bit literals)
+//---------------------------------------------------------------------------//
+static uint64
+packed_node_fnv_basis()
+{
+    return ((uint64)0xcbf29ce4 << 32) | (uint64)0x84222325;
+}
+
+//---------------------------------------------------------------------------//
+static uint64
+packed_node_fnv(const void *data,
+                index_t data_size,
+                uint64 hash)
+{
+    const uint8 *ptr = (const uint8*)data;
+    uint64 prime = ((uint64)0x00000100 << 32) | (uint64)0x000001b3;
+    for(index_t i=0; i < data_size; i++)
+    {
+        hash ^= (uint64)ptr[i];
+        hash *= prime;
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- Writing packed images --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+index_t
+PackedNode::packed_size(const Node &node)
+{
+    FlatSchema fs;
+    packed_node_schema(node,fs);
+    Header h;
+    packed_node_header(node,fs,false,h);
+    return (index_t)(h.data_offset + h.data_bytes);
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::pack(const Node &node,
+                 std::vector<uint8> &buffer,
+                 bool checksum)
+{
+    buffer.resize((size_t)packed_size(node));
+    pack(node,&buffer[0],(index_t)buffer.size(),checksum);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+PackedNode::pack(const Node &node,
+                 void *buffer,
+                 index_t capacity,
+                 bool checksum_data)
+{
+    FlatSchema fs;
+    packed_node_schema(node,fs);
+
+    Header h;
+    packed_node_header(node,fs,checksum_data,h);
+
+    index_t nbytes = (index_t)(h.data_offset + h.data_bytes);
+    if(nbytes > capacity)
+    {
+        CONDUIT_ERROR("PackedNode::pack: buffer capacity (" << capacity
+                      << " bytes) is too small to hold packed node ("
+                      << nbytes << " bytes)");
+    }
+
+    uint8 *ptr = (uint8*)buffer;
+    fs.serialize(ptr + h.schema_offset);
+
+    // zero the padding between the schema and data blocks
+    index_t schema_end = h.schema_offset + h.schema_bytes;
+    memset(ptr + schema_end, 0, (size_t)(h.data_offset - schema_end));
+
+    if(h.data_bytes > 0)
+    {
+        node.serialize(ptr + h.data_offset,0);
+    }
+
+    if(checksum_data)
+    {
+        h.checksum = checksum(ptr + h.data_offset, h.data_bytes);
+    }
+
+    memcpy(ptr,&h,sizeof(Header));
+    return nbytes;
+}
+
+//---------------------------------------------------------------------------//
+bool
+PackedNode::is_packed(const void *data,
+                      index_t data_size)
+{
+    if(data == NULL || data_size < (index_t)sizeof(Header))
+    {
+        return false;
+    }
+    return memcmp(data,PACKED_NODE_MAGIC,sizeof(PACKED_NODE_MAGIC)) == 0;
+}
+
+//---------------------------------------------------------------------------//
+uint64
+PackedNode::checksum(const void *data,
+                     index_t data_size)
+{
+    return packed_node_fnv(data,data_size,packed_node_fnv_basis());
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- Packed files --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::save(const Node &node,
+                 const std::string &path,
+                 bool checksum_data)
+{
+    FlatSchema fs;
+    packed_node_schema(node,fs);
+
+    Header h;
+    packed_node_header(node,fs,checksum_data,h);
+    if(checksum_data)
+    {
+        // computed in a read only pass, so the data can be streamed
+        h.checksum = checksum(node);
+    }
+
+    // header, schema and padding
+    std::vector<uint8> meta;
+    meta.reserve((size_t)h.data_offset);
+    meta.resize(sizeof(Header));
+    memcpy(&meta[0],&h,sizeof(Header));
+    std::vector<uint8> schema_image;
+    fs.serialize(schema_image);
+    meta.insert(meta.end(),schema_image.begin(),schema_image.end());
+    meta.resize((size_t)h.data_offset,0);
+
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if(fd < 0)
+    {
+        CONDUIT_ERROR("<PackedNode::save> failed to open: " << path);
+    }
+
+    const uint8 *ptr = &meta[0];
+    size_t remaining = meta.size();
+    while(remaining > 0)
+    {
+        ssize_t nwritten = ::write(fd,ptr,remaining);
+        if(nwritten < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            ::close(fd);
+            CONDUIT_ERROR("<PackedNode::save> failed to write: " << path);
+        }
+        ptr       += nwritten;
+        remaining -= (size_t)nwritten;
+    }
+
+    // data is gathered directly from the node's leaves
+    try
+    {
+        node.write_compact_data(fd,path);
+    }
+    catch(...)
+    {
+        // don't leak the fd when the write fails
+        ::close(fd);
+        throw;
+    }
+
+    if(::close(fd) != 0)
+    {
+        CONDUIT_ERROR("<PackedNode::save> failed to close: " << path);
+    }
+#else
+    std::ofstream ofs;
+    ofs.open(path.c_str(), std::ios_base::binary);
+    if(!ofs.is_open())
+    {
+        CONDUIT_ERROR("<PackedNode::save> failed to open: " << path);
+    }
+    ofs.write((const char*)&meta[0],(std::streamsize)meta.size());
+    node.serialize(ofs);
+    if(!ofs.good())
+    {
+        CONDUIT_ERROR("<PackedNode::save> failed to write: " << path);
+    }
+    ofs.close();
+#endif
+}
+
+//---------------------------------------------------------------------------//
+uint64
+PackedNode::checksum(const Node &node)
+{
+    std::vector<const Node*> leaves;
+    node.collect_leaves(leaves);
+
+    uint64 hash = packed_node_fnv_basis();
+    for(size_t i=0; i < leaves.size(); i++)
+    {
+        const Node *leaf = leaves[i];
+        if(leaf->is_compact())
+        {
+            hash = packed_node_fnv(leaf->element_ptr(0),
+                                   leaf->total_bytes_compact(),
+                                   hash);
+        }
+        else
+        {
+            index_t num_ele   = leaf->dtype().number_of_elements();
+            index_t ele_bytes = DataType::default_bytes(leaf->dtype().id());
+            for(index_t j=0; j < num_ele; j++)
+            {
+                hash = packed_node_fnv(leaf->element_ptr(j),
+                                       ele_bytes,
+                                       hash);
+            }
+        }
+    }
+    return hash;
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::open_file(std::ifstream &ifs,
+                      const std::string &path)
+{
+    ifs.open(path.c_str(), std::ios_base::binary);
+    if(!ifs.is_open())
+    {
+        CONDUIT_ERROR("<PackedNode> failed to open: " << path);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::read_file_schema(std::ifstream &ifs,
+                             const std::string &path,
+                             Header &h,
+                             FlatSchema &flat_schema)
+{
+    ifs.seekg(0,std::ios_base::end);
+    index_t file_size = (index_t)ifs.tellg();
+    ifs.seekg(0,std::ios_base::beg);
+
+    if(file_size < (index_t)sizeof(Header))
+    {
+        CONDUIT_ERROR("<PackedNode> " << path << " is not a packed file");
+    }
+
+    ifs.read((char*)&h,sizeof(Header));
+    if(memcmp(h.magic,PACKED_NODE_MAGIC,sizeof(PACKED_NODE_MAGIC)) != 0)
+    {
+        CONDUIT_ERROR("<PackedNode> " << path << " is not a packed file");
+    }
+    check_header(h,file_size,path);
+
+    std::vector<uint8> meta((size_t)h.schema_bytes);
+    ifs.seekg((std::streamoff)h.schema_offset,std::ios_base::beg);
+    if(h.schema_bytes > 0)
+    {
+        ifs.read((char*)&meta[0],(std::streamsize)h.schema_bytes);
+    }
+    flat_schema.deserialize(meta.empty() ? NULL : &meta[0],
+                            h.schema_bytes);
+    check_data_span(h,flat_schema,path);
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::load(const std::string &path,
+                 Node &dest)
+{
+    std::ifstream ifs;
+    open_file(ifs,path);
+    read_file(ifs,path,dest,false);
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::load_into(const std::string &path,
+                      Node &dest)
+{
+    std::ifstream ifs;
+    open_file(ifs,path);
+    read_file(ifs,path,dest,true);
+}
+
+//---------------------------------------------------------------------------//
+bool
+PackedNode::load_if_packed(std::ifstream &ifs,
+                           const std::string &path,
+                           Node &dest,
+                           bool reuse)
+{
+    char magic[sizeof(PACKED_NODE_MAGIC)];
+    ifs.seekg(0,std::ios_base::beg);
+    ifs.read(magic,sizeof(magic));
+    bool res = ifs.gcount() == (std::streamsize)sizeof(magic) &&
+               memcmp(magic,PACKED_NODE_MAGIC,sizeof(magic)) == 0;
+
+    if(res)
+    {
+        read_file(ifs,path,dest,reuse);
+    }
+    else
+    {
+        // rewind (clearing eof for short files) for the caller
+        ifs.clear();
+        ifs.seekg(0,std::ios_base::beg);
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::read_file(std::ifstream &ifs,
+                      const std::string &path,
+                      Node &dest,
+                      bool reuse)
+{
+    Header h;
+    FlatSchema fs;
+    read_file_schema(ifs,path,h,fs);
+
+    // the data block must hold exactly the compact data described by the
+    // schema, otherwise reading it would overrun dest's buffer
+    index_t schema_bytes = fs.total_bytes_compact();
+    if(h.data_bytes != schema_bytes ||
+       h.data_bytes > fs.spanned_bytes())
+    {
+        CONDUIT_ERROR("<PackedNode::load> " << path << " holds "
+                      << h.data_bytes << " data bytes, but its schema "
+                      "describes " << schema_bytes << " bytes");
+    }
+
+    Schema s;
+    fs.to_schema(s);
+
+    // read the data directly into dest's buffer
+    if(!reuse || !dest.has_reusable_layout(s))
+    {
+        dest.set_uninitialized(s);
+    }
+    if(h.data_bytes > 0)
+    {
+        ifs.seekg((std::streamoff)h.data_offset,std::ios_base::beg);
+        ifs.read((char*)dest.data_ptr(),(std::streamsize)h.data_bytes);
+        if(ifs.gcount() != (std::streamsize)h.data_bytes)
+        {
+            CONDUIT_ERROR("<PackedNode::load> failed to read data from: " 
+                          << path);
+        }
+    }
+    ifs.close();
+
+    if( (h.flags & CHECKSUM) != 0 &&
+        checksum(dest.data_ptr(),h.data_bytes) != h.checksum)
+    {
+        CONDUIT_ERROR("<PackedNode::load> checksum mismatch for: " 
+                      << path);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::mmap(const std::string &path,
+                 Node &dest)
+{
+    Header h;
+    FlatSchema fs;
+    std::ifstream ifs;
+    open_file(ifs,path);
+    read_file_schema(ifs,path,h,fs);
+    ifs.close();
+
+    dest.reset();
+    dest.mmap(path,(index_t)(h.data_offset + h.data_bytes));
+
+    // see Node::mmap(path,schema) for the bookkeeping used here
+    dest.m_mmaped = false;
+    fs.to_schema(*dest.m_schema);
+    Node::walk_schema(&dest,
+                      dest.m_schema,
+                      (uint8*)dest.m_data + h.data_offset);
+    dest.m_mmaped = true;
+}
+
+//---------------------------------------------------------------------------//
+bool
+PackedNode::is_packed_file(const std::string &path)
+{
+    std::ifstream ifs;
+    ifs.open(path.c_str(), std::ios_base::binary);
+    if(!ifs.is_open())
+    {
+        return false;
+    }
+    char magic[sizeof(PACKED_NODE_MAGIC)];
+    ifs.read(magic,sizeof(magic));
+    bool res = ifs.gcount() == (std::streamsize)sizeof(magic) &&
+               memcmp(magic,PACKED_NODE_MAGIC,sizeof(magic)) == 0;
+    ifs.close();
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- Construction and opening images --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+PackedNode::PackedNode()
+: m_schema(),
+  m_image(NULL)
+{
+    memset(&m_header,0,sizeof(Header));
+}
+
+//---------------------------------------------------------------------------//
+PackedNode::PackedNode(const void *data,
+                       index_t data_size)
+: m_schema(),
+  m_image(NULL)
+{
+    memset(&m_header,0,sizeof(Header));
+    open(data,data_size);
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::open(const void *data,
+                 index_t data_size)
+{
+    close();
+
+    if(!is_packed(data,data_size))
+    {
+        CONDUIT_ERROR("<PackedNode::open> buffer does not hold a packed "
+                      "node");
+    }
+
+    Header h;
+    memcpy(&h,data,sizeof(Header));
+    check_header(h,data_size,"buffer");
+
+    const uint8 *image = (const uint8*)data;
+    m_schema.deserialize(image + h.schema_offset,h.schema_bytes);
+    check_data_span(h,m_schema,"buffer");
+
+    m_header = h;
+    m_image  = image;
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::close()
+{
+    memset(&m_header,0,sizeof(Header));
+    m_schema.reset();
+    m_image = NULL;
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::check_header(const Header &h,
+                         index_t image_size,
+                         const std::string &source)
+{
+    if(h.version != PACKED_NODE_VERSION)
+    {
+        CONDUIT_ERROR("<PackedNode> " << source << " has unsupported "
+                      "packed node version " << h.version);
+    }
+
+    if(h.endianness != (int16)Endianness::machine_default())
+    {
+        CONDUIT_ERROR("<PackedNode> " << source << " was written with a "
+                      "different byte order");
+    }
+
+    // the blocks are checked against the remaining image size, so the
+    // sums can't overflow
+    if(h.schema_offset < (int64)sizeof(Header) ||
+       h.schema_offset > image_size ||
+       h.schema_bytes  < 0 ||
+       h.schema_bytes  > image_size - h.schema_offset ||
+       h.data_offset   < h.schema_offset + h.schema_bytes ||
+       h.data_offset   > image_size ||
+       h.data_bytes    < 0 ||
+       h.data_bytes    > image_size - h.data_offset)
+    {
+        CONDUIT_ERROR("<PackedNode> " << source << " has an invalid header,"
+                      " or is truncated (" << image_size << " bytes)");
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::check_data_span(const Header &h,
+                            const FlatSchema &flat_schema,
+                            const std::string &source)
+{
+    index_t span = flat_schema.spanned_bytes();
+    if(span > h.data_bytes)
+    {
+        CONDUIT_ERROR("<PackedNode> " << source << " has a schema that "
+                      "spans " << span << " bytes, but only holds " 
+                      << h.data_bytes << " data bytes");
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- Image access --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+const void *
+PackedNode::data_ptr() const
+{
+    if(m_image == NULL)
+    {
+        return NULL;
+    }
+    return m_image + m_header.data_offset;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+PackedNode::image_bytes() const
+{
+    if(m_image == NULL)
+    {
+        return 0;
+    }
+    return (index_t)(m_header.data_offset + m_header.data_bytes);
+}
+
+//---------------------------------------------------------------------------//
+bool
+PackedNode::verify_checksum() const
+{
+    if(!has_checksum())
+    {
+        return true;
+    }
+    return checksum(data_ptr(),data_bytes()) == m_header.checksum;
+}
+
+//-----------------------------------------------------------------------------
+//
+// -- Data access --
+//
+//-----------------------------------------------------------------------------
+
+//---------------------------------------------------------------------------//
+FlatNodeView
+PackedNode::view() const
+{
+    if(m_image == NULL)
+    {
+        CONDUIT_ERROR("PackedNode::view: no packed node is open");
+    }
+    return FlatNodeView(m_schema,data_ptr());
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::to_node(Node &dest) const
+{
+    Schema s;
+    m_schema.to_schema(s);
+    dest.set_data_using_schema(s,const_cast<void*>(data_ptr()));
+}
+
+//---------------------------------------------------------------------------//
+void
+PackedNode::to_node_external(Node &dest) const
+{
+    Schema s;
+    m_schema.to_schema(s);
+    dest.set_external(s,const_cast<void*>(data_ptr()));
+}
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,292 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_packed_node.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef CONDUIT_PACKED_NODE_HPP
+#define CONDUIT_PACKED_NODE_HPP
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <fstream>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_core.hpp"
+#include "conduit_flat_schema.hpp"
+#include "conduit_node.hpp"
+#include "conduit_node_view.hpp"
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::PackedNode --
+//-----------------------------------------------------------------------------
+///
+/// class: conduit::PackedNode
+///
+/// description:
+///  Reads and writes packed nodes: self-describing binary images of a 
+///  Node that hold both the schema and the data in a single buffer.
+///
+///  A packed image has three parts:
+///   header: a fixed 64 byte header (magic, version, flags, the 
+///           location and size of the other parts, and an optional 
+///           checksum of the data)
+///   schema: the compact schema of the node, as a serialized FlatSchema
+///   data:   the compact data of the node, starting at a 64 byte 
+///           aligned offset
+///
+///  A PackedNode opens an image in place: the schema block is decoded
+///  into a FlatSchema (which only copies the schema metadata), and the
+///  data is accessed where it is, via FlatNodeViews. No Nodes are created
+///  unless requested with to_node() or to_node_external(), so opening an
+///  image held in a std::vector, a memory map, or a message buffer is 
+///  cheap, and untouched subtrees cost nothing.
+///
+///  The image (and the memory holding it) must outlive the PackedNode 
+///  and any views or external nodes created from it. Images use the 
+///  byte order of the machine that wrote them.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_API PackedNode
+{
+public:
+//-----------------------------------------------------------------------------
+/// Packed image header
+//-----------------------------------------------------------------------------
+    struct Header
+    {
+        char   magic[8];
+        int32  version;
+        int16  flags;
+        int16  endianness;
+        int64  schema_offset;
+        int64  schema_bytes;
+        int64  data_offset;
+        int64  data_bytes;
+        uint64 checksum;
+        int64  reserved;
+    };
+
+    /// Header flags
+    static const int16 CHECKSUM = 1;
+
+    /// alignment of the data block (relative to the start of the image)
+    static const index_t DATA_ALIGNMENT = 64;
+
+//-----------------------------------------------------------------------------
+/// Writing packed images
+//-----------------------------------------------------------------------------
+    /// number of bytes needed to pack node
+    static index_t  packed_size(const Node &node);
+
+    /// pack node into buffer (buffer is resized to the packed size)
+    static void     pack(const Node &node,
+                         std::vector<uint8> &buffer,
+                         bool checksum = false);
+
+    /// pack node into a caller provided buffer, returns the number of
+    /// bytes written. An error is thrown if capacity is too small.
+    static index_t  pack(const Node &node,
+                         void *buffer,
+                         index_t capacity,
+                         bool checksum = false);
+
+    /// true if data starts with a packed image header
+    static bool     is_packed(const void *data,
+                              index_t data_size);
+
+    /// checksum used for packed data (64-bit FNV-1a)
+    static uint64   checksum(const void *data,
+                             index_t data_size);
+    /// checksum of the compact data of node (strided leaves are read in
+    /// place, node is not compacted)
+    static uint64   checksum(const Node &node);
+
+//-----------------------------------------------------------------------------
+/// Packed files 
+///
+/// A packed file holds a single packed image, so unlike the two file 
+/// "conduit_bin" protocol (data + "_json" schema file), the schema and
+/// data are written with one file create and cannot get out of sync.
+/// Node::save(), Node::load() and Node::mmap() use these for the 
+/// "conduit_packed" protocol, and Node::load() with "conduit_bin" uses
+/// load_if_packed() to also read packed files.
+//-----------------------------------------------------------------------------
+    /// write node to a packed file. The data is written directly from 
+    /// the node's leaves (see Node::serialize()), it is not compacted 
+    /// into a temporary node first.
+    static void     save(const Node &node,
+                         const std::string &path,
+                         bool checksum = false);
+
+    /// read a packed file into dest. If the file has a checksum, it is
+    /// verified and an error is thrown on a mismatch.
+    static void     load(const std::string &path,
+                         Node &dest);
+
+    /// like load(), but if dest already owns a buffer with the file's 
+    /// layout (e.g. from a prior load of a same shaped file), the data 
+    /// is read into it in place instead of reallocating.
+    static void     load_into(const std::string &path,
+                              Node &dest);
+
+    /// reads the file open in ifs into dest, like load() (or load_into()
+    /// when reuse is true), if it starts with a packed image header.
+    /// Otherwise returns false and leaves ifs rewound, so callers can
+    /// check for and read a packed file with a single open.
+    static bool     load_if_packed(std::ifstream &ifs,
+                                   const std::string &path,
+                                   Node &dest,
+                                   bool reuse = false);
+
+    /// memory map a packed file into dest
+    static void     mmap(const std::string &path,
+                         Node &dest);
+
+    /// true if the file at path starts with a packed image header
+    static bool     is_packed_file(const std::string &path);
+
+//-----------------------------------------------------------------------------
+/// Construction and opening images
+//-----------------------------------------------------------------------------
+    /// creates an empty packed node
+    PackedNode();
+    /// opens the packed image in data
+    PackedNode(const void *data,
+               index_t data_size);
+    
+    /// opens the packed image in data, throws an error if data does not
+    /// hold a valid image
+    void                open(const void *data,
+                             index_t data_size);
+    /// forget the current image
+    void                close();
+    bool                is_open() const
+                            { return m_image != NULL; }
+
+//-----------------------------------------------------------------------------
+/// Image access
+//-----------------------------------------------------------------------------
+    const Header       &header() const
+                            { return m_header; }
+    const FlatSchema   &flat_schema() const
+                            { return m_schema; }
+    /// start of the data block
+    const void         *data_ptr() const;
+    index_t             data_bytes() const
+                            { return (index_t)m_header.data_bytes; }
+    /// total size of the image
+    index_t             image_bytes() const;
+
+    bool                has_checksum() const
+                            { return (m_header.flags & CHECKSUM) != 0; }
+    /// true if the image has no checksum, or the data matches it
+    bool                verify_checksum() const;
+
+//-----------------------------------------------------------------------------
+/// Data access
+//-----------------------------------------------------------------------------
+    /// view of the root of the packed node
+    FlatNodeView        view() const;
+    /// view of a path in the packed node
+    FlatNodeView        fetch(const std::string &path) const
+                            { return view().fetch(path); }
+    bool                has_path(const std::string &path) const
+                            { return view().has_path(path); }
+
+    /// copies the packed node into dest
+    void                to_node(Node &dest) const;
+    /// points dest to the packed data (no copy)
+    void                to_node_external(Node &dest) const;
+
+private:
+    // checks a header, against the size of the image holding it
+    static void         check_header(const Header &h,
+                                     index_t image_size,
+                                     const std::string &source);
+    // checks that the flat schema's leaves are inside the data block
+    static void         check_data_span(const Header &h,
+                                        const FlatSchema &flat_schema,
+                                        const std::string &source);
+    // opens a packed file for reading
+    static void         open_file(std::ifstream &ifs,
+                                  const std::string &path);
+    // reads and checks the header and flat schema of an open packed file
+    static void         read_file_schema(std::ifstream &ifs,
+                                         const std::string &path,
+                                         Header &h,
+                                         FlatSchema &flat_schema);
+    // shared impl of load(), load_into() and load_if_packed()
+    static void         read_file(std::ifstream &ifs,
+                                  const std::string &path,
+                                  Node &dest,
+                                  bool reuse);
+
+    Header       m_header;
+    FlatSchema   m_schema;
+    const uint8 *m_image;
+};
+//-----------------------------------------------------------------------------
+// -- end conduit::PackedNode --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
+
+#endif
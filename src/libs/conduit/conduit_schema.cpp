@@ -914,12 +914,12 @@ Schema::path() const
         oss << parent_path << "/";
 
     // if this schema has a parent, its parent is either an object or list
-    if(p->dtype().is_object())
+    if(p->m_dtype.is_object())
     {
         // use name
         oss << p->child_name(idx);
     }
-    else if(p->dtype().is_list())
+    else if(p->m_dtype.is_list())
     {
         // use order in the list
         oss << "[" << idx << "]";
@@ -1069,7 +1069,7 @@ Schema::init_defaults()
 void
 Schema::init_object()
 {
-    if(dtype().id() != DataType::OBJECT_ID)
+    if(m_dtype.id() != DataType::OBJECT_ID)
     {
         reset();
         m_dtype  = DataType::object();
@@ -1081,7 +1081,7 @@ Schema::init_object()
 void
 Schema::init_list()
 {
-    if(dtype().id() != DataType::LIST_ID)
+    if(m_dtype.id() != DataType::LIST_ID)
     {
         reset();
         m_dtype  = DataType::list();
@@ -1094,8 +1094,8 @@ Schema::init_list()
 void
 Schema::release()
 {
-    if(dtype().id() == DataType::OBJECT_ID ||
-       dtype().id() == DataType::LIST_ID)
+    if(m_dtype.id() == DataType::OBJECT_ID ||
+       m_dtype.id() == DataType::LIST_ID)
     {
         std::vector<Schema*> &chld = children();
         for(size_t i=0; i< chld.size(); i++)
@@ -1104,11 +1104,11 @@ Schema::release()
         }
     }
     
-    if(dtype().id() == DataType::OBJECT_ID)
+    if(m_dtype.id() == DataType::OBJECT_ID)
     { 
         delete object_hierarchy();
     }
-    else if(dtype().id() == DataType::LIST_ID)
+    else if(m_dtype.id() == DataType::LIST_ID)
     { 
         delete list_hierarchy();
     }
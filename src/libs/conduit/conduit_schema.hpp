@@ -92,6 +92,7 @@ public:
     friend class Node;
     friend class NodeIterator;
     friend class NodeConstIterator;
+    friend class FlatSchema;
 
 //----------------------------------------------------------------------------
 //
@@ -0,0 +1,311 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: conduit_type_traits.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef CONDUIT_TYPE_TRAITS_HPP
+#define CONDUIT_TYPE_TRAITS_HPP
+
+//-----------------------------------------------------------------------------
+// -- standard lib includes -- 
+//-----------------------------------------------------------------------------
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+// -- conduit includes -- 
+//-----------------------------------------------------------------------------
+#include "conduit_core.hpp"
+#include "conduit_endianness.hpp"
+#include "conduit_data_type.hpp"
+#include "conduit_schema.hpp"
+
+
+//-----------------------------------------------------------------------------
+// -- begin conduit:: --
+//-----------------------------------------------------------------------------
+namespace conduit
+{
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::DataTypeTraits --
+//-----------------------------------------------------------------------------
+///
+/// struct: conduit::DataTypeTraits<T>
+///
+/// description:
+///  Maps a C++ leaf type to its conduit DataType at compile time. 
+///  Specializations exist for the bitwidth style types (and any c-native
+///  types that are not aliased to them). Using an unsupported type is a
+///  compile error, since the primary template is never defined.
+///
+///  Each specialization provides:
+///   value_type: the C++ type
+///   id:         the conduit DataType id
+///   dtype(...): a DataType for a leaf of this type, with the same 
+///               arguments as the DataType leaf constructor helpers
+///
+///  These traits back the templated Node accessors 
+///  (Node::as<T>(), Node::as_array<T>(), Node::set<T>(...)) and the
+///  compile-time struct schemas described below.
+///
+//-----------------------------------------------------------------------------
+template<typename T>
+struct DataTypeTraits;
+
+//-----------------------------------------------------------------------------
+#define CONDUIT_DATA_TYPE_TRAITS( T, TYPE_ID, DTYPE_FACTORY )                  \
+template<>                                                                    \
+struct DataTypeTraits< T >                                                    \
+{                                                                             \
+    typedef T value_type;                                                     \
+    enum { id = TYPE_ID };                                                    \
+                                                                              \
+    static DataType dtype(index_t num_elements = 1,                           \
+                          index_t offset = 0,                                 \
+                          index_t stride = sizeof( T ),                       \
+                          index_t element_bytes = sizeof( T ),                \
+                          index_t endianness = Endianness::DEFAULT_ID)        \
+    {                                                                         \
+        return DataType::DTYPE_FACTORY(num_elements,                          \
+                                       offset,                                \
+                                       stride,                                \
+                                       element_bytes,                         \
+                                       endianness);                           \
+    }                                                                         \
+};                                                                            \
+
+//-----------------------------------------------------------------------------
+// bitwidth style types
+//-----------------------------------------------------------------------------
+CONDUIT_DATA_TYPE_TRAITS(int8,    DataType::INT8_ID,    int8)
+CONDUIT_DATA_TYPE_TRAITS(int16,   DataType::INT16_ID,   int16)
+CONDUIT_DATA_TYPE_TRAITS(int32,   DataType::INT32_ID,   int32)
+CONDUIT_DATA_TYPE_TRAITS(int64,   DataType::INT64_ID,   int64)
+
+CONDUIT_DATA_TYPE_TRAITS(uint8,   DataType::UINT8_ID,   uint8)
+CONDUIT_DATA_TYPE_TRAITS(uint16,  DataType::UINT16_ID,  uint16)
+CONDUIT_DATA_TYPE_TRAITS(uint32,  DataType::UINT32_ID,  uint32)
+CONDUIT_DATA_TYPE_TRAITS(uint64,  DataType::UINT64_ID,  uint64)
+
+CONDUIT_DATA_TYPE_TRAITS(float32, DataType::FLOAT32_ID, float32)
+CONDUIT_DATA_TYPE_TRAITS(float64, DataType::FLOAT64_ID, float64)
+
+//-----------------------------------------------------------------------------
+// gap traits for c-native types
+//-----------------------------------------------------------------------------
+#ifndef CONDUIT_USE_CHAR
+CONDUIT_DATA_TYPE_TRAITS(char,
+                         CONDUIT_NATIVE_CHAR_ID,
+                         c_char)
+CONDUIT_DATA_TYPE_TRAITS(unsigned char,
+                         CONDUIT_NATIVE_UNSIGNED_CHAR_ID,
+                         c_unsigned_char)
+#endif
+
+#ifndef CONDUIT_USE_SHORT
+CONDUIT_DATA_TYPE_TRAITS(short,
+                         CONDUIT_NATIVE_SHORT_ID,
+                         c_short)
+CONDUIT_DATA_TYPE_TRAITS(unsigned short,
+                         CONDUIT_NATIVE_UNSIGNED_SHORT_ID,
+                         c_unsigned_short)
+#endif
+
+#ifndef CONDUIT_USE_INT
+CONDUIT_DATA_TYPE_TRAITS(int,
+                         CONDUIT_NATIVE_INT_ID,
+                         c_int)
+CONDUIT_DATA_TYPE_TRAITS(unsigned int,
+                         CONDUIT_NATIVE_UNSIGNED_INT_ID,
+                         c_unsigned_int)
+#endif
+
+#ifndef CONDUIT_USE_LONG
+CONDUIT_DATA_TYPE_TRAITS(long,
+                         CONDUIT_NATIVE_LONG_ID,
+                         c_long)
+CONDUIT_DATA_TYPE_TRAITS(unsigned long,
+                         CONDUIT_NATIVE_UNSIGNED_LONG_ID,
+                         c_unsigned_long)
+#endif
+
+#ifndef CONDUIT_USE_FLOAT
+CONDUIT_DATA_TYPE_TRAITS(float,
+                         CONDUIT_NATIVE_FLOAT_ID,
+                         c_float)
+#endif
+
+#ifndef CONDUIT_USE_DOUBLE
+CONDUIT_DATA_TYPE_TRAITS(double,
+                         CONDUIT_NATIVE_DOUBLE_ID,
+                         c_double)
+#endif
+
+#undef CONDUIT_DATA_TYPE_TRAITS
+
+//-----------------------------------------------------------------------------
+// -- end conduit::DataTypeTraits --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin conduit::StructTraits --
+//-----------------------------------------------------------------------------
+///
+/// struct: conduit::StructTraits<S>
+///
+/// description:
+///  Describes the layout of a plain C++ struct, so it can be used with 
+///  conduit without hand written schemas. Specializations are created 
+///  with the CONDUIT_STRUCT_SCHEMA macros, which must be used at global
+///  scope:
+///
+///    struct Particle { float64 x; float64 y; int32 id; };
+///
+///    CONDUIT_STRUCT_SCHEMA_BEGIN(Particle)
+///        CONDUIT_STRUCT_SCHEMA_FIELD(x)
+///        CONDUIT_STRUCT_SCHEMA_FIELD(y)
+///        CONDUIT_STRUCT_SCHEMA_FIELD(id)
+///    CONDUIT_STRUCT_SCHEMA_END()
+///
+///  Field types are deduced from the member pointers and field offsets
+///  come from offsetof(), so both are fixed at compile time. Fields that
+///  are themselves described structs are added with 
+///  CONDUIT_STRUCT_SCHEMA_NESTED(field).
+///
+///  StructTraits<S>::schema(s, num_structs, offset, stride) fills s with an 
+///  object schema for num_structs consecutive structs (an array of 
+///  structs), each field becomes a leaf with num_structs elements strided
+///  by sizeof(S). This schema can be used directly with 
+///  Node::set_external() to describe user AoS data without copies, 
+///  see also Node::set_external_struct<S>().
+///
+//-----------------------------------------------------------------------------
+template<typename S>
+struct StructTraits;
+
+//-----------------------------------------------------------------------------
+/// helper used by CONDUIT_STRUCT_SCHEMA_FIELD, deduces the field type 
+/// from a member pointer
+//-----------------------------------------------------------------------------
+template<typename S, typename F>
+inline DataType
+struct_field_dtype(F S::*, 
+                   index_t num_structs,
+                   index_t offset,
+                   index_t stride)
+{
+    return DataTypeTraits<F>::dtype(num_structs,
+                                    offset,
+                                    stride);
+}
+
+//-----------------------------------------------------------------------------
+/// helper used by CONDUIT_STRUCT_SCHEMA_NESTED, deduces the nested struct 
+/// type from a member pointer
+//-----------------------------------------------------------------------------
+template<typename S, typename F>
+inline void
+struct_nested_schema(F S::*,
+                     Schema &schema,
+                     index_t num_structs,
+                     index_t offset,
+                     index_t stride)
+{
+    StructTraits<F>::schema(schema,
+                            num_structs,
+                            offset,
+                            stride);
+}
+
+//-----------------------------------------------------------------------------
+#define CONDUIT_STRUCT_SCHEMA_BEGIN( STRUCT_TYPE )                             \
+namespace conduit                                                             \
+{                                                                             \
+template<>                                                                    \
+struct StructTraits< STRUCT_TYPE >                                            \
+{                                                                             \
+    typedef STRUCT_TYPE struct_type;                                          \
+                                                                              \
+    static void schema(conduit::Schema &s,                                    \
+                       conduit::index_t num_structs = 1,                      \
+                       conduit::index_t offset = 0,                           \
+                       conduit::index_t stride = sizeof( STRUCT_TYPE ))       \
+    {                                                                         \
+        s.set(conduit::DataType::object());                                   \
+
+//-----------------------------------------------------------------------------
+#define CONDUIT_STRUCT_SCHEMA_FIELD( FIELD )                                   \
+        s[#FIELD].set(conduit::struct_field_dtype(&struct_type::FIELD,        \
+                                          num_structs,                        \
+                                          offset +                            \
+                                            offsetof(struct_type, FIELD),     \
+                                          stride));                           \
+
+//-----------------------------------------------------------------------------
+#define CONDUIT_STRUCT_SCHEMA_NESTED( FIELD )                                  \
+        conduit::struct_nested_schema(&struct_type::FIELD,                    \
+                                      s[#FIELD],                              \
+                                      num_structs,                            \
+                                      offset + offsetof(struct_type, FIELD),  \
+                                      stride);                                \
+
+//-----------------------------------------------------------------------------
+#define CONDUIT_STRUCT_SCHEMA_END()                                            \
+    }                                                                         \
+};                                                                            \
+}                                                                             \
+
+//-----------------------------------------------------------------------------
+// -- end conduit::StructTraits --
+//-----------------------------------------------------------------------------
+
+}
+//-----------------------------------------------------------------------------
+// -- end conduit:: --
+//-----------------------------------------------------------------------------
+
+#endif
@@ -53,13 +53,25 @@
 //-----------------------------------------------------------------------------
 // standard lib includes
 //-----------------------------------------------------------------------------
+#include <algorithm>
 #include <iostream>
+#include <list>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // external lib includes
 //-----------------------------------------------------------------------------
 #include <hdf5.h>
 
+// the async writer uses pthreads, when available
+#if !defined(CONDUIT_PLATFORM_WINDOWS)
+#include <pthread.h>
+#define CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS
+#endif
+
 //-----------------------------------------------------------------------------
 /// macro used to check if an HDF5 object id is valid
 //-----------------------------------------------------------------------------
@@ -127,28 +139,83 @@ namespace io
 //-----------------------------------------------------------------------------
 // Private class used to hold options that control hdf5 i/o params.
 // 
-// These values are read by about(), and are set by io::hdf5_set_options()
-// 
+// The process wide defaults are read by about(), and are set by 
+// io::hdf5_set_options(). Each write copies the defaults and applies 
+// the options passed for it once, subtrees with overrides resolve their 
+// own copy from their parent's.
 //
 //-----------------------------------------------------------------------------
 
 class HDF5Options
 {
 public:
-    static bool chunking_enabled;
-    static int  chunk_threshold;
-    static int  chunk_size;
+    bool chunking_enabled;
+    int  chunk_threshold;
+    int  chunk_size;
+
+    bool compact_storage_enabled;
+    int  compact_storage_threshold;
+
+    std::string compression_method;
+    int         compression_level;
 
-    static bool compact_storage_enabled;
-    static int  compact_storage_threshold;
+    int         file_cache_max_open_files;
+    std::string file_cache_flush;
 
-    static std::string compression_method;
-    static int         compression_level;
+    std::string small_leaves_mode;
+    int         small_leaves_threshold;
+
+    // file level settings, sizes of 0 keep the hdf5 library defaults
+    std::string file_libver_low;
+    std::string file_libver_high;
+    index_t     file_page_size;
+    index_t     file_page_buffer_size;
+    index_t     file_meta_block_size;
+    index_t     file_small_data_block_size;
+    index_t     file_sieve_buf_size;
+    index_t     file_chunk_cache_size;
+    index_t     file_chunk_cache_nslots;
 
 public:
+
+    //------------------------------------------------------------------------
+    // built-in hdf5 i/o settings
+    //------------------------------------------------------------------------
+    HDF5Options()
+    : chunking_enabled(true),
+      chunk_threshold(2000000), // 2 mb
+      chunk_size(1000000),      // 1 mb
+      compact_storage_enabled(true),
+      compact_storage_threshold(1024),
+      compression_method("gzip"),
+      compression_level(5),
+      file_cache_max_open_files(0), // disabled
+      file_cache_flush("write"),
+      small_leaves_mode("datasets"),
+      small_leaves_threshold(256),
+      file_libver_low("latest"),
+      file_libver_high("latest"),
+      file_page_size(0),       // no paging
+      file_page_buffer_size(0),
+      file_meta_block_size(0),
+      file_small_data_block_size(0),
+      file_sieve_buf_size(0),
+      file_chunk_cache_size(0),
+      file_chunk_cache_nslots(0)
+    {}
+
+    //------------------------------------------------------------------------
+    // process wide defaults, changed via hdf5_set_options() and used as
+    // the starting point for the options passed to each write
+    //------------------------------------------------------------------------
+    static HDF5Options &defaults()
+    {
+        static HDF5Options defaults_opts;
+        return defaults_opts;
+    }
     
     //------------------------------------------------------------------------
-    static void set(const Node &opts)
+    void set(const Node &opts)
     {
         
         if(opts.has_child("compact_storage"))
@@ -216,10 +283,159 @@ public:
                 }
             }
         }
+
+        if(opts.has_child("file_cache"))
+        {
+            const Node &file_cache = opts["file_cache"];
+
+            if(file_cache.has_child("max_open_files"))
+            {
+                file_cache_max_open_files = 
+                                    file_cache["max_open_files"].to_value();
+            }
+
+            if(file_cache.has_child("flush"))
+            {
+                std::string flush = file_cache["flush"].as_string();
+
+                if(flush != "write" && flush != "close")
+                {
+                    CONDUIT_ERROR("Unsupported HDF5 file_cache/flush policy: "
+                                  << "\"" << flush << "\""
+                                  << " (expected \"write\" or \"close\")");
+                }
+
+                file_cache_flush = flush;
+            }
+        }
+
+        if(opts.has_child("small_leaves"))
+        {
+            const Node &small_leaves = opts["small_leaves"];
+
+            if(small_leaves.has_child("mode"))
+            {
+                std::string mode = small_leaves["mode"].as_string();
+
+                if(mode != "datasets" && mode != "attributes")
+                {
+                    CONDUIT_ERROR("Unsupported HDF5 small_leaves/mode: "
+                                  << "\"" << mode << "\""
+                                  << " (expected \"datasets\" or "
+                                  << "\"attributes\")");
+                }
+
+                small_leaves_mode = mode;
+            }
+
+            if(small_leaves.has_child("threshold"))
+            {
+                small_leaves_threshold = small_leaves["threshold"].to_value();
+            }
+        }
+
+        if(opts.has_child("file"))
+        {
+            const Node &file = opts["file"];
+
+            std::string libver_low  = file_libver_low;
+            std::string libver_high = file_libver_high;
+
+            if(file.has_path("libver/low"))
+            {
+                libver_low = file["libver/low"].as_string();
+            }
+
+            if(file.has_path("libver/high"))
+            {
+                libver_high = file["libver/high"].as_string();
+            }
+
+            if(hdf5_libver_from_name(libver_high) == H5F_LIBVER_EARLIEST ||
+               hdf5_libver_from_name(libver_low) > 
+               hdf5_libver_from_name(libver_high))
+            {
+                CONDUIT_ERROR("Unsupported HDF5 file/libver bounds: "
+                              << "low: \"" << libver_low << "\" "
+                              << "high: \"" << libver_high << "\"");
+            }
+
+            file_libver_low  = libver_low;
+            file_libver_high = libver_high;
+
+            set_size(file,"page_size",file_page_size);
+            set_size(file,"page_buffer_size",file_page_buffer_size);
+            set_size(file,"meta_block_size",file_meta_block_size);
+            set_size(file,"small_data_block_size",file_small_data_block_size);
+            set_size(file,"sieve_buf_size",file_sieve_buf_size);
+            set_size(file,"chunk_cache/size",file_chunk_cache_size);
+            set_size(file,"chunk_cache/nslots",file_chunk_cache_nslots);
+
+#if !H5_VERSION_GE(1,10,1)
+            if(file_page_size > 0 || file_page_buffer_size > 0)
+            {
+                CONDUIT_ERROR("HDF5 file space paging requires HDF5 1.10.1"
+                              " or newer");
+            }
+#endif
+        }
+    }
+
+    //------------------------------------------------------------------------
+    static void set_size(const Node &opts,
+                         const std::string &name,
+                         index_t &value)
+    {
+        if(opts.has_path(name))
+        {
+            index_t size = opts[name].to_index_t();
+            if(size < 0)
+            {
+                CONDUIT_ERROR("HDF5 option file/" << name 
+                              << " must be >= 0 (given: " << size << ")");
+            }
+            value = size;
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // maps the libver option names to hdf5's format versions
+    //------------------------------------------------------------------------
+    static H5F_libver_t hdf5_libver_from_name(const std::string &name)
+    {
+        if(name == "earliest")
+        {
+            return H5F_LIBVER_EARLIEST;
+        }
+#if H5_VERSION_GE(1,10,2)
+        else if(name == "v18")
+        {
+            return H5F_LIBVER_V18;
+        }
+        else if(name == "v110")
+        {
+            return H5F_LIBVER_V110;
+        }
+#endif
+        else if(name == "latest")
+        {
+            return H5F_LIBVER_LATEST;
+        }
+
+        CONDUIT_ERROR("Unsupported HDF5 file/libver value: "
+                      << "\"" << name << "\""
+#if H5_VERSION_GE(1,10,2)
+                      << " (expected \"earliest\", \"v18\", \"v110\""
+#else
+                      << " (expected \"earliest\""
+#endif
+                      << " or \"latest\")");
+
+        return H5F_LIBVER_LATEST;
     }
 
     //------------------------------------------------------------------------
-    static void about(Node &opts)
+    void about(Node &opts) const
     {
         opts.reset();
 
@@ -251,34 +467,269 @@ public:
         {
             opts["chunking/compression/level"] = compression_level;
         }
+
+        opts["file_cache/max_open_files"] = file_cache_max_open_files;
+        opts["file_cache/flush"] = file_cache_flush;
+
+        opts["small_leaves/mode"] = small_leaves_mode;
+        opts["small_leaves/threshold"] = small_leaves_threshold;
+
+        opts["file/libver/low"]  = file_libver_low;
+        opts["file/libver/high"] = file_libver_high;
+        opts["file/page_size"]             = file_page_size;
+        opts["file/page_buffer_size"]      = file_page_buffer_size;
+        opts["file/meta_block_size"]       = file_meta_block_size;
+        opts["file/small_data_block_size"] = file_small_data_block_size;
+        opts["file/sieve_buf_size"]        = file_sieve_buf_size;
+        opts["file/chunk_cache/size"]      = file_chunk_cache_size;
+        opts["file/chunk_cache/nslots"]    = file_chunk_cache_nslots;
     }
 };
 
-// default hdf5 i/o settings
 
-bool HDF5Options::compact_storage_enabled   = true;
-int  HDF5Options::compact_storage_threshold = 1024;
+//-----------------------------------------------------------------------------
+// Private class used to keep hdf5 files open across calls that use 
+// file system paths.
+//
+// The cache is enabled when file_cache/max_open_files > 0. Files are 
+// keyed by the path used to open them, and the least recently used
+// file is closed when the limit is reached. With the "write" flush 
+// policy, files are flushed after each write so the data on disk is 
+// complete while the file stays open.
+//-----------------------------------------------------------------------------
+class HDF5FileCache
+{
+public:
+
+    //------------------------------------------------------------------------
+    static HDF5FileCache &instance()
+    {
+        static HDF5FileCache cache;
+        return cache;
+    }
+
+    //------------------------------------------------------------------------
+    hid_t open_for_read(const std::string &file_path)
+    {
+        if(enabled())
+        {
+            std::map<std::string,Entry>::iterator itr = m_files.find(file_path);
+            if(itr != m_files.end())
+            {
+                touch(itr);
+                return itr->second.id;
+            }
+        }
+
+        hid_t h5_file_id = hdf5_open_file_for_read(file_path);
+        add(file_path,h5_file_id,false);
+        return h5_file_id;
+    }
+
+    //------------------------------------------------------------------------
+    // truncate: true to create (or truncate) the file, false to 
+    // open an existing file (a missing file is created)
+    // reuse_writable: true to use a cached writable handle even when
+    //  truncate is true (used for writes to subtrees of a file)
+    //------------------------------------------------------------------------
+    hid_t open_for_write(const std::string &file_path,
+                         bool truncate,
+                         bool reuse_writable)
+    {
+        if(enabled())
+        {
+            std::map<std::string,Entry>::iterator itr = m_files.find(file_path);
+            if(itr != m_files.end())
+            {
+                if( (!truncate || reuse_writable) && itr->second.writable)
+                {
+                    touch(itr);
+                    return itr->second.id;
+                }
+                // we can't truncate or upgrade an open file, reopen it
+                close(itr);
+            }
+        }
+
+        hid_t h5_file_id = -1;
+
+        if(!truncate && utils::is_file(file_path))
+        {
+            h5_file_id = hdf5_open_file_for_read_write(file_path);
+        }
+        else
+        {
+            h5_file_id = hdf5_create_file(file_path);
+        }
+
+        add(file_path,h5_file_id,true);
+        return h5_file_id;
+    }
+
+    //------------------------------------------------------------------------
+    // called when a read or write is done with a file, 
+    // closes it unless it is cached
+    //------------------------------------------------------------------------
+    void release(const std::string &file_path,
+                 hid_t h5_file_id,
+                 bool wrote)
+    {
+        std::map<std::string,Entry>::iterator itr = m_files.find(file_path);
+        if(itr != m_files.end() && itr->second.id == h5_file_id)
+        {
+            if(wrote && HDF5Options::defaults().file_cache_flush == "write")
+            {
+                CONDUIT_CHECK_HDF5_ERROR(H5Fflush(h5_file_id,H5F_SCOPE_LOCAL),
+                                         "Error flushing HDF5 file: " 
+                                         << file_path);
+            }
+        }
+        else
+        {
+            CONDUIT_CHECK_HDF5_ERROR(H5Fclose(h5_file_id),
+                                     "Error closing HDF5 file: " 
+                                     << file_path);
+        }
+    }
+
+    //------------------------------------------------------------------------
+    void flush_all()
+    {
+        std::map<std::string,Entry>::iterator itr;
+        for(itr = m_files.begin(); itr != m_files.end(); itr++)
+        {
+            if(itr->second.writable)
+            {
+                CONDUIT_CHECK_HDF5_ERROR(H5Fflush(itr->second.id,
+                                                  H5F_SCOPE_LOCAL),
+                                         "Error flushing HDF5 file: " 
+                                         << itr->first);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------
+    void close_all()
+    {
+        while(!m_files.empty())
+        {
+            close(m_files.begin());
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // closes least recently used files until we are within the limit
+    //------------------------------------------------------------------------
+    void trim(size_t max_open_files)
+    {
+        while(m_files.size() > max_open_files)
+        {
+            close(m_files.find(m_lru.back()));
+        }
+    }
+
+    //------------------------------------------------------------------------
+    index_t number_of_open_files() const
+    {
+        return (index_t) m_files.size();
+    }
+
+private:
+    struct Entry
+    {
+        hid_t                             id;
+        bool                              writable;
+        std::list<std::string>::iterator  lru_itr;
+    };
+
+    //------------------------------------------------------------------------
+    bool enabled() const
+    {
+        return HDF5Options::defaults().file_cache_max_open_files > 0;
+    }
+
+    //------------------------------------------------------------------------
+    void add(const std::string &file_path,
+             hid_t h5_file_id,
+             bool writable)
+    {
+        if(!enabled())
+        {
+            return;
+        }
+
+        int max_open_files = HDF5Options::defaults().file_cache_max_open_files;
+        trim(max_open_files - 1);
+
+        m_lru.push_front(file_path);
+
+        Entry &entry   = m_files[file_path];
+        entry.id       = h5_file_id;
+        entry.writable = writable;
+        entry.lru_itr  = m_lru.begin();
+    }
+
+    //------------------------------------------------------------------------
+    void touch(std::map<std::string,Entry>::iterator itr)
+    {
+        m_lru.splice(m_lru.begin(),m_lru,itr->second.lru_itr);
+    }
+
+    //------------------------------------------------------------------------
+    void close(std::map<std::string,Entry>::iterator itr)
+    {
+        hid_t h5_file_id = itr->second.id;
+        std::string file_path = itr->first;
 
-bool        HDF5Options::chunking_enabled   = true;
-int         HDF5Options::chunk_size         = 1000000; // 1 mb 
-int         HDF5Options::chunk_threshold    = 2000000; // 2 mb
+        m_lru.erase(itr->second.lru_itr);
+        m_files.erase(itr);
 
-std::string HDF5Options::compression_method = "gzip";
-int         HDF5Options::compression_level  = 5;
+        CONDUIT_CHECK_HDF5_ERROR(H5Fclose(h5_file_id),
+                                 "Error closing HDF5 file: " << file_path);
+    }
 
+    std::map<std::string,Entry>  m_files;
+    // most recently used files are at the front
+    std::list<std::string>       m_lru;
+};
 
 //-----------------------------------------------------------------------------
 void
 hdf5_set_options(const Node &opts)
 {
-    HDF5Options::set(opts);
+    HDF5Options::defaults().set(opts);
+
+    // apply a lower open file limit right away
+    int max_open_files = HDF5Options::defaults().file_cache_max_open_files;
+    HDF5FileCache::instance().trim(max_open_files > 0 ? max_open_files : 0);
+}
+
+//-----------------------------------------------------------------------------
+void
+hdf5_flush_cached_files()
+{
+    HDF5FileCache::instance().flush_all();
+}
+
+//-----------------------------------------------------------------------------
+void
+hdf5_close_cached_files()
+{
+    HDF5FileCache::instance().close_all();
+}
+
+//-----------------------------------------------------------------------------
+index_t
+hdf5_number_of_cached_files()
+{
+    return HDF5FileCache::instance().number_of_open_files();
 }
 
 //-----------------------------------------------------------------------------
 void
 hdf5_options(Node &opts)
 {
-    HDF5Options::about(opts);
+    HDF5Options::defaults().about(opts);
 }
 
 //-----------------------------------------------------------------------------
@@ -348,16 +799,19 @@ private:
 //-----------------------------------------------------------------------------
 bool  check_if_conduit_leaf_is_compatible_with_hdf5_obj(const DataType &dtype,
                                                   const std::string &ref_path,
+                                                        const Node &opts,
                                                                 hid_t hdf5_id);
  
 //-----------------------------------------------------------------------------
 bool  check_if_conduit_object_is_compatible_with_hdf5_tree(const Node &node,
                                                 const std::string &ref_path,
+                                                      const Node &opts,
                                                              hid_t hdf5_id);
 
 //-----------------------------------------------------------------------------
 bool  check_if_conduit_node_is_compatible_with_hdf5_tree(const Node &node,
                                               const std::string &ref_path,
+                                                    const Node &opts,
                                                             hid_t hdf5_id);
 
 
@@ -368,23 +822,36 @@ bool  check_if_conduit_node_is_compatible_with_hdf5_tree(const Node &node,
 //-----------------------------------------------------------------------------
 hid_t create_hdf5_dataset_for_conduit_leaf(const DataType &dt,
                                            const std::string &ref_path,
+                                           const Node &opts,
+                                           const HDF5Options &h5_opts,
                                            hid_t hdf5_group_id,
                                            const std::string &hdf5_dset_name);
 
 //-----------------------------------------------------------------------------
 void  write_conduit_leaf_to_hdf5_dataset(const Node &node,
                                          const std::string &ref_path,
+                                         const Node &opts,
                                          hid_t hdf5_dset_id);
 
 //-----------------------------------------------------------------------------
 void  write_conduit_leaf_to_hdf5_group(const Node &node,
                                        const std::string &ref_path,
+                                       const Node &opts,
+                                       const HDF5Options &h5_opts,
                                        hid_t hdf5_group_id,
                                        const std::string &hdf5_dset_name);
 
+//-----------------------------------------------------------------------------
+void  write_conduit_leaf_to_hdf5_attribute(const Node &node,
+                                           const std::string &ref_path,
+                                           hid_t hdf5_group_id,
+                                           const std::string &hdf5_attr_name);
+
 //-----------------------------------------------------------------------------
 void  write_conduit_object_to_hdf5_group(const Node &node,
                                          const std::string &ref_path,
+                                         const Node &opts,
+                                         const HDF5Options &h5_opts,
                                          hid_t hdf5_group_id);
 
 
@@ -395,18 +862,70 @@ void  write_conduit_object_to_hdf5_group(const Node &node,
 //-----------------------------------------------------------------------------
 void read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
                                          const std::string &ref_path,
+                                         const Node &opts,
                                          Node &dest);
 
 //-----------------------------------------------------------------------------
+// (opts holds the options for the group's children, keyed by name)
 void read_hdf5_group_into_conduit_node(hid_t hdf5_group_id,
                                        const std::string &ref_path,
+                                       const Node &opts,
                                        Node &dest);
 
 //-----------------------------------------------------------------------------
 void read_hdf5_tree_into_conduit_node(hid_t hdf5_id,
                                       const std::string &ref_path,
+                                      const Node &opts,
                                       Node &dest);
 
+//-----------------------------------------------------------------------------
+// helpers for leaves stored as attributes of their parent group
+//-----------------------------------------------------------------------------
+void read_hdf5_attribute_into_conduit_node(hid_t hdf5_attr_id,
+                                           const std::string &ref_path,
+                                           Node &dest);
+
+//-----------------------------------------------------------------------------
+void read_hdf5_attribute_into_conduit_schema(hid_t hdf5_attr_id,
+                                             const std::string &ref_path,
+                                             Schema &dest);
+
+//-----------------------------------------------------------------------------
+bool read_hdf5_child_order(hid_t hdf5_group_id,
+                           const std::string &ref_path,
+                           std::vector<std::string> &child_names);
+
+//-----------------------------------------------------------------------------
+hid_t open_hdf5_attribute_leaf(hid_t hdf5_id,
+                               const std::string &hdf5_path);
+
+//-----------------------------------------------------------------------------
+// schema only variants, these read the hdf5 structure without any data
+//-----------------------------------------------------------------------------
+void read_hdf5_dataset_into_conduit_schema(hid_t hdf5_dset_id,
+                                           const std::string &ref_path,
+                                           Schema &dest);
+
+//-----------------------------------------------------------------------------
+void read_hdf5_group_into_conduit_schema(hid_t hdf5_group_id,
+                                         const std::string &ref_path,
+                                         Schema &dest);
+
+//-----------------------------------------------------------------------------
+void read_hdf5_tree_into_conduit_schema(hid_t hdf5_id,
+                                        const std::string &ref_path,
+                                        Schema &dest);
+
+//-----------------------------------------------------------------------------
+index_t select_hdf5_dataspace_slab(hid_t hdf5_dspace_id,
+                                   const Node &opts,
+                                   const std::string &ref_path);
+
+//-----------------------------------------------------------------------------
+hid_t create_hdf5_memory_dataspace_for_leaf(const DataType &dt,
+                                            index_t num_elements,
+                                            const std::string &ref_path);
+
 
 
 
@@ -654,35 +1173,220 @@ hdf5_dtype_to_conduit_dtype(hid_t hdf5_dtype_id,
 // Write Helpers
 //---------------------------------------------------------------------------//
 
+//---------------------------------------------------------------------------//
+// empty options node, used when writing or reading without options
+//---------------------------------------------------------------------------//
+const Node &
+hdf5_no_opts()
+{
+    static Node no_opts;
+    return no_opts;
+}
+
+//---------------------------------------------------------------------------//
+// true if the write options ask to append to existing datasets
 //---------------------------------------------------------------------------//
 bool
-check_if_conduit_leaf_is_compatible_with_hdf5_obj(const DataType &dtype,
-                                                  const std::string &ref_path,
-                                                  hid_t hdf5_id)
+hdf5_write_opts_append(const Node &opts)
 {
-    bool res = true;
-    H5O_info_t h5_obj_info;
+    return opts.has_child("append") &&
+           opts.fetch_child("append").as_string() == "true";
+}
 
-    herr_t h5_status = H5Oget_info(hdf5_id, &h5_obj_info);
-    
-    // make sure it is a dataset ...
-    if( CONDUIT_HDF5_STATUS_OK(h5_status) && 
-        ( h5_obj_info.type == H5O_TYPE_DATASET ) )
+//---------------------------------------------------------------------------//
+// returns the element offset to write at from the write options, 
+// -1 if no offset was given
+//---------------------------------------------------------------------------//
+index_t
+hdf5_write_opts_offset(const Node &opts,
+                       const std::string &ref_path)
+{
+    if(!opts.has_child("offset"))
     {
-        // get the hdf5 dataspace for the passed hdf5 obj
-        hid_t h5_test_dspace = H5Dget_space(hdf5_id);
-        // a dataset with H5S_NULL data space is only compatible with 
-        // conduit empty
-        if( H5Sget_simple_extent_type(h5_test_dspace) == H5S_NULL &&
-            !dtype.is_empty())
-        {
-            res = false;
-        }
-        else
-        {
-            // get the hdf5 datatype that matchs the conduit dtype
-            hid_t h5_dtype = conduit_dtype_to_hdf5_dtype(dtype,
-                                                         ref_path);
+        return -1;
+    }
+
+    index_t res = opts.fetch_child("offset").to_index_t();
+    if(res < 0)
+    {
+        CONDUIT_HDF5_ERROR(ref_path,
+                           "HDF5 write option \"offset\" must be >= 0");
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+// true if the write options select part of a dataset (append or offset),
+// instead of writing a whole dataset
+//---------------------------------------------------------------------------//
+bool
+hdf5_write_opts_partial(const Node &opts)
+{
+    return hdf5_write_opts_append(opts) || opts.has_child("offset");
+}
+
+//---------------------------------------------------------------------------//
+// true if the name is an option understood by HDF5Options, 
+// these names are reserved in per-subtree overrides
+//---------------------------------------------------------------------------//
+bool
+hdf5_write_opts_is_storage_option(const std::string &name)
+{
+    return name == "chunking" || 
+           name == "compact_storage" ||
+           name == "small_leaves";
+}
+
+//---------------------------------------------------------------------------//
+// name of the group attribute that records the order of a group's 
+// children when some of them are stored as attributes
+//---------------------------------------------------------------------------//
+const std::string &
+hdf5_child_order_attr_name()
+{
+    static const std::string attr_name("conduit_child_order");
+    return attr_name;
+}
+
+//---------------------------------------------------------------------------//
+// true if the leaf should be written as an attribute of its parent group:
+// small_leaves/mode is "attributes" and the leaf's compact size is at 
+// most small_leaves/threshold bytes. Appends and offset writes always
+// use datasets.
+//---------------------------------------------------------------------------//
+bool
+hdf5_write_opts_leaf_as_attribute(const Node &leaf,
+                                  const std::string &leaf_name,
+                                  const Node &opts,
+                                  const HDF5Options &h5_opts)
+{
+    if(hdf5_write_opts_partial(opts) ||
+       leaf_name == hdf5_child_order_attr_name())
+    {
+        return false;
+    }
+
+    return h5_opts.small_leaves_mode == "attributes" &&
+           leaf.dtype().bytes_compact() <= h5_opts.small_leaves_threshold;
+}
+
+//---------------------------------------------------------------------------//
+// returns the write options for the child of a group. 
+//
+// per-subtree overrides are given in opts["overrides"], keyed by path. 
+// when present, the child's options are built in child_opts: 
+// the inherited options, updated with any storage options given for the 
+// child, with the overrides below the child passed down.
+//---------------------------------------------------------------------------//
+const Node &
+hdf5_write_opts_for_child(const Node &opts,
+                          const std::string &child_name,
+                          Node &child_opts)
+{
+    if(!opts.has_child("overrides"))
+    {
+        return opts;
+    }
+
+    child_opts.reset();
+
+    NodeConstIterator itr = opts.children();
+    while(itr.has_next())
+    {
+        const Node &opt = itr.next();
+        if(itr.name() != "overrides")
+        {
+            child_opts[itr.name()].set(opt);
+        }
+    }
+
+    const Node &overrides = opts.fetch_child("overrides");
+
+    if(overrides.has_child(child_name))
+    {
+        const Node &child_overrides = overrides.fetch_child(child_name);
+
+        itr = child_overrides.children();
+        while(itr.has_next())
+        {
+            const Node &opt = itr.next();
+            std::string opt_name = itr.name();
+            if(hdf5_write_opts_is_storage_option(opt_name))
+            {
+                child_opts[opt_name].update(opt);
+            }
+            else
+            {
+                child_opts["overrides"][opt_name].set_external(
+                                                    const_cast<Node&>(opt));
+            }
+        }
+    }
+
+    return child_opts;
+}
+
+//---------------------------------------------------------------------------//
+// returns the write options for the child of a group, as above, along 
+// with the HDF5Options resolved from them. 
+//
+// children without their own options share the parent's opts and 
+// h5_opts. otherwise the child's HDF5Options are resolved once here, 
+// in child_h5_opts, and used for the whole subtree below the child.
+//---------------------------------------------------------------------------//
+const Node &
+hdf5_write_opts_for_child(const Node &opts,
+                          const HDF5Options &h5_opts,
+                          const std::string &child_name,
+                          Node &child_opts,
+                          HDF5Options &child_h5_opts,
+                          const HDF5Options *&child_h5_opts_ptr)
+{
+    const Node &res = hdf5_write_opts_for_child(opts,
+                                                child_name,
+                                                child_opts);
+    child_h5_opts_ptr = &h5_opts;
+
+    if(&res != &opts)
+    {
+        child_h5_opts = h5_opts;
+        child_h5_opts.set(res);
+        child_h5_opts_ptr = &child_h5_opts;
+    }
+
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+bool
+check_if_conduit_leaf_is_compatible_with_hdf5_obj(const DataType &dtype,
+                                                  const std::string &ref_path,
+                                                  const Node &opts,
+                                                  hid_t hdf5_id)
+{
+    bool res = true;
+    H5O_info_t h5_obj_info;
+
+    herr_t h5_status = H5Oget_info(hdf5_id, &h5_obj_info);
+    
+    // make sure it is a dataset ...
+    if( CONDUIT_HDF5_STATUS_OK(h5_status) && 
+        ( h5_obj_info.type == H5O_TYPE_DATASET ) )
+    {
+        // get the hdf5 dataspace for the passed hdf5 obj
+        hid_t h5_test_dspace = H5Dget_space(hdf5_id);
+        // a dataset with H5S_NULL data space is only compatible with 
+        // conduit empty
+        if( H5Sget_simple_extent_type(h5_test_dspace) == H5S_NULL &&
+            !dtype.is_empty())
+        {
+            res = false;
+        }
+        else
+        {
+            // get the hdf5 datatype that matchs the conduit dtype
+            hid_t h5_dtype = conduit_dtype_to_hdf5_dtype(dtype,
+                                                         ref_path);
         
             // get the hdf5 datatype for the passed hdf5 obj
             hid_t h5_test_dtype  = H5Dget_type(hdf5_id);
@@ -690,8 +1394,38 @@ check_if_conduit_leaf_is_compatible_with_hdf5_obj(const DataType &dtype,
             // we will check the 1d-properties of the hdf5 dataspace
             hssize_t h5_test_num_ele = H5Sget_simple_extent_npoints(h5_test_dspace);
     
+            if(hdf5_write_opts_partial(opts))
+            {
+                // appending or writing at an offset: the dtype must match
+                // and the 1d dataset must be able to hold the range
+                hsize_t h5_dims[1]    = {0};
+                hsize_t h5_maxdims[1] = {0};
+                hsize_t h5_start = 0;
+
+                if(H5Tequal(h5_dtype, h5_test_dtype) <= 0 ||
+                   H5Sget_simple_extent_ndims(h5_test_dspace) != 1)
+                {
+                    res = false;
+                }
+                else
+                {
+                    H5Sget_simple_extent_dims(h5_test_dspace,
+                                              h5_dims,
+                                              h5_maxdims);
+
+                    h5_start = hdf5_write_opts_append(opts) ? h5_dims[0] :
+                          (hsize_t)hdf5_write_opts_offset(opts,ref_path);
+
+                    if(h5_maxdims[0] != H5S_UNLIMITED &&
+                       h5_start + (hsize_t)dtype.number_of_elements() > 
+                       h5_maxdims[0])
+                    {
+                        res = false;
+                    }
+                }
+            }
             // make sure we have the write dtype and the 1d size matches
-            if( ! ( (H5Tequal(h5_dtype, h5_test_dtype) > 0) && 
+            else if( ! ( (H5Tequal(h5_dtype, h5_test_dtype) > 0) && 
                     (dtype.number_of_elements() ==  h5_test_num_ele) ) )
             {
                     res = false;
@@ -727,6 +1461,7 @@ check_if_conduit_leaf_is_compatible_with_hdf5_obj(const DataType &dtype,
 bool
 check_if_conduit_object_is_compatible_with_hdf5_tree(const Node &node,
                                                      const std::string &ref_path,
+                                                     const Node &opts,
                                                      hid_t hdf5_id)
 {
     bool res = true;
@@ -741,6 +1476,9 @@ check_if_conduit_object_is_compatible_with_hdf5_tree(const Node &node,
     {
         NodeConstIterator itr = node.children();
 
+        // holds child options when there are per-subtree overrides
+        Node child_opts_storage;
+
         // call on each child with expanded path
         while(itr.has_next() && res)
         {
@@ -757,9 +1495,15 @@ check_if_conduit_object_is_compatible_with_hdf5_tree(const Node &node,
             if( CONDUIT_HDF5_VALID_ID(h5_child_obj) )
             {
                 // if a child does exist, we need to make sure the child is 
-                // compatible with the conduit node
+                // compatible with the conduit node, using the options the
+                // child will be written with
+                const Node &child_opts = hdf5_write_opts_for_child(opts,
+                                                                   itr.name(),
+                                                          child_opts_storage);
+
                 res = check_if_conduit_node_is_compatible_with_hdf5_tree(child,
                                                                  chld_ref_path,
+                                                                 child_opts,
                                                                   h5_child_obj);
             
                 CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Oclose(h5_child_obj),
@@ -786,6 +1530,7 @@ check_if_conduit_object_is_compatible_with_hdf5_tree(const Node &node,
 bool
 check_if_conduit_node_is_compatible_with_hdf5_tree(const Node &node,
                                                    const std::string &ref_path,
+                                                   const Node &opts,
                                                    hid_t hdf5_id)
 {
     bool res = true;
@@ -796,12 +1541,14 @@ check_if_conduit_node_is_compatible_with_hdf5_tree(const Node &node,
     {
         res = check_if_conduit_leaf_is_compatible_with_hdf5_obj(dt,
                                                                 ref_path,
+                                                                opts,
                                                                 hdf5_id);
     }
     else if(dt.is_object())
     {
         res = check_if_conduit_object_is_compatible_with_hdf5_tree(node,
                                                                    ref_path,
+                                                                   opts,
                                                                    hdf5_id);
     }
     else // not supported
@@ -826,7 +1573,9 @@ create_hdf5_compact_plist_for_conduit_leaf()
 
 //---------------------------------------------------------------------------//
 hid_t
-create_hdf5_chunked_plist_for_conduit_leaf(const DataType &dtype)
+create_hdf5_chunked_plist_for_conduit_leaf(const DataType &dtype,
+                                           const HDF5Options &h5_opts,
+                                           bool extendible)
 {
     hid_t h5_cprops_id = H5Pcreate(H5P_DATASET_CREATE);
 
@@ -834,15 +1583,54 @@ create_hdf5_chunked_plist_for_conduit_leaf(const DataType &dtype)
     
     // hdf5 sets chunking in elements, not bytes, 
     // our options are in bytes, so convert to # of elems
-    hsize_t h5_chunk_size =  (hsize_t) (HDF5Options::chunk_size / dtype.element_bytes()); 
+    hsize_t h5_chunk_size = (hsize_t) (h5_opts.chunk_size / dtype.element_bytes()); 
+
+    // hdf5 limits chunks to 4 gb
+    hsize_t h5_max_chunk = (hsize_t) (4294967295ULL / dtype.element_bytes());
+    if(h5_chunk_size > h5_max_chunk)
+    {
+        h5_chunk_size = h5_max_chunk;
+    }
+
+    if(!extendible && h5_chunk_size > 0)
+    {
+        // split fixed size datasets into evenly sized chunks no larger 
+        // than chunk_size, so the last chunk isn't mostly empty
+        hsize_t h5_num_eles   = (hsize_t) dtype.number_of_elements();
+        hsize_t h5_num_chunks = (h5_num_eles + h5_chunk_size - 1) /
+                                 h5_chunk_size;
+        if(h5_num_chunks > 0)
+        {
+            h5_chunk_size = (h5_num_eles + h5_num_chunks - 1) / 
+                             h5_num_chunks;
+        }
+    }
+    else if(extendible)
+    {
+        // extendible datasets start small and grow with each write, 
+        // so size chunks from the leaf (but at least 4k), up to chunk_size
+        hsize_t h5_min_chunk = (hsize_t) (4096 / dtype.element_bytes());
+        hsize_t h5_leaf_size = (hsize_t) dtype.number_of_elements();
+        hsize_t h5_ext_chunk = h5_leaf_size > h5_min_chunk ? h5_leaf_size :
+                                                             h5_min_chunk;
+        if(h5_ext_chunk < h5_chunk_size)
+        {
+            h5_chunk_size = h5_ext_chunk;
+        }
+    }
+
+    if(h5_chunk_size == 0)
+    {
+        h5_chunk_size = 1;
+    }
 
     H5Pset_chunk(h5_cprops_id, 1, &h5_chunk_size);
 
-    if(HDF5Options::compression_method == "gzip" )
+    if(h5_opts.compression_method == "gzip" )
     {
         // Turn on compression
         H5Pset_shuffle(h5_cprops_id);
-        H5Pset_deflate(h5_cprops_id, HDF5Options::compression_level);
+        H5Pset_deflate(h5_cprops_id, h5_opts.compression_level);
     }
 
     return h5_cprops_id;
@@ -853,6 +1641,8 @@ create_hdf5_chunked_plist_for_conduit_leaf(const DataType &dtype)
 hid_t
 create_hdf5_dataset_for_conduit_leaf(const DataType &dtype,
                                      const std::string &ref_path,
+                                     const Node &opts,
+                                     const HDF5Options &h5_opts,
                                      hid_t hdf5_group_id,
                                      const std::string &hdf5_dset_name)
 {
@@ -861,20 +1651,31 @@ create_hdf5_dataset_for_conduit_leaf(const DataType &dtype,
     hid_t h5_dtype = conduit_dtype_to_hdf5_dtype(dtype,ref_path);
 
     hsize_t num_eles = (hsize_t) dtype.number_of_elements();
-    
+    hsize_t max_eles = num_eles;
     
     hid_t h5_cprops_id = H5P_DEFAULT;
-    
 
-    if( HDF5Options::compact_storage_enabled &&
-        dtype.bytes_compact() <= HDF5Options::compact_storage_threshold)
+    if(hdf5_write_opts_partial(opts))
+    {
+        // appending or writing at an offset creates an empty, chunked
+        // dataset that can grow without bound. the write extends it.
+        num_eles = 0;
+        max_eles = H5S_UNLIMITED;
+        h5_cprops_id = create_hdf5_chunked_plist_for_conduit_leaf(dtype,
+                                                                  h5_opts,
+                                                                  true);
+    }
+    else if( h5_opts.compact_storage_enabled &&
+        dtype.bytes_compact() <= h5_opts.compact_storage_threshold)
     {
         h5_cprops_id = create_hdf5_compact_plist_for_conduit_leaf();
     }
-    else if( HDF5Options::chunking_enabled &&
-             dtype.bytes_compact() > HDF5Options::chunk_threshold)
+    else if( h5_opts.chunking_enabled &&
+             dtype.bytes_compact() > h5_opts.chunk_threshold)
     {
-        h5_cprops_id = create_hdf5_chunked_plist_for_conduit_leaf(dtype);
+        h5_cprops_id = create_hdf5_chunked_plist_for_conduit_leaf(dtype,
+                                                                  h5_opts,
+                                                                  false);
     }
 
     CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_cprops_id,
@@ -883,7 +1684,7 @@ create_hdf5_dataset_for_conduit_leaf(const DataType &dtype,
 
     hid_t h5_dspace_id = H5Screate_simple(1,
                                           &num_eles,
-                                          NULL);
+                                          &max_eles);
 
     CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
                                            ref_path,
@@ -969,10 +1770,71 @@ create_hdf5_dataset_for_conduit_empty(hid_t hdf5_group_id,
 
 
 
+//---------------------------------------------------------------------------//
+// selects the range of a 1d dataset a partial write will fill, extending
+// the dataset if needed. an offset of -1 appends at the current end.
+// returns the file dataspace with the selection, caller must close it.
+//---------------------------------------------------------------------------//
+hid_t
+select_hdf5_dataspace_for_write(hid_t hdf5_dset_id,
+                                index_t num_elements,
+                                index_t offset,
+                                const std::string &ref_path)
+{
+    hid_t h5_dspace_id = H5Dget_space(hdf5_dset_id);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                           ref_path,
+                                           "Failed to get HDF5 dataspace");
+
+    hsize_t h5_dims[1] = {0};
+    H5Sget_simple_extent_dims(h5_dspace_id,h5_dims,NULL);
+
+    hsize_t h5_start = offset < 0 ? h5_dims[0] : (hsize_t) offset;
+    hsize_t h5_count = (hsize_t) num_elements;
+
+    if(h5_start + h5_count > h5_dims[0])
+    {
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_dspace_id),
+                                               ref_path,
+                                         "Failed to close HDF5 dataspace");
+
+        hsize_t h5_new_dims[1] = {h5_start + h5_count};
+
+        if( H5Dset_extent(hdf5_dset_id,h5_new_dims) < 0 )
+        {
+            CONDUIT_HDF5_ERROR(ref_path,
+                               "Failed to extend HDF5 Dataset to "
+                               << h5_new_dims[0] << " elements"
+                               << " (dataset is not extendible)");
+        }
+
+        h5_dspace_id = H5Dget_space(hdf5_dset_id);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                               ref_path,
+                                         "Failed to get HDF5 dataspace");
+    }
+
+    herr_t h5_status = H5Sselect_hyperslab(h5_dspace_id,
+                                           H5S_SELECT_SET,
+                                           &h5_start,
+                                           NULL,
+                                           &h5_count,
+                                           NULL);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                           ref_path,
+                                "Failed to select HDF5 dataspace hyperslab");
+
+    return h5_dspace_id;
+}
+
 //---------------------------------------------------------------------------//
 void 
 write_conduit_leaf_to_hdf5_dataset(const Node &node,
                                    const std::string &ref_path,
+                                   const Node &opts,
                                    hid_t hdf5_dset_id)
 {
     DataType dt = node.dtype();
@@ -980,30 +1842,89 @@ write_conduit_leaf_to_hdf5_dataset(const Node &node,
     hid_t h5_dtype_id = conduit_dtype_to_hdf5_dtype(dt,ref_path);
     herr_t h5_status = -1;
 
-    // if the node is compact, we can write directly from its data ptr
-    if(dt.is_compact()) 
+    hid_t h5_dspace_id = H5S_ALL;
+    hid_t h5_mspace_id = H5S_ALL;
+    index_t num_eles = dt.number_of_elements();
+
+    if(hdf5_write_opts_partial(opts))
+    {
+        // nothing to add
+        if(num_eles == 0)
+        {
+            return;
+        }
+
+        index_t offset = hdf5_write_opts_append(opts) ? -1 :
+                                hdf5_write_opts_offset(opts,ref_path);
+
+        h5_dspace_id = select_hdf5_dataspace_for_write(hdf5_dset_id,
+                                                       num_eles,
+                                                       offset,
+                                                       ref_path);
+    }
+
+    // if the node isn't compact, describe its layout with a strided
+    // memory dataspace so hdf5 gathers the elements directly
+    if(!dt.is_compact() || h5_dspace_id != H5S_ALL)
+    {
+        h5_mspace_id = create_hdf5_memory_dataspace_for_leaf(dt,
+                                                             num_eles,
+                                                             ref_path);
+    }
+
+    if(h5_mspace_id >= 0)
     {
         // write data
         h5_status = H5Dwrite(hdf5_dset_id,
                              h5_dtype_id,
-                             H5S_ALL,
-                             H5S_ALL,
+                             h5_mspace_id,
+                             h5_dspace_id,
                              H5P_DEFAULT,
-                             node.data_ptr());
+                             node.element_ptr(0));
     }
     else 
     {
-        // otherwise, we need to compact our data first
+        // the stride isn't a multiple of the element size, 
+        // so we need to compact our data first
         Node n;
         node.compact_to(n);
+
+        if(h5_dspace_id != H5S_ALL)
+        {
+            hsize_t h5_num_eles = (hsize_t) num_eles;
+            h5_mspace_id = H5Screate_simple(1,&h5_num_eles,NULL);
+
+            CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_mspace_id,
+                                                   ref_path,
+                                  "Failed to create HDF5 memory dataspace");
+        }
+        else
+        {
+            h5_mspace_id = H5S_ALL;
+        }
+
         h5_status = H5Dwrite(hdf5_dset_id,
                              h5_dtype_id,
-                             H5S_ALL,
-                             H5S_ALL,
+                             h5_mspace_id,
+                             h5_dspace_id,
                              H5P_DEFAULT,
                              n.data_ptr());
     }
 
+    if(h5_mspace_id != H5S_ALL)
+    {
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_mspace_id),
+                                               ref_path,
+                                  "Failed to close HDF5 memory dataspace");
+    }
+
+    if(h5_dspace_id != H5S_ALL)
+    {
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_dspace_id),
+                                               ref_path,
+                                  "Failed to close HDF5 dataspace");
+    }
+
     // check write result
     CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
                                            ref_path,
@@ -1016,6 +1937,8 @@ write_conduit_leaf_to_hdf5_dataset(const Node &node,
 void 
 write_conduit_leaf_to_hdf5_group(const Node &node,
                                  const std::string &ref_path,
+                                 const Node &opts,
+                                 const HDF5Options &h5_opts,
                                  hid_t hdf5_group_id,
                                  const std::string &hdf5_dset_name)
 {
@@ -1052,6 +1975,8 @@ write_conduit_leaf_to_hdf5_group(const Node &node,
         // if the hdf5 dataset does not exist, we need to create it
         h5_child_id = create_hdf5_dataset_for_conduit_leaf(node.dtype(),
                                                            ref_path,
+                                                           opts,
+                                                           h5_opts,
                                                            hdf5_group_id,
                                                            hdf5_dset_name);
 
@@ -1068,6 +1993,7 @@ write_conduit_leaf_to_hdf5_group(const Node &node,
     // write the data
     write_conduit_leaf_to_hdf5_dataset(node,
                                        chld_ref_path,
+                                       opts,
                                        h5_child_id);
     
     CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Dclose(h5_child_id),
@@ -1120,26 +2046,198 @@ write_conduit_empty_to_hdf5_group(hid_t hdf5_group_id,
 
 }
 
+//---------------------------------------------------------------------------//
+// writes a small leaf as an attribute of the given group,
+// replacing an existing attribute with the same name
+//---------------------------------------------------------------------------//
+void
+write_conduit_leaf_to_hdf5_attribute(const Node &node,
+                                     const std::string &ref_path,
+                                     hid_t hdf5_group_id,
+                                     const std::string &hdf5_attr_name)
+{
+    std::string chld_ref_path = join_ref_paths(ref_path,hdf5_attr_name);
+
+    if(H5Aexists(hdf5_group_id,hdf5_attr_name.c_str()) > 0)
+    {
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(
+                            H5Adelete(hdf5_group_id,hdf5_attr_name.c_str()),
+                            chld_ref_path,
+                            "Failed to remove existing HDF5 Attribute "
+                            << " parent: " << hdf5_group_id
+                            << " name: "   << hdf5_attr_name);
+    }
+
+    DataType dt = node.dtype();
+
+    hid_t   h5_dtype_id  = conduit_dtype_to_hdf5_dtype(dt,chld_ref_path);
+    hsize_t h5_num_eles  = (hsize_t) dt.number_of_elements();
+    hid_t   h5_dspace_id = H5Screate_simple(1,&h5_num_eles,NULL);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                           chld_ref_path,
+                                           "Failed to create HDF5 Dataspace");
+
+    hid_t h5_attr_id = H5Acreate(hdf5_group_id,
+                                 hdf5_attr_name.c_str(),
+                                 h5_dtype_id,
+                                 h5_dspace_id,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_attr_id,
+                                           chld_ref_path,
+                                           "Failed to create HDF5 Attribute "
+                                           << " parent: " << hdf5_group_id
+                                           << " name: "   << hdf5_attr_name);
+
+    herr_t h5_status = -1;
+
+    // attribute writes don't take a memory dataspace,
+    // so non-compact leaves are compacted first
+    if(dt.is_compact())
+    {
+        h5_status = H5Awrite(h5_attr_id,
+                             h5_dtype_id,
+                             node.element_ptr(0));
+    }
+    else
+    {
+        Node n;
+        node.compact_to(n);
+        h5_status = H5Awrite(h5_attr_id,
+                             h5_dtype_id,
+                             n.data_ptr());
+    }
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                           chld_ref_path,
+                                           "Failed to write HDF5 Attribute "
+                                           << h5_attr_id);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Aclose(h5_attr_id),
+                                           chld_ref_path,
+                                           "Failed to close HDF5 Attribute "
+                                           << h5_attr_id);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_dspace_id),
+                                           chld_ref_path,
+                                           "Failed to close HDF5 Dataspace "
+                                           << h5_dspace_id);
+}
+
+//---------------------------------------------------------------------------//
+// records the order of the group's children in an attribute, so leaves 
+// stored as attributes are read back in place. names of children
+// written by earlier calls are kept in front.
+//---------------------------------------------------------------------------//
+void
+write_hdf5_child_order(const Node &node,
+                       const std::string &ref_path,
+                       hid_t hdf5_group_id)
+{
+    std::vector<std::string> child_names;
+    read_hdf5_child_order(hdf5_group_id,ref_path,child_names);
+
+    std::set<std::string> known_names(child_names.begin(),
+                                      child_names.end());
+
+    NodeConstIterator itr = node.children();
+    while(itr.has_next())
+    {
+        itr.next();
+        if(known_names.insert(itr.name()).second)
+        {
+            child_names.push_back(itr.name());
+        }
+    }
+
+    std::string child_order;
+    for(size_t i = 0; i < child_names.size(); i++)
+    {
+        child_order += child_names[i];
+        child_order += "\n";
+    }
+
+    Node n_child_order;
+    n_child_order.set(child_order);
+
+    write_conduit_leaf_to_hdf5_attribute(n_child_order,
+                                         ref_path,
+                                         hdf5_group_id,
+                                         hdf5_child_order_attr_name());
+}
+
 //---------------------------------------------------------------------------//
 // assume this is called only if we know the hdf5 state is compatible 
 //---------------------------------------------------------------------------//
 void
 write_conduit_object_to_hdf5_group(const Node &node,
                                    const std::string &ref_path,
+                                   const Node &opts,
+                                   const HDF5Options &h5_opts,
                                    hid_t hdf5_group_id)
 {
     NodeConstIterator itr = node.children();
 
+    // holds child options when there are per-subtree overrides
+    Node        child_opts_storage;
+    HDF5Options child_h5_opts_storage;
+
+    // true if this group holds (or already held) leaves as attributes
+    bool has_attr_leaves = H5Aexists(hdf5_group_id,
+                                 hdf5_child_order_attr_name().c_str()) > 0;
+
     // call on each child with expanded path
     while(itr.has_next())
     {
         const Node &child = itr.next();
         DataType dt = child.dtype();
 
+        const HDF5Options *child_h5_opts_ptr = NULL;
+        const Node &child_opts = hdf5_write_opts_for_child(opts,
+                                                           h5_opts,
+                                                           itr.name(),
+                                                          child_opts_storage,
+                                                       child_h5_opts_storage,
+                                                           child_h5_opts_ptr);
+        const HDF5Options &child_h5_opts = *child_h5_opts_ptr;
+
+        // small leaves may be stored as attributes, unless a dataset
+        // already exists for them
+        if( (dt.is_number() || dt.is_string()) &&
+            hdf5_write_opts_leaf_as_attribute(child,
+                                              itr.name(),
+                                              child_opts,
+                                              child_h5_opts) &&
+            H5Lexists(hdf5_group_id,itr.name().c_str(),H5P_DEFAULT) <= 0 )
+        {
+            write_conduit_leaf_to_hdf5_attribute(child,
+                                                 ref_path,
+                                                 hdf5_group_id,
+                                                 itr.name());
+            has_attr_leaves = true;
+            continue;
+        }
+
+        // a dataset or group replaces a leaf written as an attribute
+        if( has_attr_leaves &&
+            H5Aexists(hdf5_group_id,itr.name().c_str()) > 0 )
+        {
+            CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(
+                                H5Adelete(hdf5_group_id,itr.name().c_str()),
+                                ref_path,
+                                "Failed to remove HDF5 Attribute "
+                                << " parent: " << hdf5_group_id
+                                << " name: "   << itr.name());
+        }
+
         if(dt.is_number() || dt. is_string())
         {
             write_conduit_leaf_to_hdf5_group(child,
                                              ref_path,
+                                             child_opts,
+                                             child_h5_opts,
                                              hdf5_group_id,
                                              itr.name().c_str());
         }
@@ -1253,6 +2351,8 @@ write_conduit_object_to_hdf5_group(const Node &node,
             // traverse 
             write_conduit_object_to_hdf5_group(child,
                                                ref_path,
+                                               child_opts,
+                                               child_h5_opts,
                                                h5_child_id);
 
             CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Gclose(h5_child_id),
@@ -1268,7 +2368,14 @@ write_conduit_object_to_hdf5_group(const Node &node,
                                <<"\' not supported for relay HDF5 I/O");
         }
     }
-}
+
+    if(has_attr_leaves)
+    {
+        write_hdf5_child_order(node,
+                               ref_path,
+                               hdf5_group_id);
+    }
+}
 
 
 
@@ -1278,6 +2385,7 @@ write_conduit_object_to_hdf5_group(const Node &node,
 void
 write_conduit_node_to_hdf5_tree(const Node &node,
                                 const std::string &ref_path,
+                                const Node &opts,
                                 hid_t hdf5_id)
 {
 
@@ -1287,12 +2395,21 @@ write_conduit_node_to_hdf5_tree(const Node &node,
     {
         write_conduit_leaf_to_hdf5_dataset(node,
                                            ref_path,
+                                           opts,
                                            hdf5_id);
     }
     else if(dt.is_object())
     {
+        // start from the process wide defaults, then apply the options
+        // passed for this write. children with per-subtree overrides
+        // resolve their own from these.
+        HDF5Options h5_opts = HDF5Options::defaults();
+        h5_opts.set(opts);
+
         write_conduit_object_to_hdf5_group(node,
                                            ref_path,
+                                           opts,
+                                           h5_opts,
                                            hdf5_id);
     }
     else // not supported
@@ -1309,6 +2426,186 @@ write_conduit_node_to_hdf5_tree(const Node &node,
 //---------------------------------------------------------------------------//
 
 
+//---------------------------------------------------------------------------//
+// reads a slab selection option ("offset", "stride", or "count") into
+// an array with one entry per dataset dimension. Returns false if the 
+// option isn't given.
+//---------------------------------------------------------------------------//
+bool
+read_hdf5_slab_option(const Node &opts,
+                      const std::string &name,
+                      std::vector<hsize_t> &vals,
+                      const std::string &ref_path)
+{
+    if(!opts.has_child(name))
+    {
+        return false;
+    }
+
+    Node n_vals;
+    opts.fetch_child(name).to_int64_array(n_vals);
+    int64_array vals_arr = n_vals.value();
+
+    if(vals_arr.number_of_elements() != (index_t)vals.size())
+    {
+        CONDUIT_HDF5_ERROR(ref_path,
+                           "HDF5 read option \"" << name << "\" has "
+                           << vals_arr.number_of_elements() 
+                           << " entries, but the dataset has "
+                           << vals.size() << " dimensions");
+    }
+
+    for(size_t i=0; i < vals.size(); i++)
+    {
+        if(vals_arr[i] < 0)
+        {
+            CONDUIT_HDF5_ERROR(ref_path,
+                               "HDF5 read option \"" << name << "\""
+                               << " has a negative entry: " << vals_arr[i]);
+        }
+        vals[i] = (hsize_t) vals_arr[i];
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// Selects a hyperslab of the given file dataspace using the 
+// "offset", "stride" and "count" options (in elements, one entry per 
+// dimension). Missing options default to: offset 0, stride 1, and a count 
+// that covers the rest of the dimension.
+//
+// Returns the number of selected elements.
+//---------------------------------------------------------------------------//
+index_t
+select_hdf5_dataspace_slab(hid_t hdf5_dspace_id,
+                           const Node &opts,
+                           const std::string &ref_path)
+{
+    int rank = H5Sget_simple_extent_ndims(hdf5_dspace_id);
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(rank,
+                                           ref_path,
+                                           "Error reading HDF5 Dataspace "
+                                           << "rank: " << hdf5_dspace_id);
+    if(rank == 0)
+    {
+        CONDUIT_HDF5_ERROR(ref_path,
+                           "Cannot select a slab from a scalar HDF5 dataset");
+    }
+
+    std::vector<hsize_t> dims((size_t)rank);
+    std::vector<hsize_t> offset((size_t)rank,0);
+    std::vector<hsize_t> stride((size_t)rank,1);
+    std::vector<hsize_t> count((size_t)rank,0);
+
+    H5Sget_simple_extent_dims(hdf5_dspace_id,&dims[0],NULL);
+
+    read_hdf5_slab_option(opts,"offset",offset,ref_path);
+    read_hdf5_slab_option(opts,"stride",stride,ref_path);
+    bool has_count = read_hdf5_slab_option(opts,"count",count,ref_path);
+
+    index_t nelems = 1;
+    for(size_t i=0; i < dims.size(); i++)
+    {
+        if(stride[i] == 0)
+        {
+            CONDUIT_HDF5_ERROR(ref_path,
+                               "HDF5 read option \"stride\" must be > 0");
+        }
+
+        if(!has_count)
+        {
+            // select the rest of the dimension
+            count[i] = offset[i] < dims[i] ? 
+                       (dims[i] - offset[i] + stride[i] - 1) / stride[i] : 0;
+        }
+        else if(count[i] > 0 &&
+                offset[i] + (count[i] - 1) * stride[i] >= dims[i])
+        {
+            CONDUIT_HDF5_ERROR(ref_path,
+                               "HDF5 slab selection is out of bounds in"
+                               << " dimension " << i 
+                               << " (offset: " << offset[i] 
+                               << ", stride: " << stride[i]
+                               << ", count: "  << count[i]
+                               << ", dataset extent: " << dims[i] << ")");
+        }
+        nelems *= (index_t)count[i];
+    }
+
+    if(nelems == 0)
+    {
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sselect_none(hdf5_dspace_id),
+                                               ref_path,
+                                               "Error selecting HDF5 "
+                                               << "hyperslab");
+    }
+    else
+    {
+        herr_t h5_status = H5Sselect_hyperslab(hdf5_dspace_id,
+                                               H5S_SELECT_SET,
+                                               &offset[0],
+                                               &stride[0],
+                                               &count[0],
+                                               NULL);
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                               ref_path,
+                                               "Error selecting HDF5 "
+                                               << "hyperslab");
+    }
+
+    return nelems;
+}
+
+//---------------------------------------------------------------------------//
+// Creates a 1D memory dataspace that describes num_elements of a leaf's
+// memory, starting at element_ptr(0) and following its stride. 
+//
+// Returns -1 if the stride is not a multiple of the element size, since 
+// hdf5 can't describe that layout with a native type.
+//---------------------------------------------------------------------------//
+hid_t
+create_hdf5_memory_dataspace_for_leaf(const DataType &dt,
+                                      index_t num_elements,
+                                      const std::string &ref_path)
+{
+    index_t ele_bytes = dt.element_bytes();
+    if(ele_bytes <= 0 || 
+       dt.stride() < ele_bytes || 
+       (dt.stride() % ele_bytes) != 0)
+    {
+        return -1;
+    }
+
+    hsize_t h5_stride = (hsize_t)(dt.stride() / ele_bytes);
+    hsize_t h5_count  = (hsize_t)num_elements;
+    hsize_t h5_extent = h5_count > 0 ? (h5_count - 1) * h5_stride + 1 : 0;
+
+    hid_t h5_dspace_id = H5Screate_simple(1,
+                                          &h5_extent,
+                                          NULL);
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                           ref_path,
+                                           "Failed to create HDF5 memory "
+                                           << "Dataspace");
+
+    if(h5_stride > 1 && h5_count > 0)
+    {
+        hsize_t h5_start = 0;
+        herr_t h5_status = H5Sselect_hyperslab(h5_dspace_id,
+                                               H5S_SELECT_SET,
+                                               &h5_start,
+                                               &h5_stride,
+                                               &h5_count,
+                                               NULL);
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                               ref_path,
+                                               "Error selecting HDF5 "
+                                               << "memory hyperslab");
+    }
+
+    return h5_dspace_id;
+}
+
 //---------------------------------------------------------------------------//
 //---------------------------------------------------------------------------//
 //---------------------------------------------------------------------------//
@@ -1358,6 +2655,11 @@ struct h5_read_opdata
 
     // pointer to conduit node, anchors traversal to 
     Node            *node;
+    // pointer to conduit schema, anchors a schema only traversal
+    // (used instead of node when not NULL)
+    Schema          *schema;
+    // read options for the children of this group, keyed by child name
+    const Node      *opts;
     std::string      ref_path;
 };
 
@@ -1471,11 +2773,26 @@ h5l_iterate_traverse_op_func(hid_t hdf5_id,
                                                        << hdf5_path);
 
                 // execute traversal for this group
-                Node &chld_node = h5_od->node->fetch(hdf5_path);
+                if(h5_od->schema != NULL)
+                {
+                    read_hdf5_group_into_conduit_schema(h5_group_id,
+                                                        chld_ref_path,
+                                        h5_od->schema->fetch(hdf5_path));
+                }
+                else
+                {
+                    Node &chld_node = h5_od->node->fetch(hdf5_path);
 
-                read_hdf5_group_into_conduit_node(h5_group_id,
-                                                  chld_ref_path,
-                                                  chld_node);
+                    // options are nested like the hdf5 tree
+                    const Node &chld_opts = h5_od->opts->has_child(hdf5_path) ?
+                                          h5_od->opts->fetch_child(hdf5_path) :
+                                          hdf5_no_opts();
+
+                    read_hdf5_group_into_conduit_node(h5_group_id,
+                                                      chld_ref_path,
+                                                      chld_opts,
+                                                      chld_node);
+                }
 
                 // close the group
                 CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Gclose(h5_group_id),
@@ -1488,7 +2805,6 @@ h5l_iterate_traverse_op_func(hid_t hdf5_id,
         }
         case H5O_TYPE_DATASET:
         {
-            Node &leaf = h5_od->node->fetch(hdf5_path);
             // open hdf5 dataset at path
             hid_t h5_dset_id = H5Dopen(hdf5_id,
                                        hdf5_path,
@@ -1503,9 +2819,25 @@ h5l_iterate_traverse_op_func(hid_t hdf5_id,
                                                    << " path:"
                                                    << hdf5_path);
 
-            read_hdf5_dataset_into_conduit_node(h5_dset_id,
-                                                chld_ref_path,
-                                                leaf);
+            if(h5_od->schema != NULL)
+            {
+                read_hdf5_dataset_into_conduit_schema(h5_dset_id,
+                                                      chld_ref_path,
+                                        h5_od->schema->fetch(hdf5_path));
+            }
+            else
+            {
+                Node &leaf = h5_od->node->fetch(hdf5_path);
+
+                const Node &dset_opts = h5_od->opts->has_child(hdf5_path) ?
+                                        h5_od->opts->fetch_child(hdf5_path) :
+                                        hdf5_no_opts();
+
+                read_hdf5_dataset_into_conduit_node(h5_dset_id,
+                                                    chld_ref_path,
+                                                    dset_opts,
+                                                    leaf);
+            }
             
             // close the dataset
             CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Dclose(h5_dset_id),
@@ -1525,30 +2857,25 @@ h5l_iterate_traverse_op_func(hid_t hdf5_id,
 }
 
 
+//---------------------------------------------------------------------------//
+// runs our H5Literate callback on the children of the group, using
+// creation order when the group tracks it. the caller attaches the 
+// destination (node or schema) to the callback struct.
 //---------------------------------------------------------------------------//
 void
-read_hdf5_group_into_conduit_node(hid_t hdf5_group_id,
-                                  const std::string &ref_path,
-                                  Node &dest)
+iterate_hdf5_group(hid_t hdf5_group_id,
+                   const std::string &ref_path,
+                   h5_read_opdata &h5_od)
 {
-    // we want to make sure this is a conduit object
-    // even if it doesn't have any children
-    dest.set(DataType::object());
-    
-    
     // get info, we need to get the obj addr for cycle tracking
     H5O_info_t h5_info_buf;
     herr_t h5_status = H5Oget_info(hdf5_group_id,
                                    &h5_info_buf);
 
-    // setup the callback struct we will use for  H5Literate
-    struct h5_read_opdata  h5_od;
     // setup linked list tracking that allows us to detect cycles
     h5_od.recurs = 0;
     h5_od.prev = NULL;
     h5_od.addr = h5_info_buf.addr;
-    // attach the pointer to our node
-    h5_od.node = &dest;
     // keep ref path
     h5_od.ref_path = ref_path;
 
@@ -1585,6 +2912,41 @@ read_hdf5_group_into_conduit_node(hid_t hdf5_group_id,
     
     
 
+    // if some children were written as attributes, create the children 
+    // in their recorded order first, and note which are attributes
+    std::vector<std::string> child_names;
+    std::vector<std::string> attr_leaf_names;
+
+    if(read_hdf5_child_order(hdf5_group_id,ref_path,child_names))
+    {
+        for(size_t i = 0; i < child_names.size(); i++)
+        {
+            const std::string &child_name = child_names[i];
+            bool is_link = H5Lexists(hdf5_group_id,
+                                     child_name.c_str(),
+                                     H5P_DEFAULT) > 0;
+
+            if(!is_link &&
+               H5Aexists(hdf5_group_id,child_name.c_str()) > 0)
+            {
+                attr_leaf_names.push_back(child_name);
+            }
+            else if(!is_link)
+            {
+                continue;
+            }
+
+            if(h5_od.schema != NULL)
+            {
+                h5_od.schema->fetch(child_name);
+            }
+            else
+            {
+                h5_od.node->fetch(child_name);
+            }
+        }
+    }
+
     // use H5Literate to traverse
     h5_status = H5Literate(hdf5_group_id,
                            h5_grp_index_type,
@@ -1599,12 +2961,145 @@ read_hdf5_group_into_conduit_node(hid_t hdf5_group_id,
                                            << "traverse and read HDF5 "
                                            << "hierarchy: "
                                            << hdf5_group_id);
+
+    for(size_t i = 0; i < attr_leaf_names.size(); i++)
+    {
+        const std::string &leaf_name = attr_leaf_names[i];
+        std::string leaf_ref_path = join_ref_paths(ref_path,leaf_name);
+
+        hid_t h5_attr_id = H5Aopen(hdf5_group_id,
+                                   leaf_name.c_str(),
+                                   H5P_DEFAULT);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_attr_id,
+                                               leaf_ref_path,
+                                               "Error opening HDF5 "
+                                               << "Attribute: "
+                                               << " parent: "
+                                               << hdf5_group_id 
+                                               << " name:"
+                                               << leaf_name);
+
+        if(h5_od.schema != NULL)
+        {
+            read_hdf5_attribute_into_conduit_schema(h5_attr_id,
+                                                    leaf_ref_path,
+                                    h5_od.schema->fetch_child(leaf_name));
+        }
+        else
+        {
+            read_hdf5_attribute_into_conduit_node(h5_attr_id,
+                                                  leaf_ref_path,
+                                      h5_od.node->fetch_child(leaf_name));
+        }
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Aclose(h5_attr_id),
+                                               leaf_ref_path,
+                                               "Error closing HDF5 "
+                                               << "Attribute: "
+                                               << h5_attr_id);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+read_hdf5_group_into_conduit_node(hid_t hdf5_group_id,
+                                  const std::string &ref_path,
+                                  const Node &opts,
+                                  Node &dest)
+{
+    // we want to make sure this is a conduit object
+    // even if it doesn't have any children
+    dest.set(DataType::object());
+
+    // setup the callback struct we will use for  H5Literate
+    struct h5_read_opdata  h5_od;
+    // attach the pointer to our node
+    h5_od.node   = &dest;
+    h5_od.schema = NULL;
+    // options for our children
+    h5_od.opts = &opts;
+
+    iterate_hdf5_group(hdf5_group_id,
+                       ref_path,
+                       h5_od);
+}
+
+//---------------------------------------------------------------------------//
+void
+read_hdf5_group_into_conduit_schema(hid_t hdf5_group_id,
+                                    const std::string &ref_path,
+                                    Schema &dest)
+{
+    // we want to make sure this is a conduit object
+    // even if it doesn't have any children
+    dest.set(DataType::object());
+
+    // setup the callback struct we will use for  H5Literate
+    struct h5_read_opdata  h5_od;
+    // attach the pointer to our schema
+    h5_od.node   = NULL;
+    h5_od.schema = &dest;
+    h5_od.opts   = &hdf5_no_opts();
+
+    iterate_hdf5_group(hdf5_group_id,
+                       ref_path,
+                       h5_od);
+}
+
+//---------------------------------------------------------------------------//
+void
+read_hdf5_dataset_into_conduit_schema(hid_t hdf5_dset_id,
+                                      const std::string &ref_path,
+                                      Schema &dest)
+{
+    hid_t h5_dspace_id = H5Dget_space(hdf5_dset_id);
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                           ref_path,
+                                           "Error reading HDF5 Dataspace: " 
+                                           << hdf5_dset_id);
+
+    // check for empty case
+    if(H5Sget_simple_extent_type(h5_dspace_id) == H5S_NULL)
+    {
+        dest.set(DataType::empty());
+    }
+    else
+    {
+        hid_t h5_dtype_id  = H5Dget_type(hdf5_dset_id); 
+    
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dtype_id,
+                                               ref_path,
+                                               "Error reading HDF5 Datatype: "
+                                               << hdf5_dset_id);
+
+        DataType dt = hdf5_dtype_to_conduit_dtype(h5_dtype_id,
+                                   H5Sget_simple_extent_npoints(h5_dspace_id),
+                                   ref_path);
+
+        // reads convert to the machine's endianness, 
+        // so describe the data as it will be read
+        dt.set_endianness(Endianness::machine_default());
+
+        dest.set(dt);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Tclose(h5_dtype_id),
+                                               ref_path,
+                                               "Error closing HDF5 Datatype: "
+                                               << h5_dtype_id);
+    }
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_dspace_id),
+                                           ref_path,
+                                           "Error closing HDF5 Dataspace: "
+                                           << h5_dspace_id);
 }
 
 //---------------------------------------------------------------------------//
 void
 read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
                                     const std::string &ref_path,
+                                    const Node &opts,
                                     Node &dest)
 {
     hid_t h5_dspace_id = H5Dget_space(hdf5_dset_id);
@@ -1630,7 +3125,17 @@ read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
 
 
     
-        index_t nelems     = H5Sget_simple_extent_npoints(h5_dspace_id);
+        // apply any slab selection from the options to the file dataspace
+        bool has_slab = opts.has_child("offset") ||
+                        opts.has_child("stride") ||
+                        opts.has_child("count");
+
+        index_t nelems     = has_slab ? 
+                             select_hdf5_dataspace_slab(h5_dspace_id,
+                                                        opts,
+                                                        ref_path) :
+                             H5Sget_simple_extent_npoints(h5_dspace_id);
+
         DataType dt        = hdf5_dtype_to_conduit_dtype(h5_dtype_id,
                                                          nelems,
                                                          ref_path);
@@ -1666,8 +3171,16 @@ read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
         }
         
         hid_t h5_status    = 0;
+
+        // if dest can't hold the data, switch it to the dataset's type
+        // (without initializing, we read over all of it)
+        if(!dest.dtype().compatible(dt))
+        {
+            dest.set_uninitialized(dt);
+        }
     
-        if(dest.dtype().is_compact() && 
+        if(!has_slab &&
+           dest.dtype().is_compact() && 
            dest.dtype().compatible(dt) )
         {
             // we can read directly from hdf5 dataset if compact 
@@ -1677,25 +3190,60 @@ read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
                                 H5S_ALL,
                                 H5S_ALL,
                                 H5P_DEFAULT,
-                                dest.data_ptr());
+                                dest.element_ptr(0));
         }
         else
         {
-            // we create a temp Node b/c we want read to work for 
-            // strided data
-            // 
-            // the hdf5 data will always be compact, source node we are 
-            // reading will not unless it's already compatible and compact.
-            Node n_tmp(dt);
-            h5_status = H5Dread(hdf5_dset_id,
-                                h5_dtype_id,
-                                H5S_ALL,
-                                H5S_ALL,
-                                H5P_DEFAULT,
-                                n_tmp.data_ptr());
-        
-            // copy out to our dest
-        dest.set(n_tmp);
+            hid_t h5_file_dspace_id = has_slab ? h5_dspace_id : H5S_ALL;
+
+            // describe dest's (possibly strided) memory to hdf5,
+            // so we read the selected elements directly into it
+            hid_t h5_mem_dspace_id = 
+                        create_hdf5_memory_dataspace_for_leaf(dest.dtype(),
+                                                              nelems,
+                                                              ref_path);
+
+            if( CONDUIT_HDF5_VALID_ID(h5_mem_dspace_id) )
+            {
+                if(nelems > 0)
+                {
+                    h5_status = H5Dread(hdf5_dset_id,
+                                        h5_dtype_id,
+                                        h5_mem_dspace_id,
+                                        h5_file_dspace_id,
+                                        H5P_DEFAULT,
+                                        dest.element_ptr(0));
+                }
+            }
+            else
+            {
+                // we create a temp Node b/c dest's stride isn't a
+                // multiple of its element size, which hdf5 can't describe
+                Node n_tmp;
+                n_tmp.set_uninitialized(dt);
+                h5_mem_dspace_id = 
+                        create_hdf5_memory_dataspace_for_leaf(dt,
+                                                              nelems,
+                                                              ref_path);
+                if(nelems > 0)
+                {
+                    h5_status = H5Dread(hdf5_dset_id,
+                                        h5_dtype_id,
+                                        h5_mem_dspace_id,
+                                        h5_file_dspace_id,
+                                        H5P_DEFAULT,
+                                        n_tmp.data_ptr());
+                }
+
+                // copy out to our dest, reusing its buffers when possible
+                dest.set_compatible(n_tmp);
+            }
+
+            CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_mem_dspace_id),
+                                                   ref_path,
+                                                   "Error closing HDF5 "
+                                                   "memory Dataspace: "
+                                                   << h5_mem_dspace_id);
         }
 
         CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
@@ -1721,6 +3269,7 @@ read_hdf5_dataset_into_conduit_node(hid_t hdf5_dset_id,
 void
 read_hdf5_tree_into_conduit_node(hid_t hdf5_id,
                                  const std::string  &ref_path,
+                                 const Node &opts,
                                  Node &dest)
 {
     herr_t     h5_status = 0;
@@ -1741,8 +3290,14 @@ read_hdf5_tree_into_conduit_node(hid_t hdf5_id,
         // use a H5Literate traversal
         case H5O_TYPE_GROUP:
         {
+            // per dataset options are under "datasets", 
+            // keyed by their path relative to this group
+            const Node &dsets_opts = opts.has_child("datasets") ?
+                                     opts.fetch_child("datasets") :
+                                     hdf5_no_opts();
             read_hdf5_group_into_conduit_node(hdf5_id,
                                               ref_path,
+                                              dsets_opts,
                                               dest);
             break;
         }
@@ -1752,6 +3307,7 @@ read_hdf5_tree_into_conduit_node(hid_t hdf5_id,
         {
             read_hdf5_dataset_into_conduit_node(hdf5_id,
                                                 ref_path,
+                                                opts,
                                                 dest);
             break;
         }
@@ -1785,34 +3341,354 @@ read_hdf5_tree_into_conduit_node(hid_t hdf5_id,
     }
 }
 
-
-
 //---------------------------------------------------------------------------//
-hid_t
-create_hdf5_file_access_plist()
+void
+read_hdf5_tree_into_conduit_schema(hid_t hdf5_id,
+                                   const std::string  &ref_path,
+                                   Schema &dest)
 {
-    // create property list and set use latest lib ver settings 
-    hid_t h5_fa_props = H5Pcreate(H5P_FILE_ACCESS);
-    
-    CONDUIT_CHECK_HDF5_ERROR(h5_fa_props,
-                             "Failed to create H5P_FILE_ACCESS "
-                             << " property list");
-    
+    herr_t     h5_status = 0;
+    H5O_info_t h5_info_buf;
     
-    herr_t h5_status = H5Pset_libver_bounds(h5_fa_props,
-                                            H5F_LIBVER_LATEST,
-                                            H5F_LIBVER_LATEST);
+    h5_status = H5Oget_info(hdf5_id,&h5_info_buf);
 
-    CONDUIT_CHECK_HDF5_ERROR(h5_status,
-                             "Failed to set libver options for "
-                             << "property list " << h5_fa_props);
-    return h5_fa_props;
-}
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                           ref_path,
+                                           "Error fetching HDF5 object "
+                                           << "info from: " 
+                                           << hdf5_id);
 
-//---------------------------------------------------------------------------//
-hid_t
-create_hdf5_file_create_plist()
-{
+    if(h5_info_buf.type == H5O_TYPE_GROUP)
+    {
+        read_hdf5_group_into_conduit_schema(hdf5_id,
+                                            ref_path,
+                                            dest);
+    }
+    else if(h5_info_buf.type == H5O_TYPE_DATASET)
+    {
+        read_hdf5_dataset_into_conduit_schema(hdf5_id,
+                                              ref_path,
+                                              dest);
+    }
+    else
+    {
+        CONDUIT_HDF5_ERROR(ref_path,
+                           "Cannot read HDF5 Object schema "
+                           << "(not a group or dataset)");
+    }
+}
+
+
+
+//---------------------------------------------------------------------------//
+// returns the conduit dtype that describes an attribute as it will be
+// read (in the machine's endianness)
+//---------------------------------------------------------------------------//
+DataType
+hdf5_attribute_conduit_dtype(hid_t hdf5_attr_id,
+                             const std::string &ref_path)
+{
+    hid_t h5_dspace_id = H5Aget_space(hdf5_attr_id);
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dspace_id,
+                                           ref_path,
+                                           "Error reading HDF5 Dataspace: " 
+                                           << hdf5_attr_id);
+
+    hid_t h5_dtype_id  = H5Aget_type(hdf5_attr_id); 
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dtype_id,
+                                           ref_path,
+                                           "Error reading HDF5 Datatype: "
+                                           << hdf5_attr_id);
+
+    DataType dt = hdf5_dtype_to_conduit_dtype(h5_dtype_id,
+                                   H5Sget_simple_extent_npoints(h5_dspace_id),
+                                   ref_path);
+
+    dt.set_endianness(Endianness::machine_default());
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Tclose(h5_dtype_id),
+                                           ref_path,
+                                           "Error closing HDF5 Datatype: "
+                                           << h5_dtype_id);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_dspace_id),
+                                           ref_path,
+                                           "Error closing HDF5 Dataspace: "
+                                           << h5_dspace_id);
+    return dt;
+}
+
+//---------------------------------------------------------------------------//
+void
+read_hdf5_attribute_into_conduit_schema(hid_t hdf5_attr_id,
+                                        const std::string &ref_path,
+                                        Schema &dest)
+{
+    dest.set(hdf5_attribute_conduit_dtype(hdf5_attr_id,ref_path));
+}
+
+//---------------------------------------------------------------------------//
+void
+read_hdf5_attribute_into_conduit_node(hid_t hdf5_attr_id,
+                                      const std::string &ref_path,
+                                      Node &dest)
+{
+    DataType dt = hdf5_attribute_conduit_dtype(hdf5_attr_id,ref_path);
+
+    // hdf5 converts to the machine's endianness on read
+    hid_t h5_dtype_id = conduit_dtype_to_hdf5_dtype(dt,ref_path);
+    herr_t h5_status  = 0;
+
+    if(!dest.dtype().compatible(dt))
+    {
+        dest.set_uninitialized(dt);
+    }
+
+    // attribute reads don't take a memory dataspace, 
+    // so read via a temp node if dest isn't compact
+    if(dest.dtype().is_compact())
+    {
+        h5_status = H5Aread(hdf5_attr_id,
+                            h5_dtype_id,
+                            dest.element_ptr(0));
+    }
+    else
+    {
+        Node n_tmp;
+        n_tmp.set_uninitialized(dt);
+        h5_status = H5Aread(hdf5_attr_id,
+                            h5_dtype_id,
+                            n_tmp.data_ptr());
+
+        dest.set_compatible(n_tmp);
+    }
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                           ref_path,
+                                           "Error reading HDF5 Attribute: "
+                                           << hdf5_attr_id);
+}
+
+//---------------------------------------------------------------------------//
+// reads the child order recorded for a group that holds leaves as
+// attributes. returns false if the group doesn't have one.
+//---------------------------------------------------------------------------//
+bool
+read_hdf5_child_order(hid_t hdf5_group_id,
+                      const std::string &ref_path,
+                      std::vector<std::string> &child_names)
+{
+    child_names.clear();
+
+    const std::string &attr_name = hdf5_child_order_attr_name();
+
+    if(H5Aexists(hdf5_group_id,attr_name.c_str()) <= 0)
+    {
+        return false;
+    }
+
+    hid_t h5_attr_id = H5Aopen(hdf5_group_id,
+                               attr_name.c_str(),
+                               H5P_DEFAULT);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_attr_id,
+                                           ref_path,
+                                           "Error opening HDF5 Attribute: "
+                                           << attr_name);
+    Node n_child_order;
+    read_hdf5_attribute_into_conduit_node(h5_attr_id,
+                                          ref_path,
+                                          n_child_order);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Aclose(h5_attr_id),
+                                           ref_path,
+                                           "Error closing HDF5 Attribute: "
+                                           << h5_attr_id);
+
+    // names are newline terminated
+    std::string child_order = n_child_order.as_string();
+    std::string::size_type start = 0;
+    std::string::size_type end   = child_order.find('\n');
+
+    while(end != std::string::npos)
+    {
+        child_names.push_back(child_order.substr(start,end-start));
+        start = end + 1;
+        end   = child_order.find('\n',start);
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+// opens the attribute that holds the leaf at the given path, 
+// returns -1 if the path isn't a leaf stored as an attribute
+//---------------------------------------------------------------------------//
+hid_t
+open_hdf5_attribute_leaf(hid_t hdf5_id,
+                         const std::string &hdf5_path)
+{
+    std::string parent_path;
+    std::string leaf_name;
+    conduit::utils::rsplit_string(hdf5_path,"/",leaf_name,parent_path);
+
+    if(parent_path.empty())
+    {
+        parent_path = (!hdf5_path.empty() && hdf5_path[0] == '/') ? "/" : ".";
+    }
+
+    if(leaf_name.empty() ||
+       leaf_name == hdf5_child_order_attr_name() ||
+       H5Lexists(hdf5_id,hdf5_path.c_str(),H5P_DEFAULT) > 0)
+    {
+        return -1;
+    }
+
+    hid_t h5_parent_id = H5Oopen(hdf5_id,
+                                 parent_path.c_str(),
+                                 H5P_DEFAULT);
+    if(h5_parent_id < 0)
+    {
+        return -1;
+    }
+
+    hid_t res = -1;
+    std::vector<std::string> child_names;
+
+    if(read_hdf5_child_order(h5_parent_id,hdf5_path,child_names) &&
+       std::find(child_names.begin(),
+                 child_names.end(),
+                 leaf_name) != child_names.end() &&
+       H5Aexists(h5_parent_id,leaf_name.c_str()) > 0)
+    {
+        res = H5Aopen(h5_parent_id,
+                      leaf_name.c_str(),
+                      H5P_DEFAULT);
+    }
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Oclose(h5_parent_id),
+                                           hdf5_path,
+                                           "Failed to close HDF5 Object: "
+                                           << h5_parent_id);
+    return res;
+}
+
+
+//---------------------------------------------------------------------------//
+hid_t
+create_hdf5_file_access_plist(bool use_page_buffer)
+{
+    const HDF5Options &h5_opts = HDF5Options::defaults();
+
+    // create property list and set lib ver settings (latest by default)
+    hid_t h5_fa_props = H5Pcreate(H5P_FILE_ACCESS);
+    
+    CONDUIT_CHECK_HDF5_ERROR(h5_fa_props,
+                             "Failed to create H5P_FILE_ACCESS "
+                             << " property list");
+    
+    
+    herr_t h5_status = H5Pset_libver_bounds(h5_fa_props,
+                  HDF5Options::hdf5_libver_from_name(h5_opts.file_libver_low),
+                  HDF5Options::hdf5_libver_from_name(h5_opts.file_libver_high));
+
+    CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                             "Failed to set libver options for "
+                             << "property list " << h5_fa_props);
+
+    // metadata and small raw data aggregation
+    if(h5_opts.file_meta_block_size > 0)
+    {
+        h5_status = H5Pset_meta_block_size(h5_fa_props,
+                                 (hsize_t)h5_opts.file_meta_block_size);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set meta block size for "
+                                 << "property list " << h5_fa_props);
+    }
+
+    if(h5_opts.file_small_data_block_size > 0)
+    {
+        h5_status = H5Pset_small_data_block_size(h5_fa_props,
+                                 (hsize_t)h5_opts.file_small_data_block_size);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set small data block size for "
+                                 << "property list " << h5_fa_props);
+    }
+
+    if(h5_opts.file_sieve_buf_size > 0)
+    {
+        h5_status = H5Pset_sieve_buf_size(h5_fa_props,
+                                 (size_t)h5_opts.file_sieve_buf_size);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set sieve buffer size for "
+                                 << "property list " << h5_fa_props);
+    }
+
+    // the file's default raw data chunk cache, used by its datasets
+    if(h5_opts.file_chunk_cache_size > 0 || 
+       h5_opts.file_chunk_cache_nslots > 0)
+    {
+        int    h5_mdc_nelmts  = 0;
+        size_t h5_rdcc_nslots = 0;
+        size_t h5_rdcc_nbytes = 0;
+        double h5_rdcc_w0     = 0.0;
+
+        h5_status = H5Pget_cache(h5_fa_props,
+                                 &h5_mdc_nelmts,
+                                 &h5_rdcc_nslots,
+                                 &h5_rdcc_nbytes,
+                                 &h5_rdcc_w0);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to get chunk cache settings for "
+                                 << "property list " << h5_fa_props);
+
+        if(h5_opts.file_chunk_cache_size > 0)
+        {
+            h5_rdcc_nbytes = (size_t)h5_opts.file_chunk_cache_size;
+        }
+
+        if(h5_opts.file_chunk_cache_nslots > 0)
+        {
+            h5_rdcc_nslots = (size_t)h5_opts.file_chunk_cache_nslots;
+        }
+
+        h5_status = H5Pset_cache(h5_fa_props,
+                                 h5_mdc_nelmts,
+                                 h5_rdcc_nslots,
+                                 h5_rdcc_nbytes,
+                                 h5_rdcc_w0);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set chunk cache settings for "
+                                 << "property list " << h5_fa_props);
+    }
+
+#if H5_VERSION_GE(1,10,1)
+    // the page buffer only applies to files created with paging
+    if(use_page_buffer && h5_opts.file_page_buffer_size > 0)
+    {
+        h5_status = H5Pset_page_buffer_size(h5_fa_props,
+                                 (size_t)h5_opts.file_page_buffer_size,
+                                 0,
+                                 0);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set page buffer size for "
+                                 << "property list " << h5_fa_props);
+    }
+#endif
+
+    return h5_fa_props;
+}
+
+//---------------------------------------------------------------------------//
+hid_t
+create_hdf5_file_create_plist()
+{
     // create property list and set it to preserve creation order
     hid_t h5_fc_props = H5Pcreate(H5P_FILE_CREATE);
 
@@ -1826,9 +3702,79 @@ create_hdf5_file_create_plist()
     CONDUIT_CHECK_HDF5_ERROR(h5_status,
                              "Failed to set creation order options for "
                              << "property list " << h5_fc_props);
+
+#if H5_VERSION_GE(1,10,1)
+    // file space paging, allocates (and reads) the file in pages
+    const HDF5Options &h5_opts = HDF5Options::defaults();
+
+    if(h5_opts.file_page_size > 0)
+    {
+        h5_status = H5Pset_file_space_strategy(h5_fc_props,
+                                               H5F_FSPACE_STRATEGY_PAGE,
+                                               0,  // don't persist
+                                               1); // hdf5 default threshold
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set file space strategy for "
+                                 << "property list " << h5_fc_props);
+
+        h5_status = H5Pset_file_space_page_size(h5_fc_props,
+                                       (hsize_t)h5_opts.file_page_size);
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to set file space page size for "
+                                 << "property list " << h5_fc_props);
+    }
+#endif
+
     return h5_fc_props;
 }
 
+//---------------------------------------------------------------------------//
+// opens an existing hdf5 file, using the page buffer when the file was
+// created with paging and is opened for writing. returns the hdf5 error
+// code on failure.
+//---------------------------------------------------------------------------//
+hid_t
+open_hdf5_file(const std::string &file_path,
+               unsigned int h5_flags)
+{
+    hid_t h5_file_id = -1;
+
+    // files created without paging can't be opened with a page buffer,
+    // so fall back to opening them without one.
+    // the hdf5 1.10 page buffer reads past the end of its pages for
+    // files opened read only, so only use it for read-write access.
+    if(HDF5Options::defaults().file_page_buffer_size > 0 &&
+       (h5_flags & H5F_ACC_RDWR) != 0)
+    {
+        HDF5ErrorStackSupressor supress_hdf5_errors;
+
+        hid_t h5_fa_plist = create_hdf5_file_access_plist(true);
+        h5_file_id = H5Fopen(file_path.c_str(),
+                             h5_flags,
+                             h5_fa_plist);
+
+        CONDUIT_CHECK_HDF5_ERROR(H5Pclose(h5_fa_plist),
+                                 "Failed to close HDF5 H5P_FILE_ACCESS "
+                                 << "property list: " << h5_fa_plist);
+    }
+
+    if(h5_file_id < 0)
+    {
+        hid_t h5_fa_plist = create_hdf5_file_access_plist(false);
+        h5_file_id = H5Fopen(file_path.c_str(),
+                             h5_flags,
+                             h5_fa_plist);
+
+        CONDUIT_CHECK_HDF5_ERROR(H5Pclose(h5_fa_plist),
+                                 "Failed to close HDF5 H5P_FILE_ACCESS "
+                                 << "property list: " << h5_fa_plist);
+    }
+
+    return h5_file_id;
+}
+
 //---------------------------------------------------------------------------//
 //---------------------------------------------------------------------------//
 //---------------------------------------------------------------------------//
@@ -1842,7 +3788,9 @@ hid_t
 hdf5_create_file(const std::string &file_path)
 {
     hid_t h5_fc_plist = create_hdf5_file_create_plist();
-    hid_t h5_fa_plist = create_hdf5_file_access_plist();
+    // the page buffer requires paging, which is set at creation
+    hid_t h5_fa_plist = create_hdf5_file_access_plist(
+                            HDF5Options::defaults().file_page_size > 0);
 
     // open the hdf5 file for writing
     hid_t h5_file_id = H5Fcreate(file_path.c_str(),
@@ -1879,6 +3827,17 @@ hdf5_close_file(hid_t hdf5_id)
 void 
 hdf5_write(const  Node &node,
            const std::string &path)
+{
+    hdf5_write(node,
+               path,
+               hdf5_no_opts());
+}
+
+//---------------------------------------------------------------------------//
+void 
+hdf5_write(const  Node &node,
+           const std::string &path,
+           const Node &opts)
 {
     // check for ":" split
     std::string file_path;
@@ -1898,7 +3857,8 @@ hdf5_write(const  Node &node,
 
     hdf5_write(node,
                file_path,
-               hdf5_path);
+               hdf5_path,
+               opts);
 }
 
 
@@ -1908,16 +3868,61 @@ hdf5_write(const Node &node,
            const std::string &file_path,
            const std::string &hdf5_path)
 {
-    // open the hdf5 file for writing
-    hid_t h5_file_id = hdf5_create_file(file_path);
-
     hdf5_write(node,
-               h5_file_id,
-               hdf5_path);
+               file_path,
+               hdf5_path,
+               hdf5_no_opts());
+}
 
-    // close the hdf5 file
-    CONDUIT_CHECK_HDF5_ERROR(H5Fclose(h5_file_id),
-                             "Error closing HDF5 file: " << file_path);
+//---------------------------------------------------------------------------//
+void
+hdf5_write(const Node &node,
+           const std::string &file_path,
+           const std::string &hdf5_path,
+           const Node &opts)
+{
+    std::string truncate_opt = "";
+    if(opts.has_child("truncate"))
+    {
+        truncate_opt = opts.fetch_child("truncate").as_string();
+    }
+
+    // partial writes and truncate: "false" update an existing file, 
+    // otherwise we create (or truncate) the file
+    bool truncate = !hdf5_write_opts_partial(opts) &&
+                    truncate_opt != "false";
+
+    // writes to a subtree of a file the cache holds open for writing
+    // reuse that handle, unless asked to truncate
+    bool subtree = hdf5_path.find_first_not_of("/") != std::string::npos;
+    bool reuse_writable = subtree && truncate_opt != "true";
+
+    HDF5FileCache &file_cache = HDF5FileCache::instance();
+
+    hid_t h5_file_id = file_cache.open_for_write(file_path,
+                                                 truncate,
+                                                 reuse_writable);
+
+    try
+    {
+        hdf5_write(node,
+                   h5_file_id,
+                   hdf5_path,
+                   opts);
+    }
+    catch(...)
+    {
+        // close the hdf5 file (unless it is cached)
+        file_cache.release(file_path,
+                           h5_file_id,
+                           false);
+        throw;
+    }
+
+    // close (or flush) the hdf5 file
+    file_cache.release(file_path,
+                       h5_file_id,
+                       true);
 }
 
 
@@ -1926,6 +3931,19 @@ void
 hdf5_write(const Node &node,
            hid_t hdf5_id,
            const std::string &hdf5_path)
+{
+    hdf5_write(node,
+               hdf5_id,
+               hdf5_path,
+               hdf5_no_opts());
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_write(const Node &node,
+           hid_t hdf5_id,
+           const std::string &hdf5_path,
+           const Node &opts)
 {
     // disable hdf5 error stack
     HDF5ErrorStackSupressor supress_hdf5_errors;
@@ -1967,11 +3985,33 @@ hdf5_write(const Node &node,
     // revisit if this is too slow
     
     Node n;
+    // per-subtree overrides are relative to the node, 
+    // so they move with it
+    Node n_opts;
+    const Node *opts_ptr = &opts;
+
     if(path.size() > 0)
     {
         // strong dose of evil casting, but it's ok b/c we are grownups here?
         // time we will tell ...
         n.fetch(path).set_external(const_cast<Node&>(node));
+
+        if(opts.has_child("overrides"))
+        {
+            NodeConstIterator itr = opts.children();
+            while(itr.has_next())
+            {
+                const Node &opt = itr.next();
+                if(itr.name() != "overrides")
+                {
+                    n_opts[itr.name()].set_external(const_cast<Node&>(opt));
+                }
+            }
+
+            n_opts["overrides"].fetch(path).set_external(
+                        const_cast<Node&>(opts.fetch_child("overrides")));
+            opts_ptr = &n_opts;
+        }
     }
     else
     {
@@ -1983,10 +4023,11 @@ hdf5_write(const Node &node,
     // check compat
     if(check_if_conduit_node_is_compatible_with_hdf5_tree(n,
                                                           "",
+                                                          *opts_ptr,
                                                           hdf5_id))
     {
         // write if we are compat
-        write_conduit_node_to_hdf5_tree(n,"",hdf5_id);
+        write_conduit_node_to_hdf5_tree(n,"",*opts_ptr,hdf5_id);
     }
     else
     {
@@ -2002,6 +4043,17 @@ hdf5_write(const Node &node,
 void
 hdf5_write(const Node &node,
            hid_t hdf5_id)
+{
+    hdf5_write(node,
+               hdf5_id,
+               hdf5_no_opts());
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_write(const Node &node,
+           hid_t hdf5_id,
+           const Node &opts)
 {
     // disable hdf5 error stack
     // TODO: we may only need to use this in an outer level variant
@@ -2011,11 +4063,13 @@ hdf5_write(const Node &node,
     // check compat
     if(check_if_conduit_node_is_compatible_with_hdf5_tree(node,
                                                           "",
+                                                          opts,
                                                           hdf5_id))
     {
         // write if we are compat
         write_conduit_node_to_hdf5_tree(node,
                                         "",
+                                        opts,
                                         hdf5_id);
     }
     else
@@ -2040,20 +4094,13 @@ hdf5_write(const Node &node,
 hid_t
 hdf5_open_file_for_read(const std::string &file_path)
 {
-    hid_t h5_fa_plist = create_hdf5_file_access_plist();
-    
     // open the hdf5 file for reading
-    hid_t h5_file_id = H5Fopen(file_path.c_str(),
-                               H5F_ACC_RDONLY,
-                               h5_fa_plist);
+    hid_t h5_file_id = open_hdf5_file(file_path,
+                                      H5F_ACC_RDONLY);
 
     CONDUIT_CHECK_HDF5_ERROR(h5_file_id,
                              "Error opening HDF5 file for reading: " 
                               << file_path);
-
-    CONDUIT_CHECK_HDF5_ERROR(H5Pclose(h5_fa_plist),
-                             "Failed to close HDF5 H5P_FILE_ACCESS "
-                             << "property list: " << h5_fa_plist);
     
     return h5_file_id;
 }
@@ -2062,20 +4109,13 @@ hdf5_open_file_for_read(const std::string &file_path)
 hid_t
 hdf5_open_file_for_read_write(const std::string &file_path)
 {
-    hid_t h5_fa_plist = create_hdf5_file_access_plist();
-    
     // open the hdf5 file for read + write
-    hid_t h5_file_id = H5Fopen(file_path.c_str(),
-                               H5F_ACC_RDWR,
-                               h5_fa_plist);
+    hid_t h5_file_id = open_hdf5_file(file_path,
+                                      H5F_ACC_RDWR);
 
     CONDUIT_CHECK_HDF5_ERROR(h5_file_id,
                              "Error opening HDF5 file for reading: " 
                               << file_path);
-
-    CONDUIT_CHECK_HDF5_ERROR(H5Pclose(h5_fa_plist),
-                             "Failed to close HDF5 H5P_FILE_ACCESS "
-                             << "property list: " << h5_fa_plist);
     
     return h5_file_id;
 }
@@ -2085,6 +4125,17 @@ hdf5_open_file_for_read_write(const std::string &file_path)
 void
 hdf5_read(const std::string &path,
           Node &node)
+{
+    hdf5_read(path,
+              hdf5_no_opts(),
+              node);
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_read(const std::string &path,
+          const Node &opts,
+          Node &node)
 {
     // check for ":" split
     std::string file_path;
@@ -2103,6 +4154,7 @@ hdf5_read(const std::string &path,
     
     hdf5_read(file_path,
               hdf5_path,
+              opts,
               node);
 }
 
@@ -2113,26 +4165,83 @@ hdf5_read(const std::string &file_path,
           const std::string &hdf5_path,
           Node &node)
 {
-    // open the hdf5 file for reading
-    hid_t h5_file_id = hdf5_open_file_for_read(file_path);
-
-    hdf5_read(h5_file_id,
+    hdf5_read(file_path,
               hdf5_path,
+              hdf5_no_opts(),
               node);
-    
-    // close the hdf5 file
-    CONDUIT_CHECK_HDF5_ERROR(H5Fclose(h5_file_id),
-                             "Error closing HDF5 file: " << file_path);
 }
+
 //---------------------------------------------------------------------------//
 void
-hdf5_read(hid_t hdf5_id,
+hdf5_read(const std::string &file_path,
           const std::string &hdf5_path,
-          Node &dest)
+          const Node &opts,
+          Node &node)
+{
+    HDF5FileCache &file_cache = HDF5FileCache::instance();
+
+    // open the hdf5 file for reading
+    hid_t h5_file_id = file_cache.open_for_read(file_path);
+
+    try
+    {
+        hdf5_read(h5_file_id,
+                  hdf5_path,
+                  opts,
+                  node);
+    }
+    catch(...)
+    {
+        file_cache.release(file_path,
+                           h5_file_id,
+                           false);
+        throw;
+    }
+    
+    // close the hdf5 file (unless it is cached)
+    file_cache.release(file_path,
+                       h5_file_id,
+                       false);
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_read(hid_t hdf5_id,
+          const std::string &hdf5_path,
+          Node &dest)
+{
+    hdf5_read(hdf5_id,
+              hdf5_path,
+              hdf5_no_opts(),
+              dest);
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_read(hid_t hdf5_id,
+          const std::string &hdf5_path,
+          const Node &opts,
+          Node &dest)
 {
     // disable hdf5 error stack
     HDF5ErrorStackSupressor supress_hdf5_errors;
     
+    // leaves written in small_leaves "attributes" mode 
+    // are attributes of their parent group
+    hid_t h5_attr_id = open_hdf5_attribute_leaf(hdf5_id,hdf5_path);
+
+    if(h5_attr_id >= 0)
+    {
+        read_hdf5_attribute_into_conduit_node(h5_attr_id,
+                                              hdf5_path,
+                                              dest);
+
+        CONDUIT_CHECK_HDF5_ERROR(H5Aclose(h5_attr_id),
+                                 "Failed to close HDF5 Attribute: "
+                                 << h5_attr_id);
+        return;
+    }
+
     // get hdf5 object at path, then call read_hdf5_tree_into_conduit_node
     hid_t h5_child_obj  = H5Oopen(hdf5_id,
                                   hdf5_path.c_str(),
@@ -2144,6 +4253,7 @@ hdf5_read(hid_t hdf5_id,
 
     read_hdf5_tree_into_conduit_node(h5_child_obj,
                                      hdf5_path,
+                                     opts,
                                      dest);
     
     CONDUIT_CHECK_HDF5_ERROR(H5Oclose(h5_child_obj),
@@ -2158,12 +4268,24 @@ hdf5_read(hid_t hdf5_id,
 void
 hdf5_read(hid_t hdf5_id,
           Node &dest)
+{
+    hdf5_read(hdf5_id,
+              hdf5_no_opts(),
+              dest);
+}
+
+//---------------------------------------------------------------------------//
+void
+hdf5_read(hid_t hdf5_id,
+          const Node &opts,
+          Node &dest)
 {
     // disable hdf5 error stack
     HDF5ErrorStackSupressor supress_hdf5_errors;
     
     read_hdf5_tree_into_conduit_node(hdf5_id,
                                      "",
+                                     opts,
                                      dest);
     
     // enable hdf5 error stack
@@ -2190,11 +4312,1554 @@ hdf5_has_path(hid_t hdf5_id,
     //    where there is an error. 
     // For our cases, we treat 0 and negative as does not exist. 
 
+    if(res <= 0)
+    {
+        // check for a leaf stored as an attribute 
+        hid_t h5_attr_id = open_hdf5_attribute_leaf(hdf5_id,hdf5_path);
+        if(h5_attr_id >= 0)
+        {
+            H5Aclose(h5_attr_id);
+            res = 1;
+        }
+    }
+
     return (res > 0);
     // enable hdf5 error stack
 }
 
 
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+// Virtual dataset index helpers
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+
+#if H5_VERSION_GE(1,10,0)
+
+//---------------------------------------------------------------------------//
+// the layout of one dataset across the source files
+//---------------------------------------------------------------------------//
+struct hdf5_virtual_source_layout
+{
+    // dims of the first non-empty source, dims[0] is replaced by the
+    // sum of all the sources' first dims
+    std::vector<hsize_t>  dims;
+    // first dim of each source (0 for empty sources)
+    std::vector<hsize_t>  rows;
+    // file dtype of the first non-empty source (-1 until found)
+    hid_t                 dtype_id;
+
+    hdf5_virtual_source_layout()
+    : dims(),
+      rows(),
+      dtype_id(-1)
+    {}
+};
+
+//---------------------------------------------------------------------------//
+// closes the dtypes held by layouts, used on success and error paths
+//---------------------------------------------------------------------------//
+static void
+release_hdf5_virtual_source_layouts(
+                        std::vector<hdf5_virtual_source_layout> &layouts)
+{
+    for(size_t i = 0; i < layouts.size(); i++)
+    {
+        if(layouts[i].dtype_id >= 0)
+        {
+            H5Tclose(layouts[i].dtype_id);
+            layouts[i].dtype_id = -1;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// paths collected by h5o_visit_collect_datasets_op_func
+//---------------------------------------------------------------------------//
+struct hdf5_virtual_index_visit_info
+{
+    // datasets below the visited group
+    std::vector<std::string> dset_paths;
+    // groups (including the visited group, as ".") that record a child
+    // order, and so may hold leaves stored as attributes
+    std::vector<std::string> child_order_group_paths;
+};
+
+//---------------------------------------------------------------------------//
+// H5Ovisit callback that collects the paths of datasets below a group
+//---------------------------------------------------------------------------//
+herr_t
+h5o_visit_collect_datasets_op_func(hid_t hdf5_id,
+                                   const char *hdf5_path,
+                                   const H5O_info_t *hdf5_info,
+                                   void *hdf5_operator_data)
+{
+    hdf5_virtual_index_visit_info *info =
+                        (hdf5_virtual_index_visit_info*)hdf5_operator_data;
+
+    if(hdf5_info->type == H5O_TYPE_DATASET)
+    {
+        info->dset_paths.push_back(std::string(hdf5_path));
+    }
+    else if(hdf5_info->type == H5O_TYPE_GROUP &&
+            H5Aexists_by_name(hdf5_id,
+                              hdf5_path,
+                              hdf5_child_order_attr_name().c_str(),
+                              H5P_DEFAULT) > 0)
+    {
+        // checked after the visit, we can't throw from here
+        info->child_order_group_paths.push_back(std::string(hdf5_path));
+    }
+
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+// returns the name of the first child of the group that is stored as an
+// attribute (small_leaves/mode "attributes"), or an empty string
+//---------------------------------------------------------------------------//
+std::string
+find_hdf5_attribute_leaf(hid_t hdf5_group_id,
+                         const std::string &ref_path)
+{
+    std::vector<std::string> child_names;
+    if(read_hdf5_child_order(hdf5_group_id,ref_path,child_names))
+    {
+        for(size_t i = 0; i < child_names.size(); i++)
+        {
+            if(H5Lexists(hdf5_group_id,
+                         child_names[i].c_str(),
+                         H5P_DEFAULT) <= 0 &&
+               H5Aexists(hdf5_group_id,child_names[i].c_str()) > 0)
+            {
+                return child_names[i];
+            }
+        }
+    }
+    return std::string();
+}
+
+//---------------------------------------------------------------------------//
+// strips leading and trailing slashes
+//---------------------------------------------------------------------------//
+std::string
+hdf5_virtual_index_trim_path(const std::string &hdf5_path)
+{
+    std::string::size_type start = hdf5_path.find_first_not_of('/');
+    if(start == std::string::npos)
+    {
+        return std::string();
+    }
+    std::string::size_type end = hdf5_path.find_last_not_of('/');
+    return hdf5_path.substr(start,end - start + 1);
+}
+
+//---------------------------------------------------------------------------//
+// expands the given paths (datasets or groups) into dataset paths,
+// using the tree of the given source file
+//---------------------------------------------------------------------------//
+void
+expand_hdf5_virtual_index_paths(hid_t hdf5_file_id,
+                                const std::string &file_path,
+                                const std::vector<std::string> &hdf5_paths,
+                                std::vector<std::string> &dset_paths)
+{
+    dset_paths.clear();
+
+    for(size_t i = 0; i < hdf5_paths.size(); i++)
+    {
+        std::string path = hdf5_virtual_index_trim_path(hdf5_paths[i]);
+        std::string h5_path = path.empty() ? std::string("/") : path;
+
+        H5O_info_t h5_info_buf;
+        herr_t h5_status = H5Oget_info_by_name(hdf5_file_id,
+                                               h5_path.c_str(),
+                                               &h5_info_buf,
+                                               H5P_DEFAULT);
+
+        if(h5_status < 0)
+        {
+            // virtual datasets can only map datasets
+            hid_t h5_attr_id = open_hdf5_attribute_leaf(hdf5_file_id,h5_path);
+            if(h5_attr_id >= 0)
+            {
+                H5Aclose(h5_attr_id);
+                CONDUIT_ERROR("HDF5 path is a leaf stored as an attribute"
+                              " (small_leaves/mode \"attributes\"),"
+                              " it can't be added to a virtual index: "
+                              << file_path << ":" << h5_path);
+            }
+        }
+
+        CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                 "Failed to find HDF5 path: "
+                                 << file_path << ":" << h5_path);
+
+        if(h5_info_buf.type == H5O_TYPE_DATASET)
+        {
+            dset_paths.push_back(path);
+        }
+        else if(h5_info_buf.type == H5O_TYPE_GROUP)
+        {
+            hid_t h5_group_id = H5Gopen(hdf5_file_id,
+                                        h5_path.c_str(),
+                                        H5P_DEFAULT);
+
+            CONDUIT_CHECK_HDF5_ERROR(h5_group_id,
+                                     "Failed to open HDF5 Group: "
+                                     << file_path << ":" << h5_path);
+
+            hdf5_virtual_index_visit_info visit_info;
+            h5_status = H5Ovisit(h5_group_id,
+                                 H5_INDEX_NAME,
+                                 H5_ITER_INC,
+                                 h5o_visit_collect_datasets_op_func,
+                                 (void *) &visit_info);
+
+            // leaves stored as attributes can't be mapped, fail instead
+            // of leaving them out of the index
+            std::string attr_leaf_path;
+            for(size_t j = 0;
+                h5_status >= 0 && attr_leaf_path.empty() &&
+                j < visit_info.child_order_group_paths.size();
+                j++)
+            {
+                const std::string &grp_path =
+                                        visit_info.child_order_group_paths[j];
+                hid_t h5_sub_group_id = H5Gopen(h5_group_id,
+                                                grp_path.c_str(),
+                                                H5P_DEFAULT);
+                if(h5_sub_group_id < 0)
+                {
+                    continue;
+                }
+
+                std::string grp_ref_path = grp_path == "." ? path :
+                                           join_ref_paths(path,grp_path);
+                std::string leaf_name;
+                try
+                {
+                    leaf_name = find_hdf5_attribute_leaf(h5_sub_group_id,
+                                                         grp_ref_path);
+                }
+                catch(conduit::Error &)
+                {
+                    H5Gclose(h5_sub_group_id);
+                    H5Gclose(h5_group_id);
+                    throw;
+                }
+
+                H5Gclose(h5_sub_group_id);
+
+                if(!leaf_name.empty())
+                {
+                    attr_leaf_path = join_ref_paths(grp_ref_path,leaf_name);
+                }
+            }
+
+            CONDUIT_CHECK_HDF5_ERROR(H5Gclose(h5_group_id),
+                                     "Failed to close HDF5 Group: "
+                                     << h5_group_id);
+
+            CONDUIT_CHECK_HDF5_ERROR(h5_status,
+                                     "Failed to visit HDF5 Group: "
+                                     << file_path << ":" << h5_path);
+
+            if(!attr_leaf_path.empty())
+            {
+                CONDUIT_ERROR("HDF5 Group " << file_path << ":" << h5_path
+                              << " holds a leaf stored as an attribute"
+                              << " (small_leaves/mode \"attributes\"),"
+                              << " it can't be added to a virtual index: "
+                              << attr_leaf_path);
+            }
+
+            for(size_t j = 0; j < visit_info.dset_paths.size(); j++)
+            {
+                dset_paths.push_back(join_ref_paths(path,
+                                                visit_info.dset_paths[j]));
+            }
+        }
+        else
+        {
+            CONDUIT_ERROR("HDF5 path is not a group or dataset: "
+                          << file_path << ":" << h5_path);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+// adds the layout of the dataset in one source file to the layout
+// of the virtual dataset
+//---------------------------------------------------------------------------//
+void
+add_hdf5_virtual_source_layout(hid_t hdf5_file_id,
+                               const std::string &file_path,
+                               const std::string &dset_path,
+                               hdf5_virtual_source_layout &layout)
+{
+    hid_t h5_dset_id = H5Dopen(hdf5_file_id,
+                               dset_path.c_str(),
+                               H5P_DEFAULT);
+
+    CONDUIT_CHECK_HDF5_ERROR(h5_dset_id,
+                             "Failed to open HDF5 Dataset: "
+                             << file_path << ":" << dset_path);
+
+    hid_t h5_dspace_id = H5Dget_space(h5_dset_id);
+    CONDUIT_CHECK_HDF5_ERROR(h5_dspace_id,
+                             "Failed to get HDF5 Dataspace: "
+                             << file_path << ":" << dset_path);
+
+    hsize_t rows = 0;
+
+    // conduit empty leaves have a null dataspace and add no rows
+    if(H5Sget_simple_extent_type(h5_dspace_id) != H5S_NULL)
+    {
+        int rank = H5Sget_simple_extent_ndims(h5_dspace_id);
+        if(rank < 1)
+        {
+            CONDUIT_ERROR("Cannot concatenate scalar HDF5 Dataset: "
+                          << file_path << ":" << dset_path);
+        }
+
+        std::vector<hsize_t> dims(rank,0);
+        H5Sget_simple_extent_dims(h5_dspace_id,&dims[0],NULL);
+        rows = dims[0];
+
+        hid_t h5_dtype_id = H5Dget_type(h5_dset_id);
+        CONDUIT_CHECK_HDF5_ERROR(h5_dtype_id,
+                                 "Failed to get HDF5 Datatype: "
+                                 << file_path << ":" << dset_path);
+
+        if(layout.dtype_id < 0)
+        {
+            layout.dims     = dims;
+            layout.dtype_id = h5_dtype_id;
+        }
+        else
+        {
+            // the dtype and all but the first dim must match
+            bool match = H5Tequal(layout.dtype_id,h5_dtype_id) > 0 &&
+                         layout.dims.size() == dims.size();
+
+            for(size_t i = 1; match && i < dims.size(); i++)
+            {
+                match = (layout.dims[i] == dims[i]);
+            }
+
+            CONDUIT_CHECK_HDF5_ERROR(H5Tclose(h5_dtype_id),
+                                     "Failed to close HDF5 Datatype: "
+                                     << h5_dtype_id);
+
+            if(!match)
+            {
+                CONDUIT_ERROR("HDF5 Dataset "
+                              << file_path << ":" << dset_path
+                              << " doesn't match the dtype or shape of"
+                              << " earlier sources");
+            }
+        }
+    }
+
+    layout.rows.push_back(rows);
+
+    CONDUIT_CHECK_HDF5_ERROR(H5Sclose(h5_dspace_id),
+                             "Failed to close HDF5 Dataspace: "
+                             << h5_dspace_id);
+
+    CONDUIT_CHECK_HDF5_ERROR(H5Dclose(h5_dset_id),
+                             "Failed to close HDF5 Dataset: "
+                             << h5_dset_id);
+}
+
+//---------------------------------------------------------------------------//
+// creates a virtual dataset that maps the sources into one dataset,
+// concatenated along the first dim
+//---------------------------------------------------------------------------//
+void
+create_hdf5_virtual_dataset(hid_t hdf5_index_id,
+                            const std::string &dset_path,
+                            const std::vector<std::string> &source_file_paths,
+                            hdf5_virtual_source_layout &layout)
+{
+    std::vector<hsize_t> dims = layout.dims;
+    std::vector<int64>   offsets(layout.rows.size() + 1, 0);
+
+    dims[0] = 0;
+    for(size_t i = 0; i < layout.rows.size(); i++)
+    {
+        dims[0] += layout.rows[i];
+        offsets[i+1] = (int64)dims[0];
+    }
+
+    int rank = (int)dims.size();
+    hid_t h5_vspace_id = H5Screate_simple(rank,&dims[0],NULL);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_vspace_id,
+                                           dset_path,
+                                  "Failed to create HDF5 virtual Dataspace");
+
+    hid_t h5_cprops_id = H5Pcreate(H5P_DATASET_CREATE);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_cprops_id,
+                                           dset_path,
+                                  "Failed to create HDF5 property list");
+
+    std::vector<hsize_t> start(rank,0);
+    std::vector<hsize_t> count = layout.dims;
+
+    for(size_t i = 0; i < layout.rows.size(); i++)
+    {
+        if(layout.rows[i] == 0)
+        {
+            continue;
+        }
+
+        // the source's rows go after the rows of earlier sources
+        start[0] = (hsize_t)offsets[i];
+        count[0] = layout.rows[i];
+
+        hid_t h5_src_dspace_id = H5Screate_simple(rank,&count[0],NULL);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_src_dspace_id,
+                                               dset_path,
+                                  "Failed to create HDF5 source Dataspace");
+
+        herr_t h5_status = H5Sselect_hyperslab(h5_vspace_id,
+                                               H5S_SELECT_SET,
+                                               &start[0],
+                                               NULL,
+                                               &count[0],
+                                               NULL);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                               dset_path,
+                                  "Failed to select HDF5 virtual hyperslab");
+
+        h5_status = H5Pset_virtual(h5_cprops_id,
+                                   h5_vspace_id,
+                                   source_file_paths[i].c_str(),
+                                   dset_path.c_str(),
+                                   h5_src_dspace_id);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_status,
+                                               dset_path,
+                                  "Failed to add HDF5 virtual source: "
+                                  << source_file_paths[i]);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_src_dspace_id),
+                                               dset_path,
+                                  "Failed to close HDF5 source Dataspace");
+    }
+
+    // the mappings copy their selections, reset ours
+    H5Sselect_all(h5_vspace_id);
+
+    hid_t h5_dset_id = H5Dcreate(hdf5_index_id,
+                                 dset_path.c_str(),
+                                 layout.dtype_id,
+                                 h5_vspace_id,
+                                 H5P_DEFAULT,
+                                 h5_cprops_id,
+                                 H5P_DEFAULT);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dset_id,
+                                           dset_path,
+                                  "Failed to create HDF5 virtual Dataset");
+
+    // record where each source's rows start
+    hsize_t h5_num_offsets = (hsize_t)offsets.size();
+    hid_t h5_attr_dspace_id = H5Screate_simple(1,&h5_num_offsets,NULL);
+    hid_t h5_attr_id = H5Acreate(h5_dset_id,
+                                 "conduit_source_offsets",
+                                 H5T_STD_I64LE,
+                                 h5_attr_dspace_id,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT);
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_attr_id,
+                                           dset_path,
+                                  "Failed to create HDF5 Attribute");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Awrite(h5_attr_id,
+                                                    H5T_NATIVE_INT64,
+                                                    &offsets[0]),
+                                           dset_path,
+                                  "Failed to write HDF5 Attribute");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Aclose(h5_attr_id),
+                                           dset_path,
+                                  "Failed to close HDF5 Attribute");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_attr_dspace_id),
+                                           dset_path,
+                                  "Failed to close HDF5 Dataspace");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Dclose(h5_dset_id),
+                                           dset_path,
+                                  "Failed to close HDF5 virtual Dataset");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Pclose(h5_cprops_id),
+                                           dset_path,
+                                  "Failed to close HDF5 property list");
+
+    CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Sclose(h5_vspace_id),
+                                           dset_path,
+                                  "Failed to close HDF5 virtual Dataspace");
+}
+
+#endif
+
+//---------------------------------------------------------------------------//
+void
+hdf5_create_virtual_index(const std::string &index_file_path,
+                          const std::vector<std::string> &source_file_paths,
+                          const std::vector<std::string> &hdf5_paths)
+{
+#if !H5_VERSION_GE(1,10,0)
+    CONDUIT_ERROR("hdf5_create_virtual_index: HDF5 virtual datasets require"
+                  " HDF5 1.10.0 or newer");
+#else
+    if(source_file_paths.empty())
+    {
+        CONDUIT_ERROR("hdf5_create_virtual_index: no source files given");
+    }
+
+    // disable hdf5 error stack
+    HDF5ErrorStackSupressor supress_hdf5_errors;
+
+    // all the sources are expected to hold the same tree, so we use
+    // the first source to find the datasets below the given paths
+    std::vector<std::string> dset_paths;
+
+    std::vector<std::string> paths = hdf5_paths;
+    if(paths.empty())
+    {
+        paths.push_back("/");
+    }
+
+    std::vector<hdf5_virtual_source_layout> layouts;
+
+    for(size_t i = 0; i < source_file_paths.size(); i++)
+    {
+        const std::string &file_path = source_file_paths[i];
+        hid_t h5_file_id = hdf5_open_file_for_read(file_path);
+
+        try
+        {
+            if(i == 0)
+            {
+                expand_hdf5_virtual_index_paths(h5_file_id,
+                                                file_path,
+                                                paths,
+                                                dset_paths);
+
+                layouts.resize(dset_paths.size());
+            }
+
+            for(size_t j = 0; j < dset_paths.size(); j++)
+            {
+                add_hdf5_virtual_source_layout(h5_file_id,
+                                               file_path,
+                                               dset_paths[j],
+                                               layouts[j]);
+            }
+        }
+        catch(conduit::Error &)
+        {
+            H5Fclose(h5_file_id);
+            release_hdf5_virtual_source_layouts(layouts);
+            throw;
+        }
+
+        hdf5_close_file(h5_file_id);
+    }
+
+    for(size_t i = 0; i < dset_paths.size(); i++)
+    {
+        if(layouts[i].dtype_id < 0)
+        {
+            release_hdf5_virtual_source_layouts(layouts);
+            CONDUIT_ERROR("hdf5_create_virtual_index: HDF5 Dataset "
+                          << dset_paths[i] << " is empty in all sources");
+        }
+    }
+
+    // create the index file, and the groups that hold the datasets
+    hid_t h5_index_id = -1;
+
+    try
+    {
+        h5_index_id = hdf5_create_file(index_file_path);
+
+        Node n_groups;
+        for(size_t i = 0; i < dset_paths.size(); i++)
+        {
+            std::string dset_name;
+            std::string group_path;
+            conduit::utils::rsplit_string(dset_paths[i],"/",
+                                          dset_name,group_path);
+            if(!group_path.empty())
+            {
+                n_groups.fetch(group_path).set(DataType::object());
+            }
+        }
+
+        if(n_groups.number_of_children() > 0)
+        {
+            hdf5_write(n_groups,h5_index_id);
+        }
+
+        for(size_t i = 0; i < dset_paths.size(); i++)
+        {
+            create_hdf5_virtual_dataset(h5_index_id,
+                                        dset_paths[i],
+                                        source_file_paths,
+                                        layouts[i]);
+        }
+    }
+    catch(conduit::Error &)
+    {
+        if(h5_index_id >= 0)
+        {
+            H5Fclose(h5_index_id);
+        }
+        release_hdf5_virtual_source_layouts(layouts);
+        throw;
+    }
+
+    release_hdf5_virtual_source_layouts(layouts);
+    hdf5_close_file(h5_index_id);
+
+    // restore hdf5 error stack
+#endif
+}
+
+
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+// HDF5LazyTree
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+
+//---------------------------------------------------------------------------//
+HDF5LazyTree::HDF5LazyTree()
+: m_file_id(-1),
+  m_hdf5_path(),
+  m_schema(),
+  m_data(),
+  m_cache_budget(-1),
+  m_cached_bytes(0),
+  m_lru(),
+  m_lru_index()
+{
+    // empty
+}
+
+//---------------------------------------------------------------------------//
+HDF5LazyTree::~HDF5LazyTree()
+{
+    if(is_open())
+    {
+        // don't throw from the destructor
+        H5Fclose(m_file_id);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::open(const std::string &path)
+{
+    close();
+
+    // check for ":" split
+    std::string file_path;
+    std::string hdf5_path;
+
+    conduit::utils::split_file_path(path,
+                                    std::string(":"),
+                                    file_path,
+                                    hdf5_path);
+
+    // we will use the root if no hdf5_path is given.
+    if(hdf5_path.size() == 0)
+    {
+        hdf5_path = "/";
+    }
+
+    m_file_id   = hdf5_open_file_for_read(file_path);
+    m_hdf5_path = hdf5_path;
+
+    // disable hdf5 error stack
+    HDF5ErrorStackSupressor supress_hdf5_errors;
+
+    hid_t h5_obj_id = H5Oopen(m_file_id,
+                              m_hdf5_path.c_str(),
+                              H5P_DEFAULT);
+
+    if( h5_obj_id < 0 )
+    {
+        close();
+        CONDUIT_ERROR("Failed to fetch HDF5 object from: " << path);
+    }
+
+    // only the structure is read here, no data
+    read_hdf5_tree_into_conduit_schema(h5_obj_id,
+                                       m_hdf5_path,
+                                       m_schema);
+
+    CONDUIT_CHECK_HDF5_ERROR(H5Oclose(h5_obj_id),
+                             "Failed to close HDF5 Object: "
+                             << h5_obj_id);
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::close()
+{
+    if(is_open())
+    {
+        hdf5_close_file(m_file_id);
+        m_file_id = -1;
+    }
+
+    m_hdf5_path = "";
+    m_schema.reset();
+    evict_all();
+}
+
+//---------------------------------------------------------------------------//
+bool
+HDF5LazyTree::is_open() const
+{
+    return CONDUIT_HDF5_VALID_ID(m_file_id);
+}
+
+//---------------------------------------------------------------------------//
+const Schema &
+HDF5LazyTree::schema() const
+{
+    return m_schema;
+}
+
+//---------------------------------------------------------------------------//
+bool
+HDF5LazyTree::has_path(const std::string &path) const
+{
+    return is_open() && (path.empty() || m_schema.has_path(path));
+}
+
+//---------------------------------------------------------------------------//
+const Node &
+HDF5LazyTree::fetch(const std::string &path)
+{
+    if(!has_path(path))
+    {
+        CONDUIT_ERROR("HDF5LazyTree: cannot fetch \"" << path << "\""
+                      << (is_open() ? " (path does not exist)" :
+                                      " (tree is not open)"));
+    }
+
+    const Schema &s = path.empty() ? m_schema : m_schema.fetch(path);
+
+    std::vector<std::string> leaf_paths;
+    collect_leaves(s,path,leaf_paths);
+
+    // find how much we need to load, and make room for it
+    index_t load_bytes = 0;
+    for(size_t i=0; i < leaf_paths.size(); i++)
+    {
+        if(m_lru_index.find(leaf_paths[i]) == m_lru_index.end())
+        {
+            const Schema &leaf_schema = leaf_paths[i].empty() ? m_schema :
+                                            m_schema.fetch(leaf_paths[i]);
+            load_bytes += leaf_schema.total_bytes_compact();
+        }
+    }
+
+    evict_for(load_bytes,&path);
+
+    // disable hdf5 error stack
+    HDF5ErrorStackSupressor supress_hdf5_errors;
+
+    for(size_t i=0; i < leaf_paths.size(); i++)
+    {
+        if(m_lru_index.find(leaf_paths[i]) != m_lru_index.end())
+        {
+            touch_leaf(leaf_paths[i]);
+        }
+        else
+        {
+            const Schema &leaf_schema = leaf_paths[i].empty() ? m_schema :
+                                            m_schema.fetch(leaf_paths[i]);
+            load_leaf(leaf_paths[i],leaf_schema);
+        }
+    }
+
+    // groups without any leaves still need to show up
+    prepare_groups(s,path);
+
+    return path.empty() ? m_data : m_data.fetch(path);
+}
+
+//---------------------------------------------------------------------------//
+bool
+HDF5LazyTree::is_loaded(const std::string &path) const
+{
+    if(!has_path(path))
+    {
+        return false;
+    }
+
+    const Schema &s = path.empty() ? m_schema : m_schema.fetch(path);
+
+    std::vector<std::string> leaf_paths;
+    collect_leaves(s,path,leaf_paths);
+
+    for(size_t i=0; i < leaf_paths.size(); i++)
+    {
+        if(m_lru_index.find(leaf_paths[i]) == m_lru_index.end())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::set_cache_budget(index_t num_bytes)
+{
+    m_cache_budget = num_bytes;
+    evict_for(0,NULL);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5LazyTree::cache_budget() const
+{
+    return m_cache_budget;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5LazyTree::cached_bytes() const
+{
+    return m_cached_bytes;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5LazyTree::number_of_cached_leaves() const
+{
+    return (index_t) m_lru.size();
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::evict_all()
+{
+    m_data.reset();
+    m_lru.clear();
+    m_lru_index.clear();
+    m_cached_bytes = 0;
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::load_leaf(const std::string &path,
+                        const Schema &leaf_schema)
+{
+    std::string h5_path = m_hdf5_path;
+    if(!path.empty())
+    {
+        if(h5_path[h5_path.size()-1] != '/')
+        {
+            h5_path += "/";
+        }
+        h5_path += path;
+    }
+
+    Node &dest = path.empty() ? m_data : m_data.fetch(path);
+
+    hid_t h5_attr_id = open_hdf5_attribute_leaf(m_file_id,h5_path);
+
+    if(h5_attr_id >= 0)
+    {
+        read_hdf5_attribute_into_conduit_node(h5_attr_id,
+                                              h5_path,
+                                              dest);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Aclose(h5_attr_id),
+                                               h5_path,
+                                               "Error closing HDF5 "
+                                               << "Attribute: "
+                                               << h5_attr_id);
+    }
+    else
+    {
+        hid_t h5_dset_id = H5Dopen(m_file_id,
+                                   h5_path.c_str(),
+                                   H5P_DEFAULT);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(h5_dset_id,
+                                               h5_path,
+                                               "Error opening HDF5 Dataset");
+
+        read_hdf5_dataset_into_conduit_node(h5_dset_id,
+                                            h5_path,
+                                            hdf5_no_opts(),
+                                            dest);
+
+        CONDUIT_CHECK_HDF5_ERROR_WITH_REF_PATH(H5Dclose(h5_dset_id),
+                                               h5_path,
+                                               "Error closing HDF5 Dataset: "
+                                               << h5_dset_id);
+    }
+
+    m_lru.push_front(path);
+    m_lru_index[path] = m_lru.begin();
+    m_cached_bytes += leaf_schema.total_bytes_compact();
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::touch_leaf(const std::string &path)
+{
+    // move to the front of the lru list
+    m_lru.splice(m_lru.begin(),m_lru,m_lru_index[path]);
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::evict_for(index_t num_bytes,
+                        const std::string *keep_path)
+{
+    if(m_cache_budget < 0)
+    {
+        return;
+    }
+
+    // walk from the least recently used leaf, skipping leaves
+    // under the path we are fetching (if any)
+    std::list<std::string>::iterator itr = m_lru.end();
+
+    while( itr != m_lru.begin() && 
+           m_cached_bytes + num_bytes > m_cache_budget)
+    {
+        --itr;
+        const std::string &leaf_path = *itr;
+
+        if(keep_path != NULL && 
+           ( keep_path->empty() ||
+             leaf_path == *keep_path ||
+             ( leaf_path.size() > keep_path->size() &&
+               leaf_path.compare(0,keep_path->size(),*keep_path) == 0 &&
+               leaf_path[keep_path->size()] == '/' ) ) )
+        {
+            continue;
+        }
+
+        const Schema &leaf_schema = leaf_path.empty() ? m_schema :
+                                    m_schema.fetch(leaf_path);
+        m_cached_bytes -= leaf_schema.total_bytes_compact();
+
+        if(leaf_path.empty())
+        {
+            m_data.reset();
+        }
+        else
+        {
+            m_data.remove(leaf_path);
+        }
+
+        m_lru_index.erase(leaf_path);
+        itr = m_lru.erase(itr);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::collect_leaves(const Schema &schema,
+                             const std::string &path,
+                             std::vector<std::string> &paths) const
+{
+    if(schema.dtype().is_object())
+    {
+        const std::vector<std::string> &names = schema.child_names();
+        for(index_t i=0; i < schema.number_of_children(); i++)
+        {
+            collect_leaves(schema.child(i),
+                           join_ref_paths(path,names[i]),
+                           paths);
+        }
+    }
+    else
+    {
+        paths.push_back(path);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5LazyTree::prepare_groups(const Schema &schema,
+                             const std::string &path)
+{
+    if(!schema.dtype().is_object())
+    {
+        return;
+    }
+
+    Node &n = path.empty() ? m_data : m_data.fetch(path);
+    if(!n.dtype().is_object())
+    {
+        n.set(DataType::object());
+    }
+
+    const std::vector<std::string> &names = schema.child_names();
+    for(index_t i=0; i < schema.number_of_children(); i++)
+    {
+        prepare_groups(schema.child(i),
+                       join_ref_paths(path,names[i]));
+    }
+}
+
+
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+// HDF5AsyncWriter
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+//---------------------------------------------------------------------------//
+
+//-----------------------------------------------------------------------------
+// Private class that holds the queue and i/o thread for HDF5AsyncWriter.
+//
+// One mutex guards the queue and the write states, and one condition
+// signals all changes: new requests for the i/o thread, completed
+// writes and queue space for the callers.
+//-----------------------------------------------------------------------------
+class HDF5AsyncWriterImpl
+{
+public:
+    HDF5AsyncWriterImpl();
+   ~HDF5AsyncWriterImpl();
+
+    index_t submit(const Node &node,
+                   const std::string &path,
+                   const Node &opts,
+                   bool external);
+
+    bool    test(index_t handle);
+    void    wait(index_t handle);
+    void    wait_all();
+
+    void    set_max_pending(index_t max_pending);
+    index_t max_pending() const;
+    index_t number_of_pending_writes() const;
+
+private:
+    struct Request
+    {
+        index_t      handle;
+        Node         node;
+        std::string  path;
+        Node         opts;
+    };
+
+    void    lock() const;
+    void    unlock() const;
+    void    wait_for_change();
+    void    notify_change();
+
+    // removes and returns the error for a completed write ("" if none)
+    std::string take_error(index_t handle);
+
+    static void execute(const Request &req,
+                        std::string &error_msg);
+
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    static void *thread_main(void *impl);
+    void    run();
+#endif
+
+    std::list<Request*>              m_queue;
+    // queued or in progress writes
+    std::set<index_t>                m_pending;
+    // failed writes that haven't been reported
+    std::map<index_t,std::string>    m_errors;
+
+    index_t                          m_next_handle;
+    index_t                          m_max_pending;
+    bool                             m_stop;
+    bool                             m_thread_started;
+
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    mutable pthread_mutex_t          m_mutex;
+    pthread_cond_t                   m_cond;
+    pthread_t                        m_thread;
+#endif
+};
+
+//---------------------------------------------------------------------------//
+HDF5AsyncWriterImpl::HDF5AsyncWriterImpl()
+: m_queue(),
+  m_pending(),
+  m_errors(),
+  m_next_handle(0),
+  m_max_pending(2),
+  m_stop(false),
+  m_thread_started(false)
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    pthread_mutex_init(&m_mutex,NULL);
+    pthread_cond_init(&m_cond,NULL);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+HDF5AsyncWriterImpl::~HDF5AsyncWriterImpl()
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    // the i/o thread finishes the queued writes before it exits
+    lock();
+    m_stop = true;
+    notify_change();
+    unlock();
+
+    if(m_thread_started)
+    {
+        pthread_join(m_thread,NULL);
+    }
+
+    pthread_cond_destroy(&m_cond);
+    pthread_mutex_destroy(&m_mutex);
+#endif
+
+    if(!m_errors.empty())
+    {
+        CONDUIT_INFO("HDF5AsyncWriter: " << m_errors.size()
+                     << " failed write(s) were not reported");
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::lock() const
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    pthread_mutex_lock(&m_mutex);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::unlock() const
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    pthread_mutex_unlock(&m_mutex);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::wait_for_change()
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    pthread_cond_wait(&m_cond,&m_mutex);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::notify_change()
+{
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    pthread_cond_broadcast(&m_cond);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::execute(const Request &req,
+                             std::string &error_msg)
+{
+    error_msg.clear();
+    try
+    {
+        hdf5_write(req.node,
+                   req.path,
+                   req.opts);
+    }
+    catch(conduit::Error &e)
+    {
+        error_msg = e.message();
+    }
+    catch(std::exception &e)
+    {
+        error_msg = e.what();
+    }
+    catch(...)
+    {
+        error_msg = "unknown error";
+    }
+}
+
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+//---------------------------------------------------------------------------//
+void *
+HDF5AsyncWriterImpl::thread_main(void *impl)
+{
+    ((HDF5AsyncWriterImpl*)impl)->run();
+    return NULL;
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::run()
+{
+    lock();
+    while(true)
+    {
+        while(m_queue.empty() && !m_stop)
+        {
+            wait_for_change();
+        }
+
+        if(m_queue.empty())
+        {
+            // stopping, and all writes are done
+            break;
+        }
+
+        Request *req = m_queue.front();
+        m_queue.pop_front();
+        unlock();
+
+        std::string error_msg;
+        execute(*req,error_msg);
+
+        lock();
+        m_pending.erase(req->handle);
+        if(!error_msg.empty())
+        {
+            m_errors[req->handle] = error_msg;
+        }
+        notify_change();
+
+        delete req;
+    }
+    unlock();
+}
+#endif
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriterImpl::submit(const Node &node,
+                            const std::string &path,
+                            const Node &opts,
+                            bool external)
+{
+    // snapshot the request on the calling thread, before taking the lock.
+    // the handle is reserved and the request queued under a single lock
+    // hold below, so the queue order always matches the handle order,
+    // even with several submitting threads
+    Request *req = new Request();
+    try
+    {
+        if(external)
+        {
+            req->node.set_external(const_cast<Node&>(node));
+        }
+        else
+        {
+            req->node.set(node);
+        }
+        req->path = path;
+        req->opts.set(opts);
+    }
+    catch(...)
+    {
+        delete req;
+        throw;
+    }
+
+    lock();
+
+    while((index_t)m_pending.size() >= m_max_pending)
+    {
+        wait_for_change();
+    }
+
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    if(!m_thread_started)
+    {
+        if(pthread_create(&m_thread,
+                          NULL,
+                          HDF5AsyncWriterImpl::thread_main,
+                          this) != 0)
+        {
+            unlock();
+            delete req;
+            CONDUIT_ERROR("HDF5AsyncWriter: failed to start i/o thread");
+        }
+        m_thread_started = true;
+    }
+#endif
+
+    index_t handle = m_next_handle++;
+    m_pending.insert(handle);
+    req->handle = handle;
+
+#if defined(CONDUIT_RELAY_HDF5_ASYNC_USE_PTHREADS)
+    m_queue.push_back(req);
+    notify_change();
+    unlock();
+#else
+    // no thread support, write now
+    std::string error_msg;
+    execute(*req,error_msg);
+    m_pending.erase(handle);
+    if(!error_msg.empty())
+    {
+        m_errors[handle] = error_msg;
+    }
+    delete req;
+    unlock();
+#endif
+
+    return handle;
+}
+
+//---------------------------------------------------------------------------//
+std::string
+HDF5AsyncWriterImpl::take_error(index_t handle)
+{
+    std::string res;
+    std::map<index_t,std::string>::iterator itr = m_errors.find(handle);
+    if(itr != m_errors.end())
+    {
+        res = itr->second;
+        m_errors.erase(itr);
+    }
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+bool
+HDF5AsyncWriterImpl::test(index_t handle)
+{
+    lock();
+    if(handle < 0 || handle >= m_next_handle)
+    {
+        unlock();
+        CONDUIT_ERROR("HDF5AsyncWriter: invalid write handle: " << handle);
+    }
+
+    if(m_pending.count(handle) > 0)
+    {
+        unlock();
+        return false;
+    }
+
+    std::string error_msg = take_error(handle);
+    unlock();
+
+    if(!error_msg.empty())
+    {
+        CONDUIT_ERROR("HDF5AsyncWriter: write " << handle << " failed: "
+                      << error_msg);
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::wait(index_t handle)
+{
+    lock();
+    if(handle < 0 || handle >= m_next_handle)
+    {
+        unlock();
+        CONDUIT_ERROR("HDF5AsyncWriter: invalid write handle: " << handle);
+    }
+
+    while(m_pending.count(handle) > 0)
+    {
+        wait_for_change();
+    }
+
+    std::string error_msg = take_error(handle);
+    unlock();
+
+    if(!error_msg.empty())
+    {
+        CONDUIT_ERROR("HDF5AsyncWriter: write " << handle << " failed: "
+                      << error_msg);
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::wait_all()
+{
+    lock();
+    while(!m_pending.empty())
+    {
+        wait_for_change();
+    }
+
+    std::map<index_t,std::string> errors;
+    errors.swap(m_errors);
+    unlock();
+
+    if(!errors.empty())
+    {
+        std::ostringstream oss;
+        std::map<index_t,std::string>::const_iterator itr;
+        for(itr = errors.begin(); itr != errors.end(); itr++)
+        {
+            oss << "\n write " << itr->first << " failed: " << itr->second;
+        }
+
+        CONDUIT_ERROR("HDF5AsyncWriter: " << errors.size()
+                      << " write(s) failed:" << oss.str());
+    }
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriterImpl::set_max_pending(index_t max_pending)
+{
+    if(max_pending < 1)
+    {
+        CONDUIT_ERROR("HDF5AsyncWriter: max pending writes must be >= 1"
+                      " (given: " << max_pending << ")");
+    }
+
+    lock();
+    m_max_pending = max_pending;
+    // a larger limit can unblock callers
+    notify_change();
+    unlock();
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriterImpl::max_pending() const
+{
+    lock();
+    index_t res = m_max_pending;
+    unlock();
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriterImpl::number_of_pending_writes() const
+{
+    lock();
+    index_t res = (index_t)m_pending.size();
+    unlock();
+    return res;
+}
+
+//---------------------------------------------------------------------------//
+HDF5AsyncWriter::HDF5AsyncWriter()
+: m_impl(new HDF5AsyncWriterImpl())
+{}
+
+//---------------------------------------------------------------------------//
+HDF5AsyncWriter::~HDF5AsyncWriter()
+{
+    delete m_impl;
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::write(const Node &node,
+                       const std::string &path)
+{
+    return m_impl->submit(node,path,hdf5_no_opts(),false);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::write(const Node &node,
+                       const std::string &path,
+                       const Node &opts)
+{
+    return m_impl->submit(node,path,opts,false);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::write_external(const Node &node,
+                                const std::string &path)
+{
+    return m_impl->submit(node,path,hdf5_no_opts(),true);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::write_external(const Node &node,
+                                const std::string &path,
+                                const Node &opts)
+{
+    return m_impl->submit(node,path,opts,true);
+}
+
+//---------------------------------------------------------------------------//
+bool
+HDF5AsyncWriter::test(index_t handle)
+{
+    return m_impl->test(handle);
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriter::wait(index_t handle)
+{
+    m_impl->wait(handle);
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriter::wait_all()
+{
+    m_impl->wait_all();
+}
+
+//---------------------------------------------------------------------------//
+void
+HDF5AsyncWriter::set_max_pending(index_t max_pending)
+{
+    m_impl->set_max_pending(max_pending);
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::max_pending() const
+{
+    return m_impl->max_pending();
+}
+
+//---------------------------------------------------------------------------//
+index_t
+HDF5AsyncWriter::number_of_pending_writes() const
+{
+    return m_impl->number_of_pending_writes();
+}
+
+
 
 }
 //-----------------------------------------------------------------------------
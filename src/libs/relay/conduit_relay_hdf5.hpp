@@ -56,6 +56,13 @@
 //-----------------------------------------------------------------------------
 #include <hdf5.h>
 
+//-----------------------------------------------------------------------------
+// standard lib includes
+//-----------------------------------------------------------------------------
+#include <list>
+#include <map>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 // conduit includes
 //-----------------------------------------------------------------------------
@@ -193,6 +200,84 @@ void CONDUIT_RELAY_API hdf5_write(const Node &node,
 void CONDUIT_RELAY_API hdf5_write(const Node &node,
                                   hid_t hdf5_id);
 
+//-----------------------------------------------------------------------------
+/// Write with options
+///
+/// These variants accept an options node that applies to this write only.
+///
+/// Storage options use the same layout as hdf5_set_options() and
+/// override the process wide defaults for the datasets this call creates:
+///
+///   compact_storage/enabled, compact_storage/threshold
+///   chunking/enabled, chunking/threshold, chunking/chunk_size
+///   chunking/compression/method, chunking/compression/level
+///   small_leaves/mode, small_leaves/threshold
+///
+/// chunking/chunk_size is the target chunk size in bytes. Each dataset is
+/// split into evenly sized chunks no larger than the target, so the
+/// number of elements per chunk follows from the leaf's element size.
+///
+/// Storage options for a subtree are given under "overrides", using paths
+/// relative to the node being written. They apply to every dataset in 
+/// that subtree:
+///
+///   overrides/fields/pressure/chunking/compression/level: 9
+///   overrides/fields/mask/chunking/compression/method: "none"
+///
+/// ("chunking", "compact_storage" and "small_leaves" are reserved in 
+///  override paths.)
+///
+/// Trees with many small leaves create many small datasets. To store them 
+/// as attributes of their parent group instead, use:
+///
+///   small_leaves/mode: "attributes"  (default: "datasets")
+///   small_leaves/threshold: N        (default: 256 bytes)
+///
+/// Number and string leaves of at most N bytes become attributes, unless
+/// a dataset already exists for them. Groups holding such leaves record 
+/// their child order in a "conduit_child_order" attribute, which
+/// hdf5_read() and HDF5LazyTree use to restore the leaves in place.
+/// Partial writes (below) always use datasets.
+///
+/// These options turn the write of each leaf into a partial write of 
+/// a 1D dataset:
+///
+///   append: "true"  add the leaf's elements to the end of the dataset
+///   offset: N       write the leaf's elements starting at element N
+///
+/// Datasets created by a partial write are chunked and extendible
+/// (unlimited max size). Writes that go past the current size of an
+/// existing dataset extend it, which requires the dataset to be
+/// extendible. The dtype of an existing dataset must match the leaf.
+///
+/// For a partial write, the file path variants open an existing file
+/// instead of truncating it. Other writes can do the same using:
+///
+///   truncate: "false"  write into an existing file (created if missing)
+///   truncate: "true"   always create (or truncate) the file
+///
+/// When the file cache (see below) holds a file open for writing, writes
+/// to a subtree of it ("file.hdf5:/group") reuse the open file unless 
+/// truncate is "true".
+//-----------------------------------------------------------------------------
+void CONDUIT_RELAY_API hdf5_write(const Node &node,
+                                  const std::string &path,
+                                  const Node &opts);
+
+void CONDUIT_RELAY_API hdf5_write(const Node &node,
+                                  const std::string &file_path,
+                                  const std::string &hdf5_path,
+                                  const Node &opts);
+
+void CONDUIT_RELAY_API hdf5_write(const Node &node,
+                                  hid_t hdf5_id,
+                                  const std::string &hdf5_path,
+                                  const Node &opts);
+
+void CONDUIT_RELAY_API hdf5_write(const Node &node,
+                                  hid_t hdf5_id,
+                                  const Node &opts);
+
 
 //-----------------------------------------------------------------------------
 /// Open a hdf5 file for reading, using conduit's selected hdf5 plists.
@@ -231,11 +316,186 @@ void CONDUIT_RELAY_API hdf5_read(hid_t hdf5_id,
                                  Node &node);
 
 //-----------------------------------------------------------------------------
-/// Read from hdf5 id into the output node
+/// Read with options
+///
+/// These variants accept an options node that selects a slab (hyperslab)
+/// of a dataset, so only the requested elements are read:
+///
+///   offset: first element to read, per dimension  (default: 0)
+///   stride: step between elements, per dimension  (default: 1)
+///   count:  number of elements, per dimension     (default: the rest)
+///
+/// Each option is an integer (1D datasets) or an integer array with one
+/// entry per dataset dimension. Multi-dimensional selections are read 
+/// in row-major order into a 1D leaf.
+///
+/// When the path refers to a group, slab options for its datasets are 
+/// given under "datasets", using the dataset paths relative to the group:
+///
+///   datasets/fields/pressure/offset: [10, 0]
+///   datasets/fields/pressure/count:  [5, 3]
+///
+/// If the output node is already a compatible leaf, the selected elements
+/// are read directly into its memory, following its stride.
 //-----------------------------------------------------------------------------
+void CONDUIT_RELAY_API hdf5_read(const std::string &path,
+                                 const Node &opts,
+                                 Node &node);
+
+void CONDUIT_RELAY_API hdf5_read(const std::string &file_path,
+                                 const std::string &hdf5_path,
+                                 const Node &opts,
+                                 Node &node);
+
 void CONDUIT_RELAY_API hdf5_read(hid_t hdf5_id,
+                                 const std::string &hdf5_path,
+                                 const Node &opts,
                                  Node &node);
 
+void CONDUIT_RELAY_API hdf5_read(hid_t hdf5_id,
+                                 const Node &opts,
+                                 Node &node);
+
+//-----------------------------------------------------------------------------
+/// HDF5LazyTree provides on demand access to an hdf5 tree.
+///
+/// open() reads only the group and dataset structure (names, dtypes and 
+/// number of elements) into a Schema. Leaf data is read from the file
+/// the first time it is fetched, and kept in memory for later fetches.
+///
+/// A cache budget (in bytes) limits the memory used for loaded leaves.
+/// When loading a leaf would go over the budget, the least recently 
+/// fetched leaves are evicted. The budget is a soft limit: the path
+/// being fetched is always loaded, even if it alone is over the budget.
+///
+/// Node references returned by fetch() stay valid until a later fetch 
+/// evicts them, evict_all() is called, or the tree is closed.
+///
+//-----------------------------------------------------------------------------
+class CONDUIT_RELAY_API HDF5LazyTree
+{
+public:
+    HDF5LazyTree();
+   ~HDF5LazyTree();
+
+    /// opens a file system and hdf5 path, joined using a ":"
+    ///  ex: "/path/on/file/system.hdf5:/path/inside/hdf5/file"
+    void            open(const std::string &path);
+    void            close();
+    bool            is_open() const;
+
+    /// the structure of the tree, leaves describe the data as it will be
+    /// read (no data is loaded to provide this)
+    const Schema   &schema() const;
+    bool            has_path(const std::string &path) const;
+
+    /// returns the data at path, loading any leaves that aren't cached.
+    /// an empty path fetches the whole tree.
+    const Node     &fetch(const std::string &path);
+    /// true if all leaves at path are cached
+    bool            is_loaded(const std::string &path) const;
+
+    /// limit for cached bytes, -1 (the default) means no limit
+    void            set_cache_budget(index_t num_bytes);
+    index_t         cache_budget() const;
+    index_t         cached_bytes() const;
+    index_t         number_of_cached_leaves() const;
+
+    void            evict_all();
+
+private:
+    // not copyable
+    HDF5LazyTree(const HDF5LazyTree &);
+    HDF5LazyTree &operator=(const HDF5LazyTree &);
+
+    void            load_leaf(const std::string &path,
+                              const Schema &leaf_schema);
+    void            touch_leaf(const std::string &path);
+    void            evict_for(index_t num_bytes,
+                              const std::string *keep_path);
+    void            collect_leaves(const Schema &schema,
+                                   const std::string &path,
+                                   std::vector<std::string> &paths) const;
+    void            prepare_groups(const Schema &schema,
+                                   const std::string &path);
+
+    hid_t                    m_file_id;
+    std::string              m_hdf5_path;
+    Schema                   m_schema;
+    Node                     m_data;
+
+    index_t                  m_cache_budget;
+    index_t                  m_cached_bytes;
+    // most recently fetched leaves are at the front
+    std::list<std::string>   m_lru;
+    std::map<std::string, std::list<std::string>::iterator> m_lru_index;
+};
+
+//-----------------------------------------------------------------------------
+/// HDF5AsyncWriter performs hdf5_write() calls on a background i/o thread.
+///
+/// write() snapshots (deep copies) the node and options, queues the write
+/// and returns a handle right away. write_external() skips the copy: the
+/// node must not be modified or destroyed until its write completes.
+///
+/// At most max_pending() writes are queued or in progress. When the queue
+/// is full, write() takes its snapshot and then blocks until a pending 
+/// write completes. Handles are handed out in queue order, so writes
+/// submitted from several threads complete in the order of their handles.
+///
+/// test() returns true if the write for a handle completed, wait() blocks
+/// until it does. Both throw a conduit::Error if the write failed.
+/// wait_all() waits for all pending writes, and throws if any failed.
+/// Handles are retired once their completion is reported.
+///
+/// All writes are serialized on the one i/o thread. HDF5 isn't thread 
+/// safe, so don't use other relay hdf5 functions (or the hdf5 library) 
+/// from other threads while writes are pending, call wait_all() first.
+///
+/// The destructor waits for pending writes to complete.
+///
+/// On platforms without pthreads, writes are performed in write().
+//-----------------------------------------------------------------------------
+class HDF5AsyncWriterImpl;
+
+class CONDUIT_RELAY_API HDF5AsyncWriter
+{
+public:
+    HDF5AsyncWriter();
+   ~HDF5AsyncWriter();
+
+    /// path is a file system and hdf5 path, joined using a ":"
+    /// (see hdf5_write() for the supported options)
+    index_t         write(const Node &node,
+                          const std::string &path);
+    index_t         write(const Node &node,
+                          const std::string &path,
+                          const Node &opts);
+
+    /// like write(), without copying the node's data
+    index_t         write_external(const Node &node,
+                                   const std::string &path);
+    index_t         write_external(const Node &node,
+                                   const std::string &path,
+                                   const Node &opts);
+
+    bool            test(index_t handle);
+    void            wait(index_t handle);
+    void            wait_all();
+
+    /// limit for queued + in progress writes (default: 2)
+    void            set_max_pending(index_t max_pending);
+    index_t         max_pending() const;
+    index_t         number_of_pending_writes() const;
+
+private:
+    // not copyable
+    HDF5AsyncWriter(const HDF5AsyncWriter &);
+    HDF5AsyncWriter &operator=(const HDF5AsyncWriter &);
+
+    HDF5AsyncWriterImpl     *m_impl;
+};
+
 //-----------------------------------------------------------------------------
 /// Helpers for converting between hdf5 dtypes and conduit dtypes
 /// 
@@ -265,7 +525,55 @@ DataType CONDUIT_RELAY_API hdf5_dtype_to_conduit_dtype(hid_t hdf5_dtype_id,
 bool CONDUIT_RELAY_API hdf5_has_path(hid_t hdf5_id, const std::string &path);
 
 //-----------------------------------------------------------------------------
-/// Pass a Node to set hdf5 i/o options.
+/// Creates an index file with HDF5 virtual datasets that stitch the
+/// datasets of several source files (ex: one file per rank) into single
+/// logical datasets, without copying data.
+///
+/// hdf5_paths select datasets or groups in the sources. A group selects
+/// all the datasets below it. An empty list selects the whole tree. 
+/// The first source file's tree is used to find the datasets.
+///
+/// Each selected dataset is concatenated along its first dimension, in
+/// the order of the source files. Sources must have the same dtype and
+/// the same remaining dimensions. Empty sources add no rows. Each virtual
+/// dataset has a "conduit_source_offsets" attribute with the first row of 
+/// each source (and the total number of rows as its last entry).
+///
+/// Reading the index with hdf5_read() reads from the source files. 
+/// Source file paths are stored as given, relative paths are resolved by 
+/// HDF5 (see H5Pset_virtual). Requires HDF5 1.10.0 or newer.
+///
+/// Virtual datasets can only map datasets: selecting a leaf written as an
+/// attribute (small_leaves/mode "attributes"), or a group that holds one,
+/// is an error. Write the sources without attribute leaves to index them.
+//-----------------------------------------------------------------------------
+void CONDUIT_RELAY_API hdf5_create_virtual_index(
+                             const std::string &index_file_path,
+                             const std::vector<std::string> &source_file_paths,
+                             const std::vector<std::string> &hdf5_paths);
+
+//-----------------------------------------------------------------------------
+/// Pass a Node to set the process wide default hdf5 i/o options.
+///
+/// These defaults are shared by all threads, prefer passing options to
+/// the hdf5_write() variants that accept them to vary settings per call.
+///
+/// File level settings apply to files created or opened after they are
+/// set. Sizes are in bytes, and 0 keeps the HDF5 library default:
+///
+///   file/libver/low, file/libver/high:
+///       "earliest" | "v18" | "v110" | "latest"  (default: "latest")
+///   file/page_size:             file space page size (default: 0, no paging)
+///   file/page_buffer_size:      page buffer size, used with paged files
+///   file/meta_block_size:       metadata aggregation block size
+///   file/small_data_block_size: small raw data aggregation block size
+///   file/sieve_buf_size:        data sieve buffer size
+///   file/chunk_cache/size:      default chunk cache size for datasets
+///   file/chunk_cache/nslots:    default chunk cache hash table slots
+///
+/// Paging is set when a file is created. The page buffer is only used
+/// for paged files that are created or opened for writing, files opened
+/// read only (and files created without paging) skip it.
 //-----------------------------------------------------------------------------
 void CONDUIT_RELAY_API hdf5_set_options(const Node &opts);
 
@@ -274,6 +582,33 @@ void CONDUIT_RELAY_API hdf5_set_options(const Node &opts);
 //-----------------------------------------------------------------------------
 void CONDUIT_RELAY_API hdf5_options(Node &opts);
 
+//-----------------------------------------------------------------------------
+/// HDF5 file cache
+///
+/// The read and write variants that take file system paths open and close
+/// the file on each call. To keep files open across these calls, enable 
+/// the file cache with hdf5_set_options():
+///
+///   file_cache/max_open_files: N        (default: 0, the cache is disabled)
+///   file_cache/flush: "write" | "close" (default: "write")
+///
+/// Up to N files are kept open, keyed by the file path used to open them.
+/// The least recently used file is closed when the limit is reached.
+/// With the "write" policy, files are flushed after each write, so the 
+/// data on disk is complete while the file stays open. With "close", 
+/// files are only flushed when they are closed, or when
+/// hdf5_flush_cached_files() is called.
+///
+/// Writes to subtrees of a file that is cached for writing reuse the open
+/// file, so repeated "file.hdf5:/step/field" writes open it once and
+/// keep the earlier subtrees. A write to the root of a cached file, or
+/// with truncate: "true", closes and recreates it.
+/// Close cached files before other code or processes use them.
+//-----------------------------------------------------------------------------
+void    CONDUIT_RELAY_API hdf5_flush_cached_files();
+void    CONDUIT_RELAY_API hdf5_close_cached_files();
+index_t CONDUIT_RELAY_API hdf5_number_of_cached_files();
+
 
 }
 //-----------------------------------------------------------------------------
@@ -130,8 +130,13 @@ identify_protocol(const std::string &path,
     {
         io_type = "conduit_base64_json";
     }
+    else if(file_name_ext == "conduit_packed")
+    {
+        io_type = "conduit_packed";
+    }
     
     // default to conduit_bin
+    // (loading with conduit_bin also reads packed files)
 
 }
 
@@ -184,6 +189,7 @@ save(const Node &node,
 {
     // support conduit::Node's basic save cases
     if(protocol == "conduit_bin" ||
+       protocol == "conduit_packed" ||
        protocol == "json" || 
        protocol == "conduit_json" ||
        protocol == "conduit_base64_json" )
@@ -232,6 +238,7 @@ save_merged(const Node &node,
 {
     // support conduit::Node's basic save cases
     if(protocol == "conduit_bin" ||
+       protocol == "conduit_packed" ||
        protocol == "json" || 
        protocol == "conduit_json" ||
        protocol == "conduit_base64_json" )
@@ -244,7 +251,10 @@ save_merged(const Node &node,
     else if( protocol == "hdf5")
     {
 #ifdef CONDUIT_RELAY_IO_HDF5_ENABLED
-        hdf5_write(node,path);
+        // write into the existing file, instead of truncating it
+        Node opts;
+        opts["truncate"] = "false";
+        hdf5_write(node,path,opts);
 #else
         CONDUIT_ERROR("conduit_relay lacks HDF5 support: " << 
                       "Failed to save conduit node to path " << path);
@@ -288,6 +298,7 @@ load(const std::string &path,
 
     // support conduit::Node's basic load cases
     if(protocol == "conduit_bin" ||
+       protocol == "conduit_packed" ||
        protocol == "json" || 
        protocol == "conduit_json" ||
        protocol == "conduit_base64_json" )
@@ -334,6 +345,7 @@ load_merged(const std::string &path,
 {
     // support conduit::Node's basic load cases
     if(protocol == "conduit_bin" ||
+       protocol == "conduit_packed" ||
        protocol == "json" || 
        protocol == "conduit_json" ||
        protocol == "conduit_base64_json" )
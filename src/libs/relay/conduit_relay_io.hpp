@@ -77,6 +77,16 @@ namespace relay
 namespace io
 {
 
+///
+/// ``identify_protocol`` picks the protocol used for a path, based only on
+///  its file extension (files are not opened). Defaults to "conduit_bin",
+///  which also loads files in the packed format ("conduit_packed").
+///
+
+//-----------------------------------------------------------------------------
+void CONDUIT_RELAY_API identify_protocol(const std::string &path,
+                                         std::string &io_type);
+
 ///
 /// ``save`` works like a 'set' to the file.
 ///
@@ -336,7 +336,8 @@ recv_using_schema(Node &node, int src, int tag, MPI_Comm comm)
     int buffer_size = 0;
     MPI_Get_count(&status, MPI_BYTE, &buffer_size);
 
-    Node n_buffer(DataType::uint8(buffer_size));
+    Node n_buffer;
+    n_buffer.set_uninitialized(DataType::uint8(buffer_size));
     
     mpi_error = MPI_Recv(n_buffer.data_ptr(),
                          buffer_size,
@@ -426,7 +427,7 @@ recv(Node &node, int src, int tag, MPI_Comm comm)
         cpy_out = true;
         Schema s_rcv_compact;
         node.schema().compact_to(s_rcv_compact);
-        rcv_compact.set_schema(s_rcv_compact);
+        rcv_compact.set_uninitialized(s_rcv_compact);
         rcv_ptr  = rcv_compact.data_ptr();
     }
 
@@ -503,7 +504,7 @@ reduce(const Node &snd_node,
             Schema s_snd_compact;
             snd_node.schema().compact_to(s_snd_compact);
         
-            rcv_compact.set_schema(s_snd_compact);
+            rcv_compact.set_uninitialized(s_snd_compact);
             rcv_ptr = rcv_compact.data_ptr();
         }
     }
@@ -578,7 +579,7 @@ all_reduce(const Node &snd_node,
         Schema s_snd_compact;
         snd_node.schema().compact_to(s_snd_compact);
         
-        rcv_compact.set_schema(s_snd_compact);
+        rcv_compact.set_uninitialized(s_snd_compact);
         rcv_ptr = rcv_compact.data_ptr();
     }
 
@@ -780,7 +781,9 @@ irecv(Node &node,
     }
     else
     {
-        node.compact_to(request->m_buffer);
+        Schema s_compact;
+        node.schema().compact_to(s_compact);
+        request->m_buffer.set_uninitialized(s_compact);
         data_ptr  = request->m_buffer.data_ptr();
         request->m_rcv_ptr = &node;
     }
@@ -1089,7 +1092,8 @@ gather_using_schema(Node &send_node,
             i++;
         }
         
-        n_rcv_tmp["schemas/data"].set(DataType::c_char(schema_curr_displ));
+        n_rcv_tmp["schemas/data"].set_uninitialized(
+                                        DataType::c_char(schema_curr_displ));
         schema_rcv_buff = n_rcv_tmp["schemas/data"].value();
     }
 
@@ -1127,7 +1131,7 @@ gather_using_schema(Node &send_node,
     {
         // allocate data to hold the gather result
         // TODO can we support copy out w/out realloc
-        recv_node.set(rcv_schema);
+        recv_node.set_uninitialized(rcv_schema);
         data_rcv_buff = (char*)recv_node.data_ptr();
     }
     
@@ -1234,7 +1238,8 @@ all_gather_using_schema(Node &send_node,
         child_idx+=1;
     }
     
-    n_rcv_tmp["schemas/data"].set(DataType::c_char(schema_curr_displ));
+    n_rcv_tmp["schemas/data"].set_uninitialized(
+                                    DataType::c_char(schema_curr_displ));
     schema_rcv_buff = n_rcv_tmp["schemas/data"].value();
 
     mpi_error = MPI_Allgatherv( const_cast <char*>(schema_str.c_str()),
@@ -1263,7 +1268,7 @@ all_gather_using_schema(Node &send_node,
     s_tmp.compact_to(rcv_schema);
 
     // allocate data to hold the gather result
-    recv_node.set(rcv_schema);
+    recv_node.set_uninitialized(rcv_schema);
     data_rcv_buff = (char*)recv_node.data_ptr();
     
     mpi_error = MPI_Allgatherv( n_snd_compact.data_ptr(),
@@ -1314,7 +1319,7 @@ broadcast(Node &node,
         {
             Schema s_compact;
             node.schema().compact_to(s_compact);
-            bcast_buffer.set_schema(s_compact);
+            bcast_buffer.set_uninitialized(s_compact);
             
             bcast_data_ptr  = bcast_buffer.data_ptr();
             cpy_out = true;
@@ -1426,7 +1431,7 @@ broadcast_using_schema(Node &node,
                 ! node.is_compact() )
             {
                 Node &bcast_data_buffer = bcast_buffers["data"];
-                bcast_data_buffer.set_schema(bcast_schema);
+                bcast_data_buffer.set_uninitialized(bcast_schema);
                 
                 bcast_data_ptr  = bcast_data_buffer.data_ptr();
                 cpy_out = true;
@@ -1434,7 +1439,7 @@ broadcast_using_schema(Node &node,
         }
         else
         {
-            node.set_schema(bcast_schema);
+            node.set_uninitialized(bcast_schema);
 
             bcast_data_ptr  = node.data_ptr();
             bcast_data_size = static_cast<int>(node.total_bytes_compact());
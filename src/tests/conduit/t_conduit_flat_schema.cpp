@@ -0,0 +1,446 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_conduit_flat_schema.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <limits>
+#include "gtest/gtest.h"
+
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, freeze_and_traverse)
+{
+    Schema s;
+    s["a"].set(DataType::int64(10));
+    s["b/c"].set(DataType::float64(20));
+    s["b/d"].set(DataType::uint8(3));
+    s["l"].append().set(DataType::int32(4));
+    s["l"].append().set(DataType::int32(5));
+
+    FlatSchema fs(s);
+
+    // root, a, b, b/c, b/d, l, l[0], l[1]
+    EXPECT_EQ(fs.number_of_entries(),8);
+    EXPECT_EQ(fs.dtype_id(0),DataType::OBJECT_ID);
+    EXPECT_EQ(fs.number_of_children(0),3);
+    EXPECT_EQ(fs.parent(0),-1);
+
+    index_t b_idx = fs.child(0,1);
+    EXPECT_EQ(std::string(fs.name(b_idx)),"b");
+    EXPECT_EQ(fs.parent(b_idx),0);
+    EXPECT_EQ(fs.child_index(0,"b"),b_idx);
+    EXPECT_EQ(fs.child_index(0,"missing"),-1);
+
+    index_t d_idx = fs.fetch_index("b/d");
+    EXPECT_EQ(fs.dtype(d_idx).id(),DataType::UINT8_ID);
+    EXPECT_EQ(fs.dtype(d_idx).number_of_elements(),3);
+    EXPECT_EQ(fs.fetch_index("../a",d_idx),-1);
+    EXPECT_EQ(fs.fetch_index("../c",d_idx),fs.fetch_index("b/c"));
+    EXPECT_EQ(fs.path(d_idx),"b/d");
+    EXPECT_EQ(fs.path(fs.child(fs.fetch_index("l"),1)),"l/[1]");
+
+    EXPECT_TRUE(fs.has_path("b/c"));
+    EXPECT_FALSE(fs.has_path("b/e"));
+
+    EXPECT_EQ(fs.total_bytes_compact(),s.total_bytes_compact());
+    EXPECT_EQ(fs.total_strided_bytes(),s.total_strided_bytes());
+    EXPECT_EQ(fs.is_compact(),s.is_compact());
+
+    EXPECT_EQ(fs.to_json(),s.to_json());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, thaw)
+{
+    Schema s;
+    s["a"].set(DataType::int64(10));
+    s["z/c"].set(DataType::float64(20,8));
+    s["z/b"].set(DataType::uint8(3));
+    s["l"].append().set(DataType::int32(4));
+
+    FlatSchema fs(s);
+    Schema s_thawed;
+    fs.to_schema(s_thawed);
+
+    EXPECT_TRUE(s.equals(s_thawed));
+    EXPECT_EQ(s.to_json(),s_thawed.to_json());
+    // child order is preserved
+    EXPECT_EQ(s_thawed["z"].child_name(0),"c");
+    EXPECT_EQ(s_thawed["z"][1].parent(),&s_thawed["z"]);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, compare)
+{
+    Schema s1;
+    s1["a"].set(DataType::int64(10));
+    s1["b"].set(DataType::float64(20));
+
+    // same entries, different order
+    Schema s2;
+    s2["b"].set(DataType::float64(20));
+    s2["a"].set(DataType::int64(10));
+
+    FlatSchema fs1(s1);
+    FlatSchema fs2(s2);
+
+    EXPECT_TRUE(fs1.equals(fs2));
+    EXPECT_TRUE(fs2.equals(fs1));
+    EXPECT_TRUE(fs1.compatible(fs2));
+
+    // fewer elements is compatible, but not equal
+    Schema s3;
+    s3["a"].set(DataType::int64(5));
+    FlatSchema fs3(s3);
+
+    EXPECT_TRUE(fs1.compatible(fs3));
+    EXPECT_FALSE(fs3.compatible(fs1));
+    EXPECT_FALSE(fs1.equals(fs3));
+    EXPECT_EQ(fs1.compatible(fs3),s1.compatible(s3));
+
+    // different type
+    Schema s4;
+    s4["a"].set(DataType::float32(10));
+    FlatSchema fs4(s4);
+    EXPECT_FALSE(fs1.compatible(fs4));
+    EXPECT_FALSE(fs1.equals(fs4));
+
+    // lists
+    Schema s5;
+    s5.append().set(DataType::int32(3));
+    s5.append().set(DataType::int32(3));
+    Schema s6;
+    s6.append().set(DataType::int32(3));
+
+    FlatSchema fs5(s5);
+    FlatSchema fs6(s6);
+    EXPECT_TRUE(fs5.compatible(fs6));
+    EXPECT_FALSE(fs6.compatible(fs5));
+    EXPECT_FALSE(fs5.equals(fs6));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, serialize)
+{
+    Schema s;
+    s["a"].set(DataType::int64(10));
+    s["b/c"].set(DataType::float64(20));
+    s["b/a"].set(DataType::uint8(3));
+    s["l"].append().set(DataType::int32(4));
+
+    FlatSchema fs(s);
+
+    std::vector<uint8> data;
+    fs.serialize(data);
+    EXPECT_EQ((index_t)data.size(),fs.serialized_size());
+
+    FlatSchema fs_load;
+    fs_load.deserialize(&data[0],(index_t)data.size());
+
+    EXPECT_TRUE(fs.equals(fs_load));
+    EXPECT_EQ(fs.to_json(),fs_load.to_json());
+    EXPECT_EQ(fs_load.fetch_index("b/a"),fs.fetch_index("b/a"));
+
+    // truncated buffers are rejected
+    EXPECT_THROW(fs_load.deserialize(&data[0],(index_t)data.size() - 1),
+                 conduit::Error);
+
+    // so are buffers that don't hold a flat schema
+    std::vector<uint8> junk(data.size(),0);
+    EXPECT_THROW(fs_load.deserialize(&junk[0],(index_t)junk.size()),
+                 conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, node_schema)
+{
+    Node n;
+    n["fields/u"].set(DataType::float64(100));
+    n["fields/v"].set(DataType::float64(100));
+    n["coords/x"].set(DataType::float32(101));
+
+    FlatSchema fs(n.schema());
+    EXPECT_EQ(fs.total_bytes_compact(),n.total_bytes_compact());
+    // each leaf has its own allocation, so the largest leaf spans the most
+    EXPECT_EQ(fs.spanned_bytes(),800);
+    EXPECT_EQ(fs.to_json(),n.schema().to_json());
+
+    // empty flat schema
+    FlatSchema fs_empty;
+    EXPECT_EQ(fs_empty.number_of_entries(),0);
+    EXPECT_EQ(fs_empty.total_bytes_compact(),0);
+    EXPECT_EQ(fs_empty.to_json(),Schema().to_json());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, repeated_list)
+{
+    Schema s_entry;
+    s_entry["x"].set(DataType::float64(4));
+    s_entry["y"].set(DataType::int32(2));
+
+    Node n;
+    n.list_of(s_entry,1000);
+
+    FlatSchema fs(n.schema());
+    // list_of children share one subtree: list, entry, x, y
+    EXPECT_EQ(fs.number_of_entries(),4);
+    EXPECT_TRUE(fs.is_repeated(0));
+    EXPECT_EQ(fs.number_of_children(0),1000);
+    EXPECT_EQ(fs.child(0,0),fs.child(0,999));
+
+    EXPECT_EQ(fs.total_bytes_compact(),n.schema().total_bytes_compact());
+    EXPECT_EQ(fs.total_strided_bytes(),n.schema().total_strided_bytes());
+    EXPECT_EQ(fs.to_json(),n.schema().to_json());
+
+    Schema s_thawed;
+    fs.to_schema(s_thawed);
+    EXPECT_TRUE(s_thawed.equals(n.schema()));
+    EXPECT_EQ(s_thawed.number_of_children(),1000);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, list_of)
+{
+    Schema s_entry;
+    s_entry["x"].set(DataType::float64(4));
+    s_entry["y"].set(DataType::int32(2));
+
+    // built directly, without per entry schemas
+    FlatSchema fs;
+    fs.list_of(s_entry,1000);
+    EXPECT_EQ(fs.number_of_entries(),4);
+    EXPECT_TRUE(fs.is_repeated(0));
+    EXPECT_EQ(fs.number_of_children(0),1000);
+    EXPECT_EQ(fs.child_offset(0,2),2 * 40);
+    EXPECT_TRUE(fs.is_compact());
+
+    // same as the compact form of Node::list_of()
+    Node n;
+    n.list_of(s_entry,1000);
+    Schema s_compact;
+    n.schema().compact_to(s_compact);
+    FlatSchema fs_node(s_compact);
+    EXPECT_TRUE(fs.equals(fs_node));
+    EXPECT_EQ(fs.total_bytes_compact(),n.total_bytes_compact());
+    EXPECT_EQ(fs.spanned_bytes(),n.total_bytes_compact());
+
+    fs.list_of(DataType::int32(4),1);
+    EXPECT_FALSE(fs.is_repeated(0));
+    EXPECT_EQ(fs.number_of_children(0),1);
+    EXPECT_EQ(fs.total_bytes_compact(),16);
+
+    fs.list_of(DataType::int32(4),0);
+    EXPECT_EQ(fs.number_of_entries(),1);
+    EXPECT_EQ(fs.number_of_children(0),0);
+
+    EXPECT_THROW(fs.list_of(s_entry,-1),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, repeated_list_offsets)
+{
+    // a compact list: entries only differ by an offset shift
+    Schema s;
+    for(index_t i = 0; i < 10; i++)
+    {
+        Schema &s_entry = s.append();
+        s_entry["a"].set(DataType::float64(2,i * 24));
+        s_entry["b"].set(DataType::int32(2,i * 24 + 16));
+    }
+
+    FlatSchema fs(s);
+    EXPECT_EQ(fs.number_of_entries(),4);
+    EXPECT_TRUE(fs.is_repeated(0));
+    EXPECT_EQ(fs.child_offset(0,3),72);
+
+    EXPECT_EQ(fs.total_bytes_compact(),s.total_bytes_compact());
+    EXPECT_EQ(fs.spanned_bytes(),240);
+    EXPECT_TRUE(fs.is_compact());
+    EXPECT_EQ(fs.to_json(),s.to_json());
+
+    Schema s_thawed;
+    fs.to_schema(s_thawed);
+    EXPECT_TRUE(s_thawed.equals(s));
+    EXPECT_EQ(s_thawed[9]["b"].dtype().offset(),9 * 24 + 16);
+
+    // compare against the same layout, frozen without sharing
+    Schema s_other(s);
+    s_other[9]["b"].set(DataType::int32(2,0));
+    FlatSchema fs_other(s_other);
+    EXPECT_FALSE(fs_other.is_repeated(0));
+    EXPECT_FALSE(fs.equals(fs_other));
+    EXPECT_TRUE(fs.compatible(fs_other));
+
+    s_other[9]["b"].set(DataType::int32(2,9 * 24 + 16));
+    EXPECT_TRUE(FlatSchema(s_other).is_repeated(0));
+    s_other[5]["a"].set(DataType::float64(2,5 * 24 + 1));
+    fs_other.set(s_other);
+    EXPECT_FALSE(fs_other.is_repeated(0));
+    EXPECT_FALSE(fs.equals(fs_other));
+    s_other[5]["a"].set(DataType::float64(2,5 * 24));
+    fs_other.set(s_other);
+    EXPECT_TRUE(fs.equals(fs_other));
+
+    // serialization keeps the shared representation
+    std::vector<uint8> data;
+    fs.serialize(data);
+    FlatSchema fs_load;
+    fs_load.deserialize(&data[0],(index_t)data.size());
+    EXPECT_EQ(fs_load.number_of_entries(),4);
+    EXPECT_TRUE(fs_load.equals(fs));
+}
+
+//-----------------------------------------------------------------------------
+// flat schema image layout: 4 int64 header values, then the entries
+static const size_t flat_schema_header_bytes = 4 * sizeof(int64);
+
+//-----------------------------------------------------------------------------
+static FlatSchema::Entry
+get_entry(const std::vector<uint8> &data, size_t idx)
+{
+    FlatSchema::Entry e;
+    memcpy(&e,
+           &data[flat_schema_header_bytes + idx * sizeof(e)],
+           sizeof(e));
+    return e;
+}
+
+//-----------------------------------------------------------------------------
+static void
+set_entry(std::vector<uint8> &data, size_t idx, const FlatSchema::Entry &e)
+{
+    memcpy(&data[flat_schema_header_bytes + idx * sizeof(e)],
+           &e,
+           sizeof(e));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_flat_schema, deserialize_malformed)
+{
+    Schema s;
+    s["a"].set(DataType::int64(10));
+    s["b/c"].set(DataType::float64(20));
+    for(index_t i = 0; i < 8; i++)
+    {
+        s["l"].append().set(DataType::int32(4,240 + i * 16));
+    }
+
+    FlatSchema fs(s);
+    std::vector<uint8> data;
+    fs.serialize(data);
+    index_t nbytes = (index_t)data.size();
+
+    index_t a_idx = fs.fetch_index("a");
+    index_t b_idx = fs.fetch_index("b");
+    index_t l_idx = fs.fetch_index("l");
+    ASSERT_TRUE(fs.is_repeated(l_idx));
+
+    FlatSchema fs_load;
+    fs_load.deserialize(&data[0],nbytes);
+    EXPECT_TRUE(fs_load.equals(fs));
+
+    // counts that overflow the image size computation
+    std::vector<uint8> bad(data);
+    int64 count = std::numeric_limits<int64>::max() / 2;
+    memcpy(&bad[sizeof(int64)],&count,sizeof(count));
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+    EXPECT_EQ(fs_load.number_of_entries(),0);
+
+    // child range outside of the child table
+    bad = data;
+    FlatSchema::Entry e = get_entry(bad,(size_t)b_idx);
+    e.children_begin = 1 << 20;
+    set_entry(bad,(size_t)b_idx,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    bad = data;
+    e = get_entry(bad,0);
+    e.number_of_children = 1 << 20;
+    set_entry(bad,0,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    // parent outside of the entry table
+    bad = data;
+    e = get_entry(bad,(size_t)a_idx);
+    e.parent = 1 << 20;
+    set_entry(bad,(size_t)a_idx,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    // name outside of the name table
+    bad = data;
+    e = get_entry(bad,(size_t)a_idx);
+    e.name = 1 << 20;
+    set_entry(bad,(size_t)a_idx,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    // repeated shift that overflows the span
+    bad = data;
+    e = get_entry(bad,(size_t)l_idx);
+    e.repeat_stride = std::numeric_limits<int64>::max() / 4;
+    set_entry(bad,(size_t)l_idx,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    // negative leaf offset
+    bad = data;
+    e = get_entry(bad,(size_t)a_idx);
+    e.offset = -8;
+    set_entry(bad,(size_t)a_idx,e);
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+
+    // unterminated name table
+    bad = data;
+    bad[bad.size() - 1] = 'x';
+    EXPECT_THROW(fs_load.deserialize(&bad[0],nbytes),conduit::Error);
+}
@@ -0,0 +1,275 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_conduit_memory.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+static bool
+is_aligned(const void *ptr, index_t alignment)
+{
+    return ((size_t)ptr % (size_t)alignment) == 0;
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, allocate)
+{
+    bool needs_deallocate = false;
+    MemoryPolicy policy(MemoryPolicy::ZERO,64);
+
+    uint8 *data = (uint8*)memory::allocate(1000,policy,needs_deallocate);
+    EXPECT_TRUE(is_aligned(data,64));
+    for(int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(data[i],0);
+    }
+    memory::deallocate(data);
+
+    policy.init = MemoryPolicy::PARALLEL_ZERO;
+    policy.huge_pages = true;
+    index_t nbytes = 4 * 1024 * 1024 + 3;
+    data = (uint8*)memory::allocate(nbytes,policy,needs_deallocate);
+    EXPECT_TRUE(is_aligned(data,64));
+    EXPECT_EQ(data[0],0);
+    EXPECT_EQ(data[nbytes-1],0);
+    memory::deallocate(data);
+
+    // alignment must be a power of two
+    policy.alignment = 48;
+    EXPECT_THROW(memory::allocate(100,policy,needs_deallocate),
+                 conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, node_set_with_policy)
+{
+    Schema s;
+    s["a"].set(DataType::float64(100));
+    s["b"].set(DataType::int32(100,800));
+
+    Node n;
+    n.set(s,MemoryPolicy(MemoryPolicy::PARALLEL_ZERO,64));
+    EXPECT_TRUE(is_aligned(n.data_ptr(),64));
+    EXPECT_TRUE(is_aligned(n["a"].data_ptr(),64));
+    EXPECT_EQ(n["b"].as_int32_ptr()[99],0);
+    EXPECT_EQ(n.total_bytes_allocated(),1200);
+
+    n.set(DataType::float64(1000),MemoryPolicy(MemoryPolicy::NONE,128));
+    EXPECT_TRUE(is_aligned(n.data_ptr(),128));
+    float64_array vals = n.value();
+    for(index_t i = 0; i < 1000; i++)
+    {
+        vals[i] = 1.0;
+    }
+    EXPECT_EQ(vals[999],1.0);
+
+    // aligned buffers are released, copied and grown like any other
+    Node n_copy(n);
+    EXPECT_EQ(n_copy.as_float64_ptr()[999],1.0);
+    n.push_back(2.0);
+    EXPECT_EQ(n.dtype().number_of_elements(),1001);
+    n.reset();
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, node_set_with_policy_reuse)
+{
+    Node n;
+    n.set(DataType::float64(1000));
+    void *data_ptr = n.data_ptr();
+    float64 *vals = n.value();
+    std::fill(vals,vals + 1000,1.0);
+
+    // compatible buffers are reused, but still initialized
+    n.set(DataType::float64(1000),MemoryPolicy(MemoryPolicy::ZERO));
+    EXPECT_EQ(n.data_ptr(),data_ptr);
+    EXPECT_EQ(n.as_float64_ptr()[999],0.0);
+
+    std::fill(vals,vals + 1000,1.0);
+    n.set(DataType::float64(1000),MemoryPolicy(MemoryPolicy::PARALLEL_ZERO));
+    EXPECT_EQ(n.data_ptr(),data_ptr);
+    EXPECT_EQ(n.as_float64_ptr()[0],0.0);
+
+    std::fill(vals,vals + 1000,1.0);
+    n.set_uninitialized(DataType::float64(1000));
+    EXPECT_EQ(n.data_ptr(),data_ptr);
+    EXPECT_EQ(n.as_float64_ptr()[999],1.0);
+
+    // only the elements of a strided leaf are zeroed
+    n.set(DataType::int32(4,0,2 * sizeof(int32)));
+    int32 *strided = (int32*)n.data_ptr();
+    // (spans 7 int32s)
+    for(int i = 0; i < 7; i++)
+    {
+        strided[i] = i + 1;
+    }
+    n.set(DataType::int32(4),MemoryPolicy(MemoryPolicy::ZERO));
+    EXPECT_EQ(n.data_ptr(),(void*)strided);
+    EXPECT_EQ(strided[0],0);
+    EXPECT_EQ(strided[1],2);
+    EXPECT_EQ(strided[5],6);
+    EXPECT_EQ(strided[6],0);
+
+    // external memory is reused as is, never initialized
+    float64 ext_vals[4] = {1.0,2.0,3.0,4.0};
+    n.set_external(ext_vals,4);
+    n.set(DataType::float64(4),MemoryPolicy::default_policy());
+    EXPECT_EQ(n.data_ptr(),(void*)ext_vals);
+    EXPECT_EQ(ext_vals[3],4.0);
+    n.set(DataType::float64(4),MemoryPolicy(MemoryPolicy::PARALLEL_ZERO));
+    EXPECT_EQ(ext_vals[0],1.0);
+
+    // as is memory owned by a parent
+    Node tree;
+    tree["a"].set(DataType::float64(4));
+    tree["b"].set(DataType::float64(4));
+    Node tree_c;
+    tree.compact_to(tree_c);
+    float64 *b_vals = tree_c["b"].value();
+    std::fill(b_vals,b_vals + 4,1.0);
+    tree_c["b"].set(DataType::float64(4),MemoryPolicy(MemoryPolicy::ZERO));
+    EXPECT_EQ(tree_c["b"].element_ptr(0),(void*)b_vals);
+    EXPECT_EQ(b_vals[3],1.0);
+
+    // misaligned buffers are reallocated
+    std::vector<float64> ext(101,1.0);
+    float64 *ext_ptr = is_aligned(&ext[0],64) ? &ext[1] : &ext[0];
+    n.set_external(ext_ptr,100);
+    n.set(DataType::float64(100),MemoryPolicy(MemoryPolicy::ZERO,64));
+    EXPECT_NE(n.data_ptr(),(void*)ext_ptr);
+    EXPECT_TRUE(is_aligned(n.data_ptr(),64));
+    EXPECT_EQ(n.as_float64_ptr()[99],0.0);
+    EXPECT_EQ(ext_ptr[99],1.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, small_leaf_with_policy)
+{
+    // small leaves are aligned as requested, and stay aligned when reused
+    Node n;
+    n.set(DataType::float64(2),MemoryPolicy(MemoryPolicy::ZERO,64));
+    EXPECT_TRUE(is_aligned(n.data_ptr(),64));
+    EXPECT_EQ(n.total_bytes_allocated(),16);
+    void *data_ptr = n.data_ptr();
+    n.set(DataType::float64(2),MemoryPolicy(MemoryPolicy::ZERO,64));
+    EXPECT_EQ(n.data_ptr(),data_ptr);
+
+    n.set(DataType::int32(1),MemoryPolicy(MemoryPolicy::NONE,128));
+    EXPECT_TRUE(is_aligned(n.data_ptr(),128));
+
+    // an alignment the inline storage provides keeps the fast path
+    n.set(DataType::float64(1),MemoryPolicy(MemoryPolicy::ZERO,8));
+    EXPECT_TRUE(is_aligned(n.data_ptr(),8));
+    EXPECT_EQ(n.as_float64(),0.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, default_policy)
+{
+    MemoryPolicy::set_default(MemoryPolicy(MemoryPolicy::ZERO,256));
+    EXPECT_EQ(MemoryPolicy::default_policy().alignment,256);
+
+    Node n;
+    n["a"].set(DataType::float64(100));
+    n["b"].set(DataType::int64(100));
+    EXPECT_TRUE(is_aligned(n["a"].data_ptr(),256));
+    EXPECT_TRUE(is_aligned(n["b"].data_ptr(),256));
+    EXPECT_EQ(n["b"].as_int64_ptr()[99],0);
+
+    // small leaves honor the alignment too, instead of inline storage
+    n["c"] = 1.0;
+    EXPECT_EQ(n["c"].as_float64(),1.0);
+    EXPECT_TRUE(is_aligned(n["c"].data_ptr(),256));
+
+    MemoryPolicy::reset_default();
+    EXPECT_EQ(MemoryPolicy::default_policy().alignment,0);
+    EXPECT_EQ(MemoryPolicy::default_policy().init,MemoryPolicy::ZERO);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_memory, node_set_uninitialized)
+{
+    MemoryPolicy::set_default(MemoryPolicy(MemoryPolicy::ZERO,64));
+
+    Schema s;
+    s["a"].set(DataType::float64(100));
+    s["b"].set(DataType::int32(100,800));
+
+    Node n;
+    n.set_uninitialized(s);
+    // keeps the default's alignment
+    EXPECT_TRUE(is_aligned(n.data_ptr(),64));
+    EXPECT_EQ(n.total_bytes_allocated(),1200);
+    EXPECT_EQ(n["b"].dtype().number_of_elements(),100);
+
+    MemoryPolicy::reset_default();
+
+    int32_array b_vals = n["b"].value();
+    for(index_t i = 0; i < 100; i++)
+    {
+        b_vals[i] = (int32)i;
+    }
+
+    n["c"].set_uninitialized(DataType::uint8(1000));
+    EXPECT_EQ(n["c"].dtype().number_of_elements(),1000);
+
+    // round trip through a load, which reads into uninitialized memory
+    n.save("tout_conduit_memory_uninit.conduit_bin");
+    Node n_load;
+    n_load.load("tout_conduit_memory_uninit.conduit_bin");
+    EXPECT_EQ(n_load["b"].as_int32_ptr()[99],99);
+}
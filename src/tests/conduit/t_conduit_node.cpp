@@ -959,3 +959,171 @@ TEST(conduit_node, check_invalid_index_error)
 
 
 
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, small_leaf_storage)
+{
+    Node n;
+    n["a"] = 1.0;
+    n["b"] = (int32) 42;
+    n["c"] = "short";
+    n["d"].set(DataType::float64(3));
+
+    // small leaves are owned by the node, even though they don't
+    // use a separate heap allocation
+    EXPECT_FALSE(n["a"].is_data_external());
+    EXPECT_EQ(n["a"].allocated_bytes(), 8);
+    EXPECT_EQ(n["c"].allocated_bytes(), 6);
+    EXPECT_EQ(n.total_bytes_allocated(), 8 + 4 + 6 + 24);
+
+    EXPECT_EQ(n["a"].as_float64(), 1.0);
+    EXPECT_EQ(n["b"].as_int32(), 42);
+    EXPECT_EQ(n["c"].as_string(), "short");
+    EXPECT_EQ(n["a"].data_ptr(), n["a"].element_ptr(0));
+
+    // switching between small and large leaves
+    n["a"].set(DataType::float64(100));
+    float64_array a_vals = n["a"].value();
+    a_vals[99] = 99.0;
+    n["a"] = 2.0;
+    EXPECT_EQ(n["a"].as_float64(), 2.0);
+
+    // copies and round trips through serialization
+    Node n_copy(n);
+    EXPECT_EQ(n_copy["c"].as_string(), "short");
+    EXPECT_NE(n_copy["b"].data_ptr(), n["b"].data_ptr());
+
+    std::vector<uint8> bytes;
+    n.serialize(bytes);
+    Schema s_compact;
+    n.schema().compact_to(s_compact);
+    Node n_ser(s_compact, &bytes[0], true);
+    Node info;
+    EXPECT_FALSE(n.diff(n_ser, info));
+
+    // compact small objects are held inline as well
+    Node n_cmp;
+    n.compact_to(n_cmp);
+    EXPECT_EQ(n_cmp["b"].as_int32(), 42);
+    EXPECT_EQ(n_cmp["c"].as_string(), "short");
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, leaf_push_back)
+{
+    Node n;
+    for(int32 i = 0; i < 1000; i++)
+    {
+        n.push_back(i);
+    }
+
+    EXPECT_EQ(n.dtype().id(), DataType::INT32_ID);
+    EXPECT_EQ(n.dtype().number_of_elements(), 1000);
+    EXPECT_GE(n.capacity(), 1000);
+    // capacity grows geometrically
+    EXPECT_LT(n.capacity(), 2000);
+
+    int32_array vals = n.value();
+    for(int32 i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(vals[i], i);
+    }
+
+    // type mismatch
+    EXPECT_THROW(n.push_back((float64)1.0), conduit::Error);
+    // non-leaf
+    Node n_obj;
+    n_obj["a"] = 1;
+    EXPECT_THROW(n_obj.push_back((int32)1), conduit::Error);
+    EXPECT_THROW(n_obj.resize(10), conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, leaf_reserve_resize)
+{
+    Node n;
+    n.set(DataType::float64(4));
+    float64 *vals = n.value();
+    for(int i = 0; i < 4; i++)
+    {
+        vals[i] = i;
+    }
+
+    n.reserve(100);
+    EXPECT_EQ(n.capacity(), 100);
+    EXPECT_EQ(n.dtype().number_of_elements(), 4);
+    float64 *res_ptr = n.value();
+    EXPECT_EQ(res_ptr[3], 3.0);
+
+    // growing within capacity does not reallocate
+    n.resize(50);
+    EXPECT_EQ(n.data_ptr(), (void*)res_ptr);
+    EXPECT_EQ(n.dtype().number_of_elements(), 50);
+    float64_array arr = n.value();
+    EXPECT_EQ(arr[2], 2.0);
+    EXPECT_EQ(arr[49], 0.0);
+
+    // shrinking keeps capacity, growing again zeros the new elements
+    arr[3] = 42.0;
+    n.resize(3);
+    EXPECT_EQ(n.capacity(), 100);
+    n.resize(4);
+    arr = n.value();
+    EXPECT_EQ(arr[3], 0.0);
+
+    EXPECT_EQ(n.total_bytes_allocated(), 800);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, leaf_append_values)
+{
+    // grow an external, strided leaf
+    float64 ext[6] = {0.0, -1.0, 1.0, -1.0, 2.0, -1.0};
+    Node n;
+    n.set_external(ext, 3, 0, 2 * sizeof(float64));
+    EXPECT_EQ(n.capacity(), 3);
+
+    std::vector<float64> more(2, 3.0);
+    n.append_values(more);
+    EXPECT_EQ(n.dtype().number_of_elements(), 5);
+    EXPECT_TRUE(n.dtype().is_compact());
+    // the external data is untouched
+    EXPECT_EQ(ext[1], -1.0);
+
+    float64_array vals = n.value();
+    EXPECT_EQ(vals[0], 0.0);
+    EXPECT_EQ(vals[2], 2.0);
+    EXPECT_EQ(vals[4], 3.0);
+
+    // append a strided array
+    float64_array ext_arr(ext, DataType::float64(3, 0, 2 * sizeof(float64)));
+    n.append_values(ext_arr);
+    vals = n.value();
+    EXPECT_EQ(n.dtype().number_of_elements(), 8);
+    EXPECT_EQ(vals[7], 2.0);
+
+    // append values from the node itself
+    n.append_values(n.as_float64_array());
+    vals = n.value();
+    EXPECT_EQ(n.dtype().number_of_elements(), 16);
+    EXPECT_EQ(vals[15], 2.0);
+
+    // grow a leaf that lives in its parent's compact buffer
+    Node n_tree;
+    Schema s;
+    s["a"].set(DataType::int64(2));
+    s["b"].set(DataType::int64(2));
+    n_tree.set(s);
+    n_tree["b"].as_int64_ptr()[1] = 7;
+    n_tree["a"].push_back((int64)5);
+    n_tree["a"].push_back((int64)6);
+    int64_array a_vals = n_tree["a"].value();
+    EXPECT_EQ(a_vals.number_of_elements(), 4);
+    EXPECT_EQ(a_vals[3], 6);
+    EXPECT_EQ(n_tree["b"].as_int64_ptr()[1], 7);
+
+    Node n_cmp;
+    n_tree.compact_to(n_cmp);
+    EXPECT_EQ(n_cmp["a"].dtype().number_of_elements(), 4);
+    EXPECT_EQ(n_cmp["a"].as_int64_ptr()[2], 5);
+}
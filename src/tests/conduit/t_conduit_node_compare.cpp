@@ -482,3 +482,197 @@ TEST(conduit_node_compare, compare_list_size_diff)
         }
     }
 }
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_compare, compare_leaf_summary)
+{
+    const index_t num_eles = 10000;
+
+    Node n, o;
+    n.set(DataType::float64(num_eles));
+    o.set(DataType::float64(num_eles));
+
+    float64 *n_ptr = n.value();
+    float64 *o_ptr = o.value();
+    for(index_t i = 0; i < num_eles; i++)
+    {
+        n_ptr[i] = (float64) i;
+        o_ptr[i] = (float64) i;
+    }
+
+    { // Summary Similarity Test //
+        Node info;
+        EXPECT_FALSE(n.diff(o, info, CONDUIT_EPSILON, true));
+        EXPECT_FALSE(info.has_child("value"));
+        EXPECT_FALSE(info.has_child("summary"));
+        EXPECT_EQ(info["valid"].as_string(), "true");
+    }
+
+    o_ptr[10]   += 0.5;
+    o_ptr[9000] += 2.0;
+
+    { // Summary Difference Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, CONDUIT_EPSILON, true));
+        EXPECT_FALSE(info.has_child("value"));
+        EXPECT_EQ(info["valid"].as_string(), "false");
+
+        Node &info_sum = info["summary"];
+        EXPECT_EQ(info_sum["first_mismatch"].to_index_t(), 10);
+        EXPECT_EQ(info_sum["num_mismatches"].to_index_t(), 2);
+        EXPECT_EQ(info_sum["num_compared"].to_index_t(), num_eles);
+        EXPECT_NEAR(info_sum["max_abs_diff"].to_float64(), 2.0, 1e-12);
+        EXPECT_NEAR(info_sum["max_rel_diff"].to_float64(), 0.5 / 10.5, 1e-12);
+    }
+
+    { // Summary Compatible Test //
+        Node info;
+        EXPECT_TRUE(n.diff_compatible(o, info, CONDUIT_EPSILON, true));
+        EXPECT_EQ(info["summary/num_mismatches"].to_index_t(), 2);
+    }
+
+    { // Summary Epsilon Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, 1.0, true));
+        EXPECT_EQ(info["summary/first_mismatch"].to_index_t(), 9000);
+        EXPECT_EQ(info["summary/num_mismatches"].to_index_t(), 1);
+    }
+
+    { // Early Exit Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, CONDUIT_EPSILON, true, true));
+        EXPECT_EQ(info["summary/first_mismatch"].to_index_t(), 10);
+        EXPECT_EQ(info["summary/num_mismatches"].to_index_t(), 1);
+        EXPECT_LT(info["summary/num_compared"].to_index_t(), num_eles);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_compare, compare_leaf_summary_early_exit_large)
+{
+    // large enough for the threaded path, with mismatches in every block
+    // except the first, which has its mismatch in its last element
+    const index_t num_eles = 4 * 1024 * 1024;
+    Node n, o;
+    n.set(DataType::float64(num_eles));
+    o.set(DataType::float64(num_eles));
+
+    float64 *n_ptr = n.value();
+    float64 *o_ptr = o.value();
+    for(index_t i = 0; i < num_eles; i++)
+    {
+        n_ptr[i] = (float64) i;
+        o_ptr[i] = (float64) i;
+    }
+
+    o_ptr[4095] += 1.0;
+    for(index_t i = 4096; i < num_eles; i += 512)
+    {
+        o_ptr[i] += 1.0;
+    }
+
+    for(int iter = 0; iter < 4; iter++)
+    {
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, CONDUIT_EPSILON, true, true));
+        EXPECT_EQ(info["summary/first_mismatch"].to_index_t(), 4095);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_compare, compare_leaf_summary_strided)
+{
+    int32 n_vals[8] = {0, -1, 1, -1, 2, -1, 3, -1};
+    int32 o_vals[4] = {0, 1, 5, 3};
+
+    Node n, o;
+    n.set_external(DataType::int32(4, 0, 2 * sizeof(int32)), n_vals);
+    o.set_external(o_vals, 4);
+
+    Node info;
+    EXPECT_TRUE(n.diff(o, info, 0.0, true));
+    EXPECT_EQ(info["summary/first_mismatch"].to_index_t(), 2);
+    EXPECT_EQ(info["summary/num_mismatches"].to_index_t(), 1);
+    EXPECT_NEAR(info["summary/max_abs_diff"].to_float64(), 3.0, 1e-12);
+
+    o_vals[2] = 2;
+    EXPECT_FALSE(n.diff(o, info, 0.0, true));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_compare, compare_summary_tree)
+{
+    Node n;
+    n["a"].set(DataType::int64(2000000));
+    n["b"].set(DataType::float32(100));
+    n["c"] = "string";
+
+    Node o(n);
+    int64_array o_a = o["a"].value();
+    o_a[1999999] = 1;
+    float32_array o_b = o["b"].value();
+    o_b[0] = 1.0f;
+
+    { // Full Summary Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, 0.0, true));
+        EXPECT_EQ(info["children/diff/a/summary/first_mismatch"].to_index_t(),
+                  1999999);
+        EXPECT_EQ(info["children/diff/b/summary/first_mismatch"].to_index_t(),
+                  0);
+        EXPECT_EQ(info["children/diff/c/valid"].as_string(), "true");
+    }
+
+    { // Early Exit Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, 0.0, true, true));
+        EXPECT_TRUE(info["children/diff"].has_child("a"));
+        EXPECT_FALSE(info["children/diff"].has_child("b"));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_compare, compare_leaf_early_exit)
+{
+    const index_t num_eles = 10000;
+    Node n, o;
+    n.set(DataType::float64(num_eles));
+    o.set(DataType::float64(num_eles));
+    float64_array o_vals = o.value();
+    o_vals[10]   = 1.0;
+    o_vals[9000] = 2.0;
+
+    { // Early Exit, No Summary Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info, CONDUIT_EPSILON, false, true));
+        EXPECT_EQ(info["first_mismatch"].to_index_t(), 10);
+        EXPECT_FALSE(info.has_child("value"));
+        EXPECT_FALSE(info.has_child("summary"));
+
+        EXPECT_TRUE(n.diff_compatible(o, info, CONDUIT_EPSILON, false, true));
+        EXPECT_EQ(info["first_mismatch"].to_index_t(), 10);
+        EXPECT_FALSE(info.has_child("value"));
+    }
+
+    { // Strided Test //
+        int32 n_vals[8] = {0, -1, 1, -1, 2, -1, 3, -1};
+        int32 s_vals[4] = {0, 1, 5, 3};
+        Node n_s, o_s;
+        n_s.set_external(DataType::int32(4, 0, 2 * sizeof(int32)), n_vals);
+        o_s.set_external(s_vals, 4);
+
+        Node info;
+        EXPECT_TRUE(n_s.diff(o_s, info, 0.0, false, true));
+        EXPECT_EQ(info["first_mismatch"].to_index_t(), 2);
+
+        s_vals[2] = 2;
+        EXPECT_FALSE(n_s.diff(o_s, info, 0.0, false, true));
+        EXPECT_FALSE(info.has_child("first_mismatch"));
+    }
+
+    { // Default Test //
+        Node info;
+        EXPECT_TRUE(n.diff(o, info));
+        EXPECT_EQ(info["value"].dtype().number_of_elements(), num_eles);
+    }
+}
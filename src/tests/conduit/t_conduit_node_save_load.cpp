@@ -51,6 +51,8 @@
 #include "conduit.hpp"
 
 #include <iostream>
+#include <sstream>
+#include <vector>
 #include "gtest/gtest.h"
 
 
@@ -493,3 +495,89 @@ TEST(conduit_node_save_load, load_save_array)
 
 
 
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_save_load, save_non_compact)
+{
+    // a strided leaf larger than the serialize staging buffer, 
+    // interleaved with contiguous leaves
+    const index_t num_vals = 300000;
+    std::vector<float64> vals(num_vals * 2);
+    for(index_t i = 0; i < num_vals * 2; i++)
+    {
+        vals[i] = (float64)i;
+    }
+
+    Node n;
+    n["a"] = (int32)1;
+    n["strided"].set_external(&vals[0],
+                              num_vals,
+                              sizeof(float64),
+                              2 * sizeof(float64));
+    n["b"] = (int32)2;
+    // enough leaves to need several gathered writes
+    for(int i = 0; i < 1200; i++)
+    {
+        std::ostringstream oss;
+        oss << "many/" << i;
+        n[oss.str()] = (int16)i;
+    }
+
+    std::string fname = "tout_node_save_non_compact.conduit_bin";
+    n.save(fname);
+
+    Node n_load;
+    n_load.load(fname);
+
+    Node info;
+    EXPECT_FALSE(n.diff(n_load,info));
+    EXPECT_EQ(n_load["strided"].as_float64_ptr()[num_vals-1],
+              (float64)(num_vals * 2 - 1));
+    EXPECT_EQ(n_load["many/1199"].as_int16(),1199);
+    EXPECT_TRUE(n_load.is_compact());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_save_load, load_into)
+{
+    Node n;
+    n["a"].set(DataType::float64(10));
+    n["b"].set(DataType::int32(3));
+    float64 *a_vals = n["a"].value();
+
+    std::string protos[3] = {"conduit_bin", "conduit_packed", "conduit_json"};
+    for(int p = 0; p < 3; p++)
+    {
+        std::string fname = "tout_node_load_into." + protos[p];
+
+        Node n_load;
+        const void *a_ptr = NULL;
+        for(int step = 0; step < 3; step++)
+        {
+            a_vals[0] = step;
+            n.save(fname,protos[p]);
+            n_load.load_into(fname,protos[p]);
+
+            Node info;
+            EXPECT_FALSE(n.diff(n_load,info));
+            EXPECT_EQ(n_load["a"].as_float64_ptr()[0], (float64)step);
+
+            // buffers are reused after the first load
+            if(step == 0)
+                a_ptr = n_load["a"].data_ptr();
+            else
+                EXPECT_EQ(n_load["a"].data_ptr(), a_ptr);
+        }
+    }
+
+    // a different shape reallocates
+    Node n2;
+    n2["a"].set(DataType::int8(2));
+    n2.save("tout_node_load_into_2.conduit_bin");
+    Node n_load;
+    n.save("tout_node_load_into.conduit_bin");
+    n_load.load_into("tout_node_load_into.conduit_bin");
+    n_load.load_into("tout_node_load_into_2.conduit_bin");
+    Node info;
+    EXPECT_FALSE(n2.diff(n_load,info));
+}
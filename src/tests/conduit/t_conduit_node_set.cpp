@@ -2783,3 +2783,193 @@ TEST(conduit_node, node_set_non_compact_dtype)
 }
 
 
+
+//-----------------------------------------------------------------------------
+static int owned_deleter_calls = 0;
+
+//-----------------------------------------------------------------------------
+static void
+counting_deleter(void *data)
+{
+    owned_deleter_calls++;
+    delete [] static_cast<float64*>(data);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, node_set_owned)
+{
+    owned_deleter_calls = 0;
+
+    float64 *vals = new float64[10];
+    for(int i = 0; i < 10; i++)
+    {
+        vals[i] = i;
+    }
+
+    Node n;
+    n.set_owned(DataType::float64(10), vals, counting_deleter);
+    // no copy
+    EXPECT_EQ(n.data_ptr(), (void*)vals);
+    EXPECT_EQ(n.allocated_bytes(), 80);
+    EXPECT_EQ(n.as_float64_ptr()[9], 9.0);
+
+    // the deleter is called when the node releases its data
+    n.set((int32)1);
+    EXPECT_EQ(owned_deleter_calls, 1);
+
+    // and on destruction
+    {
+        Node n_tmp;
+        n_tmp.set_owned(DataType::float64(2), new float64[2], counting_deleter);
+    }
+    EXPECT_EQ(owned_deleter_calls, 2);
+
+    // default deleter uses free
+    int32 *ivals = (int32*)malloc(sizeof(int32) * 4);
+    ivals[3] = 3;
+    n.set_owned(DataType::int32(4), ivals);
+    EXPECT_EQ(n.as_int32_ptr()[3], 3);
+    n.reset();
+
+    // adopt a tree
+    Schema s;
+    s["a"].set(DataType::int64(2));
+    s["b"].set(DataType::float64(2, 2 * sizeof(int64)));
+    uint8 *tree_data = (uint8*)calloc(1, 32);
+    ((float64*)(tree_data + 16))[1] = 42.0;
+    n.set_owned(s, tree_data);
+    EXPECT_EQ(n["b"].as_float64_ptr()[1], 42.0);
+    EXPECT_EQ(n.total_bytes_allocated(), 32);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, node_set_owned_vector)
+{
+    std::vector<float64> vals(1000, 1.0);
+    vals[999] = 42.0;
+    const float64 *vals_ptr = &vals[0];
+
+    Node n;
+    n.set_owned(vals);
+    // the node took the vector's storage
+    EXPECT_TRUE(vals.empty());
+    EXPECT_EQ(n.as_float64_ptr(), vals_ptr);
+    EXPECT_EQ(n.dtype().number_of_elements(), 1000);
+    EXPECT_EQ(n.as_float64_ptr()[999], 42.0);
+
+    // growing an adopted leaf
+    n.push_back(43.0);
+    EXPECT_EQ(n.dtype().number_of_elements(), 1001);
+    EXPECT_EQ(n.as_float64_ptr()[1000], 43.0);
+
+    std::vector<int32> empty_vals;
+    n["a"].set_owned(empty_vals);
+    EXPECT_EQ(n["a"].dtype().number_of_elements(), 0);
+
+    std::vector<uint8> bytes(10, 7);
+    n["b"].set_owned_uint8_vector(bytes);
+    EXPECT_EQ(n["b"].as_uint8_ptr()[9], 7);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, node_set_compatible)
+{
+    Node src;
+    src["a"].set(DataType::float64(8));
+    src["b/c"].set(DataType::int32(4));
+    src["b/d"].set_int64(5);
+
+    float64 *src_a = src["a"].value();
+    for(int i=0; i < 8; i++)
+        src_a[i] = i * 0.5;
+
+    Node dest;
+    dest.set_compatible(src);
+    Node info;
+    EXPECT_FALSE(src.diff(dest,info));
+
+    const void *a_ptr = dest["a"].data_ptr();
+    const void *c_ptr = dest["b/c"].data_ptr();
+
+    // same structure: values are copied in place
+    src_a[3] = 42.0;
+    src["b/d"].set_int64(6);
+    dest.set_compatible(src);
+    EXPECT_FALSE(src.diff(dest,info));
+    EXPECT_EQ(dest["a"].data_ptr(), a_ptr);
+    EXPECT_EQ(dest["b/c"].data_ptr(), c_ptr);
+    EXPECT_EQ(dest["a"].as_float64_ptr()[3], 42.0);
+
+    // strided dest keeps its layout
+    float64 strided[16];
+    for(int i=0; i < 16; i++)
+        strided[i] = -1.0;
+    dest["a"].set_external(strided,8,0,2*sizeof(float64));
+    dest.set_compatible(src);
+    EXPECT_EQ(dest["a"].data_ptr(), (void*)strided);
+    EXPECT_EQ(strided[6], 42.0);
+    EXPECT_EQ(strided[7], -1.0);
+    EXPECT_FALSE(src.diff(dest,info));
+
+    // smaller type: the owned buffer of b/c is retained
+    src["b/c"].set(DataType::int16(4));
+    dest.set_compatible(src);
+    EXPECT_EQ(dest["b/c"].data_ptr(), c_ptr);
+    EXPECT_TRUE(dest["b/c"].dtype().is_int16());
+    EXPECT_FALSE(src.diff(dest,info));
+
+    // more elements than fit: reallocates
+    src["b/c"].set(DataType::int32(100));
+    dest.set_compatible(src);
+    EXPECT_EQ(dest["b/c"].dtype().number_of_elements(), 100);
+    EXPECT_FALSE(src.diff(dest,info));
+
+    // structure change falls back to set()
+    src["b/e"].set_int8(1);
+    dest.set_compatible(src);
+    EXPECT_TRUE(dest.has_path("b/e"));
+    EXPECT_FALSE(src.diff(dest,info));
+
+    Node empty;
+    dest.set_compatible(empty);
+    EXPECT_TRUE(dest.dtype().is_empty());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node, node_set_compatible_tree_to_leaf)
+{
+    Node leaf;
+    leaf.set_int32(7);
+
+    // object that owns its buffer
+    Node src;
+    src["a"].set_int64(1);
+    src["b"].set_float64(2.0);
+
+    Node dest;
+    src.compact_to(dest);
+    dest.set_compatible(leaf);
+    EXPECT_TRUE(dest.dtype().is_int32());
+    EXPECT_EQ(dest.number_of_children(), 0);
+    EXPECT_EQ(dest.as_int32(), 7);
+
+    dest["x"] = 5;
+    EXPECT_EQ(dest["x"].to_int64(), 5);
+    dest.to_json();
+
+    // list that owns its buffer
+    Node src_list;
+    src_list.append().set_int64(1);
+    src_list.append().set_float64(2.0);
+
+    Node dest_list;
+    src_list.compact_to(dest_list);
+    dest_list.set_compatible(leaf);
+    EXPECT_TRUE(dest_list.dtype().is_int32());
+    EXPECT_EQ(dest_list.number_of_children(), 0);
+    EXPECT_EQ(dest_list.as_int32(), 7);
+
+    dest_list.append().set_int8(3);
+    EXPECT_EQ(dest_list[0].to_int64(), 3);
+    dest_list.to_json();
+}
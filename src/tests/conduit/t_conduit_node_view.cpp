@@ -0,0 +1,183 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: t_conduit_node_view.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit.hpp"
+
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_view, basic)
+{
+    Node n;
+    n["a"] = (int32)10;
+    n["b/c"].set(DataType::float64(4));
+    float64 *c_ptr = n["b/c"].value();
+    for(int i=0; i < 4; i++)
+    {
+        c_ptr[i] = i * 1.5;
+    }
+    n["b/d"] = "hello";
+
+    Node cmp;
+    n.compact_to(cmp);
+
+    // view over the compact buffer
+    NodeView v(cmp.schema(),cmp.data_ptr());
+    EXPECT_TRUE(v.valid());
+    EXPECT_TRUE(v.dtype().is_object());
+    EXPECT_EQ(v.number_of_children(),2);
+    EXPECT_TRUE(v.has_child("a"));
+    EXPECT_TRUE(v.has_path("b/c"));
+    EXPECT_FALSE(v.has_path("b/e"));
+
+    EXPECT_EQ(v["a"].as<int32>(),10);
+    EXPECT_EQ(v.child(0).as<int32>(),10);
+    EXPECT_EQ(v.child("b").child_name(1),"d");
+
+    float64_array c_vals = v["b/c"].as_array<float64>();
+    EXPECT_EQ(c_vals.number_of_elements(),4);
+    EXPECT_EQ(c_vals[3],4.5);
+    
+    // writes through the view land in the buffer
+    v["b/c"].as_ptr<float64>()[0] = 42.0;
+    EXPECT_EQ(cmp["b/c"].as_float64_ptr()[0],42.0);
+
+    // names are returned by reference from the schema
+    const std::string &name = v.child_name(1);
+    EXPECT_EQ(&name,&cmp.schema().child_names()[1]);
+
+    EXPECT_THROW(v["a"].as<float64>(),conduit::Error);
+    EXPECT_THROW(v.child("missing"),conduit::Error);
+
+    NodeView invalid;
+    EXPECT_FALSE(invalid.valid());
+    EXPECT_EQ(invalid.number_of_children(),0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_view, iterate)
+{
+    Node n;
+    n["x"] = (int64)1;
+    n["y"] = (int64)2;
+    n["z"] = (int64)3;
+    
+    Node cmp;
+    n.compact_to(cmp);
+
+    NodeViewIterator itr(NodeView(cmp.schema(),cmp.data_ptr()));
+    int64 sum = 0;
+    std::string names;
+    while(itr.has_next())
+    {
+        NodeView cv = itr.next();
+        sum += cv.as<int64>();
+        names += itr.name();
+        EXPECT_EQ(itr.view().data_ptr(),cv.data_ptr());
+    }
+    EXPECT_EQ(sum,6);
+    EXPECT_EQ(names,"xyz");
+    EXPECT_EQ(itr.index(),2);
+
+    itr.to_front();
+    EXPECT_EQ(itr.peek_next().as<int64>(),1);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_view, list_and_const)
+{
+    Node n;
+    n.append().set((float32)1.0);
+    n.append().set((float32)2.0);
+
+    Node cmp;
+    n.compact_to(cmp);
+
+    const Node &c_cmp = cmp;
+    ConstNodeView v(c_cmp.schema(),c_cmp.data_ptr());
+    EXPECT_TRUE(v.dtype().is_list());
+    EXPECT_EQ(v.number_of_children(),2);
+    EXPECT_EQ(v[1].as<float32>(),2.0f);
+    EXPECT_EQ(v.child_name(1),"");
+    EXPECT_EQ(*v[0].as_ptr<float32>(),1.0f);
+
+    Node res;
+    v.compact_to(res);
+    EXPECT_EQ(res[1].as_float32(),2.0f);
+    Node info;
+    EXPECT_FALSE(res.diff(cmp,info));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_node_view, received_buffer)
+{
+    // a buffer and schema as received from another process
+    Node src;
+    src["fields/p"].set(DataType::float64(8));
+    src["fields/u"].set(DataType::float32(8));
+    src["state/cycle"] = (int32)100;
+
+    Schema recv_schema;
+    src.schema().compact_to(recv_schema);
+    std::vector<uint8> recv_buffer;
+    src.serialize(recv_buffer);
+
+    ConstNodeView v(recv_schema,&recv_buffer[0]);
+    EXPECT_EQ(v["state/cycle"].as<int32>(),100);
+    EXPECT_EQ(v["fields/u"].as_array<float32>().number_of_elements(),8);
+
+    Node ext;
+    NodeView(recv_schema,&recv_buffer[0]).to_node_external(ext);
+    EXPECT_EQ(ext.data_ptr(),(void*)&recv_buffer[0]);
+    EXPECT_EQ(ext["state/cycle"].as_int32(),100);
+}
@@ -0,0 +1,427 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: t_conduit_packed_node.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+static void
+create_packed_test_node(Node &n)
+{
+    n["state/cycle"] = (int32)42;
+    n["state/time"]  = 3.5;
+    n["state/name"]  = "packed";
+    n["fields/p"].set(DataType::float64(10));
+    float64 *p_ptr = n["fields/p"].value();
+    for(int i=0; i < 10; i++)
+    {
+        p_ptr[i] = i * 0.5;
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, pack_and_open)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    std::vector<uint8> buffer;
+    PackedNode::pack(n,buffer);
+    EXPECT_EQ((index_t)buffer.size(),PackedNode::packed_size(n));
+    EXPECT_TRUE(PackedNode::is_packed(&buffer[0],(index_t)buffer.size()));
+
+    PackedNode pn(&buffer[0],(index_t)buffer.size());
+    EXPECT_TRUE(pn.is_open());
+    EXPECT_EQ(pn.image_bytes(),(index_t)buffer.size());
+    EXPECT_EQ(pn.data_bytes(),n.total_bytes_compact());
+    EXPECT_EQ(pn.header().data_offset % PackedNode::DATA_ALIGNMENT,0);
+    EXPECT_FALSE(pn.has_checksum());
+    EXPECT_TRUE(pn.verify_checksum());
+
+    // data is read in place
+    FlatNodeView v = pn.fetch("state/cycle");
+    EXPECT_EQ(v.as<int32>(),42);
+    EXPECT_TRUE((const uint8*)v.element_ptr(0) >= &buffer[0]);
+    EXPECT_TRUE((const uint8*)v.element_ptr(0) < &buffer[0] + buffer.size());
+
+    EXPECT_EQ(pn.view()["state/time"].as<float64>(),3.5);
+    EXPECT_EQ(pn.view()["fields"].child_name(0),std::string("p"));
+    EXPECT_EQ(pn.fetch("fields/p").as_array<float64>()[9],4.5);
+    EXPECT_TRUE(pn.has_path("state/name"));
+    EXPECT_FALSE(pn.has_path("state/missing"));
+
+    Node res;
+    pn.to_node(res);
+    Node info;
+    EXPECT_FALSE(n.diff(res,info));
+    EXPECT_EQ(res["state/name"].as_string(),"packed");
+
+    Node ext;
+    pn.to_node_external(ext);
+    EXPECT_EQ(ext.data_ptr(),pn.data_ptr());
+    EXPECT_FALSE(n.diff(ext,info));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, pack_non_compact)
+{
+    // strided source leaves are compacted as they are packed
+    float64 vals[8] = {0,1,2,3,4,5,6,7};
+    Node n;
+    n["a"].set_external(vals,4,0,2*sizeof(float64));
+    n["b"].set_external(vals,4,sizeof(float64),2*sizeof(float64));
+    n["c"] = (int64)-1;
+
+    std::vector<uint8> buffer;
+    PackedNode::pack(n,buffer);
+    PackedNode pn(&buffer[0],(index_t)buffer.size());
+
+    float64_array a = pn.fetch("a").as_array<float64>();
+    float64_array b = pn.fetch("b").as_array<float64>();
+    EXPECT_EQ(a[3],6.0);
+    EXPECT_EQ(b[3],7.0);
+    EXPECT_EQ(pn.fetch("c").as<int64>(),-1);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, repeated_list)
+{
+    Schema s_entry;
+    s_entry["x"].set(DataType::float64(2));
+    s_entry["id"].set(DataType::int32());
+
+    Node n;
+    n.list_of(s_entry,100);
+    for(index_t i=0; i < 100; i++)
+    {
+        n[i]["x"].as_float64_ptr()[1] = (float64)i;
+        n[i]["id"].set((int32)(1000 + i));
+    }
+
+    std::vector<uint8> buffer;
+    PackedNode::pack(n,buffer);
+    PackedNode pn(&buffer[0],(index_t)buffer.size());
+
+    // the children share one schema entry
+    EXPECT_EQ(pn.flat_schema().number_of_entries(),4);
+
+    FlatNodeView v = pn.view();
+    EXPECT_EQ(v.number_of_children(),100);
+    EXPECT_EQ(v[57]["id"].as<int32>(),1057);
+    EXPECT_EQ(v[99]["x"].as_array<float64>()[1],99.0);
+    // offsets include the shift of the list entry
+    EXPECT_EQ(v[3].fetch("x").dtype().offset(),
+              3 * s_entry.total_bytes_compact());
+
+    Node sub;
+    v[12].compact_to(sub);
+    EXPECT_EQ(sub["id"].as_int32(),1012);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, checksum)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    std::vector<uint8> buffer;
+    PackedNode::pack(n,buffer,true);
+
+    PackedNode pn(&buffer[0],(index_t)buffer.size());
+    EXPECT_TRUE(pn.has_checksum());
+    EXPECT_TRUE(pn.verify_checksum());
+
+    // corrupt the data
+    buffer[buffer.size()-1] ^= 0xff;
+    EXPECT_FALSE(pn.verify_checksum());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, caller_buffer)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    index_t nbytes = PackedNode::packed_size(n);
+    std::vector<uint8> buffer((size_t)nbytes + 16,0);
+
+    EXPECT_THROW(PackedNode::pack(n,&buffer[0],nbytes-1),conduit::Error);
+    EXPECT_EQ(PackedNode::pack(n,&buffer[0],(index_t)buffer.size()),nbytes);
+
+    PackedNode pn(&buffer[0],(index_t)buffer.size());
+    EXPECT_EQ(pn.fetch("state/cycle").as<int32>(),42);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, invalid_buffers)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    std::vector<uint8> buffer;
+    PackedNode::pack(n,buffer);
+
+    PackedNode pn;
+    EXPECT_FALSE(pn.is_open());
+    EXPECT_THROW(pn.view(),conduit::Error);
+
+    // truncated
+    EXPECT_THROW(pn.open(&buffer[0],(index_t)buffer.size()-1),
+                 conduit::Error);
+    EXPECT_FALSE(pn.is_open());
+
+    // not a packed node
+    std::vector<uint8> junk(128,0);
+    EXPECT_FALSE(PackedNode::is_packed(&junk[0],(index_t)junk.size()));
+    EXPECT_THROW(pn.open(&junk[0],(index_t)junk.size()),conduit::Error);
+
+    pn.open(&buffer[0],(index_t)buffer.size());
+    EXPECT_TRUE(pn.is_open());
+    pn.close();
+    EXPECT_FALSE(pn.is_open());
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, save_load_mmap)
+{
+    Node n;
+    create_packed_test_node(n);
+    // include a strided leaf
+    float64 vals[6] = {0,1,2,3,4,5};
+    n["strided"].set_external(vals,3,0,2*sizeof(float64));
+
+    std::string path = "tout_packed_node.conduit_packed";
+    n.save(path,"conduit_packed");
+    EXPECT_TRUE(PackedNode::is_packed_file(path));
+    EXPECT_FALSE(PackedNode::is_packed_file("tout_packed_node_missing"));
+
+    Node info;
+    Node n_load;
+    n_load.load(path,"conduit_packed");
+    EXPECT_FALSE(n.diff(n_load,info));
+    EXPECT_EQ(n_load["strided"].as_float64_array()[2],4.0);
+
+    // "conduit_bin" loads detect packed files
+    Node n_bin;
+    n_bin.load(path);
+    EXPECT_FALSE(n.diff(n_bin,info));
+
+    Node n_mmap;
+    n_mmap.mmap(path,"conduit_packed");
+    EXPECT_EQ(n_mmap.mmaped_bytes(),PackedNode::packed_size(n));
+    EXPECT_FALSE(n.diff(n_mmap,info));
+    EXPECT_EQ(n_mmap["state/cycle"].as_int32(),42);
+    n_mmap.reset();
+
+    // the two file conduit_bin protocol is unchanged
+    n.save("tout_packed_node_bin");
+    EXPECT_FALSE(PackedNode::is_packed_file("tout_packed_node_bin"));
+    Node n_bin_load;
+    n_bin_load.load("tout_packed_node_bin");
+    EXPECT_FALSE(n.diff(n_bin_load,info));
+    n_bin_load.load_into("tout_packed_node_bin");
+    EXPECT_FALSE(n.diff(n_bin_load,info));
+
+    // conduit_bin load_into also reads packed files
+    n_bin_load.load_into(path);
+    EXPECT_FALSE(n.diff(n_bin_load,info));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, save_checksum)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    std::string path = "tout_packed_node_checksum.conduit_packed";
+    PackedNode::save(n,path,true);
+
+    // the file holds the same image as pack()
+    std::vector<uint8> image;
+    PackedNode::pack(n,image,true);
+    std::vector<uint8> file_image(image.size(),0);
+    std::ifstream ifs(path.c_str(),std::ios_base::binary);
+    ifs.read((char*)&file_image[0],(std::streamsize)file_image.size());
+    EXPECT_EQ((size_t)ifs.gcount(),image.size());
+    ifs.close();
+    EXPECT_TRUE(image == file_image);
+
+    Node n_load;
+    PackedNode::load(path,n_load);
+    EXPECT_EQ(n_load["fields/p"].as_float64_array()[9],4.5);
+
+    // corrupt the last data byte
+    std::fstream fs(path.c_str(),
+                    std::ios_base::binary | 
+                    std::ios_base::in | 
+                    std::ios_base::out);
+    fs.seekp((std::streamoff)image.size()-1);
+    char c = (char)(image[image.size()-1] ^ 0xff);
+    fs.write(&c,1);
+    fs.close();
+
+    EXPECT_THROW(PackedNode::load(path,n_load),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+static void
+save_packed_with_data_bytes(const Node &n,
+                            const std::string &path,
+                            int64 data_bytes)
+{
+    std::vector<uint8> image;
+    PackedNode::pack(n,image);
+
+    PackedNode::Header h;
+    memcpy(&h,&image[0],sizeof(h));
+    h.data_bytes = data_bytes;
+    memcpy(&image[0],&h,sizeof(h));
+
+    // pad the file, so only the header is inconsistent
+    image.resize(image.size() + 4096,0);
+
+    std::ofstream ofs(path.c_str(),std::ios_base::binary);
+    ofs.write((const char*)&image[0],(std::streamsize)image.size());
+    ofs.close();
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, load_bad_data_bytes)
+{
+    Node n;
+    create_packed_test_node(n);
+    int64 nbytes = (int64)n.total_bytes_compact();
+
+    std::string path = "tout_packed_node_bad_data_bytes.conduit_packed";
+    Node n_load;
+
+    // inflated
+    save_packed_with_data_bytes(n,path,nbytes + 1024);
+    EXPECT_THROW(PackedNode::load(path,n_load),conduit::Error);
+
+    // load_into a buffer with a reusable layout
+    n_load.reset();
+    PackedNode::save(n,path);
+    PackedNode::load(path,n_load);
+    save_packed_with_data_bytes(n,path,nbytes + 1024);
+    EXPECT_THROW(PackedNode::load_into(path,n_load),conduit::Error);
+
+    // truncated
+    save_packed_with_data_bytes(n,path,nbytes - 8);
+    EXPECT_THROW(PackedNode::load(path,n_load),conduit::Error);
+
+    // empty schema with data
+    Node n_empty;
+    save_packed_with_data_bytes(n_empty,path,64);
+    n_load.reset();
+    EXPECT_THROW(PackedNode::load(path,n_load),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_packed_node, invalid_images)
+{
+    Node n;
+    create_packed_test_node(n);
+
+    std::vector<uint8> image;
+    PackedNode::pack(n,image);
+    index_t nbytes = (index_t)image.size();
+
+    PackedNode::Header h;
+    memcpy(&h,&image[0],sizeof(h));
+
+    // header sizes that overflow
+    std::vector<uint8> bad(image);
+    PackedNode::Header bad_h = h;
+    bad_h.data_bytes = std::numeric_limits<int64>::max() - 8;
+    memcpy(&bad[0],&bad_h,sizeof(bad_h));
+    PackedNode pn;
+    EXPECT_THROW(pn.open(&bad[0],nbytes),conduit::Error);
+
+    bad_h = h;
+    bad_h.schema_bytes = std::numeric_limits<int64>::max() - 8;
+    memcpy(&bad[0],&bad_h,sizeof(bad_h));
+    EXPECT_THROW(pn.open(&bad[0],nbytes),conduit::Error);
+
+    // a leaf that points past the data block
+    bad = image;
+    FlatSchema fs;
+    fs.deserialize(&image[(size_t)h.schema_offset],h.schema_bytes);
+    index_t leaf_idx = fs.fetch_index("fields/p");
+    FlatSchema::Entry e;
+    size_t entry_pos = (size_t)h.schema_offset + 4 * sizeof(int64) +
+                       (size_t)leaf_idx * sizeof(e);
+    memcpy(&e,&bad[entry_pos],sizeof(e));
+    e.offset += h.data_bytes;
+    memcpy(&bad[entry_pos],&e,sizeof(e));
+    EXPECT_THROW(pn.open(&bad[0],nbytes),conduit::Error);
+    EXPECT_FALSE(pn.is_open());
+
+    std::string path = "tout_packed_node_invalid_span.conduit_packed";
+    std::ofstream ofs(path.c_str(),std::ios_base::binary);
+    ofs.write((const char*)&bad[0],(std::streamsize)bad.size());
+    ofs.close();
+
+    Node n_load;
+    EXPECT_THROW(PackedNode::load(path,n_load),conduit::Error);
+    Node n_mmap;
+    EXPECT_THROW(PackedNode::mmap(path,n_mmap),conduit::Error);
+
+    // the unmodified image still opens
+    pn.open(&image[0],nbytes);
+    EXPECT_TRUE(pn.is_open());
+}
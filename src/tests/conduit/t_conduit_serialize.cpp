@@ -51,7 +51,14 @@
 #include "conduit.hpp"
 
 #include <iostream>
+#include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 using namespace conduit;
 
 
@@ -233,3 +240,149 @@ TEST(conduit_serialize, seralize_multiple)
 }
 
 
+
+//-----------------------------------------------------------------------------
+TEST(conduit_serialize, serialized_size)
+{
+    Node n;
+    n["a"].set(DataType::float64(10));
+    n["b/c"].set(DataType::int32(5));
+    n["b/d"].set_int8(1);
+
+    EXPECT_EQ(n.serialized_size(), 10 * 8 + 5 * 4 + 1);
+    EXPECT_EQ(n.serialized_size(), n.total_bytes_compact());
+
+    // same sized updates keep the size
+    float64 vals[10] = {0,1,2,3,4,5,6,7,8,9};
+    n["a"].set(vals,10);
+    EXPECT_EQ(n.serialized_size(), 10 * 8 + 5 * 4 + 1);
+
+    // changes anywhere in the tree are reflected
+    n["b/c"].set(DataType::int32(7));
+    EXPECT_EQ(n.serialized_size(), 10 * 8 + 7 * 4 + 1);
+
+    n["b/e"].set_int64(2);
+    EXPECT_EQ(n.serialized_size(), 10 * 8 + 7 * 4 + 1 + 8);
+
+    n["b"].remove("d");
+    EXPECT_EQ(n.serialized_size(), 10 * 8 + 7 * 4 + 8);
+
+    n.reset();
+    EXPECT_EQ(n.serialized_size(), 0);
+    n.append().set_int16(1);
+    n.append().set_int16(2);
+    EXPECT_EQ(n.serialized_size(), 4);
+
+    // direct modification through the schema's dtype
+    Schema s;
+    s["x"].set(DataType::uint8(4));
+    EXPECT_EQ(s.total_bytes_compact(), 4);
+    s["x"].dtype().set_number_of_elements(6);
+    EXPECT_EQ(s.total_bytes_compact(), 6);
+
+    // a held dtype reference changed after the size was queried
+    DataType &x_dtype = s["x"].dtype();
+    EXPECT_EQ(s.total_bytes_compact(), 6);
+    x_dtype.set_number_of_elements(9);
+    EXPECT_EQ(s.total_bytes_compact(), 9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_serialize, serialize_to_and_deserialize_from)
+{
+    Node n;
+    n["a"].set(DataType::float64(4));
+    n["b"].set(DataType::int32(3));
+    // strided, non compact leaf
+    int64 strided[6] = {10,-1,20,-1,30,-1};
+    n["c"].set_external(strided,3,0,2*sizeof(int64));
+
+    float64 *a_ptr = n["a"].value();
+    int32   *b_ptr = n["b"].value();
+    for(int i=0;i<4;i++)
+        a_ptr[i] = i * 1.5;
+    for(int i=0;i<3;i++)
+        b_ptr[i] = i + 100;
+
+    index_t nbytes = n.serialized_size();
+    EXPECT_EQ(nbytes, 4 * 8 + 3 * 4 + 3 * 8);
+
+    std::vector<uint8> buff((size_t)nbytes + 16, 0);
+
+    // too small
+    EXPECT_THROW(n.serialize_to(&buff[0], nbytes - 1), conduit::Error);
+    EXPECT_EQ(n.serialize_to(&buff[0], (index_t)buff.size()), nbytes);
+
+    std::vector<uint8> ref;
+    n.serialize(ref);
+    EXPECT_EQ((index_t)ref.size(), nbytes);
+    EXPECT_EQ(memcmp(&ref[0], &buff[0], (size_t)nbytes), 0);
+
+    Schema s_compact;
+    n.schema().compact_to(s_compact);
+
+    Node res;
+    res.deserialize_from(s_compact, &buff[0], nbytes);
+    Node info;
+    EXPECT_FALSE(n.diff(res,info));
+
+    const void *res_data = res.data_ptr();
+    const void *res_c    = res["c"].data_ptr();
+
+    // steady state: same schema, buffers are reused in place
+    for(int step = 0; step < 3; step++)
+    {
+        a_ptr[0] = step;
+        strided[2] = step * 7;
+        n.serialize_to(&buff[0], (index_t)buff.size());
+        res.deserialize_from(s_compact, &buff[0], nbytes);
+        EXPECT_EQ(res.data_ptr(), res_data);
+        EXPECT_EQ(res["c"].data_ptr(), res_c);
+        EXPECT_FALSE(n.diff(res,info));
+    }
+
+    // a leaf set on its own breaks sharing, so the next call reallocates
+    res["b"].set(DataType::int32(3));
+    res.deserialize_from(s_compact, &buff[0], nbytes);
+    EXPECT_FALSE(n.diff(res,info));
+
+    // too few bytes for the schema
+    EXPECT_THROW(res.deserialize_from(s_compact, &buff[0], nbytes - 1),
+                 conduit::Error);
+
+    // vector serialize reuses capacity
+    std::vector<uint8> vbuff;
+    n.serialize(vbuff);
+    const uint8 *vbuff_ptr = &vbuff[0];
+    n.serialize(vbuff);
+    EXPECT_EQ((index_t)vbuff.size(), nbytes);
+    EXPECT_EQ(&vbuff[0], vbuff_ptr);
+
+    // empty node
+    Node empty;
+    EXPECT_EQ(empty.serialized_size(), 0);
+    EXPECT_EQ(empty.serialize_to(NULL, 0), 0);
+}
+
+//-----------------------------------------------------------------------------
+#if defined(__linux__)
+TEST(conduit_serialize, serialize_write_error_closes_file)
+{
+    Node n;
+    n["a"].set(DataType::float64(1000));
+    n["b"].set(DataType::int32(10));
+
+    // open returns the lowest free descriptor, so a leaked descriptor
+    // shows up as a different number
+    int fd_before = ::open("/dev/null",O_RDONLY);
+    ASSERT_TRUE(fd_before >= 0);
+    ::close(fd_before);
+
+    // writes to /dev/full fail with ENOSPC
+    EXPECT_THROW(n.serialize(std::string("/dev/full")),conduit::Error);
+
+    int fd_after = ::open("/dev/null",O_RDONLY);
+    EXPECT_EQ(fd_after,fd_before);
+    ::close(fd_after);
+}
+#endif
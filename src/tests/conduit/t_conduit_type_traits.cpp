@@ -0,0 +1,227 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: t_conduit_type_traits.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit.hpp"
+
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+//-----------------------------------------------------------------------------
+// structs used to test compile-time struct schemas
+//-----------------------------------------------------------------------------
+struct TestVec3
+{
+    conduit::float32 x;
+    conduit::float32 y;
+    conduit::float32 z;
+};
+
+struct TestParticle
+{
+    conduit::int8    kind;
+    TestVec3         pos;
+    conduit::float64 mass;
+    conduit::int32   id;
+};
+
+CONDUIT_STRUCT_SCHEMA_BEGIN(TestVec3)
+    CONDUIT_STRUCT_SCHEMA_FIELD(x)
+    CONDUIT_STRUCT_SCHEMA_FIELD(y)
+    CONDUIT_STRUCT_SCHEMA_FIELD(z)
+CONDUIT_STRUCT_SCHEMA_END()
+
+CONDUIT_STRUCT_SCHEMA_BEGIN(TestParticle)
+    CONDUIT_STRUCT_SCHEMA_FIELD(kind)
+    CONDUIT_STRUCT_SCHEMA_NESTED(pos)
+    CONDUIT_STRUCT_SCHEMA_FIELD(mass)
+    CONDUIT_STRUCT_SCHEMA_FIELD(id)
+CONDUIT_STRUCT_SCHEMA_END()
+
+using namespace conduit;
+
+//-----------------------------------------------------------------------------
+template<typename T>
+static T
+templated_sum(const Node &n)
+{
+    const DataArray<T> vals = n.as_array<T>();
+    T res = 0;
+    for(index_t i=0; i < vals.number_of_elements(); i++)
+    {
+        res += vals[i];
+    }
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_type_traits, data_type_traits)
+{
+    EXPECT_EQ((index_t)DataTypeTraits<int8>::id,DataType::INT8_ID);
+    EXPECT_EQ((index_t)DataTypeTraits<uint32>::id,DataType::UINT32_ID);
+    EXPECT_EQ((index_t)DataTypeTraits<float64>::id,DataType::FLOAT64_ID);
+
+    DataType dt = DataTypeTraits<int16>::dtype(5);
+    EXPECT_TRUE(dt.equals(DataType::int16(5)));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_type_traits, templated_set_and_as)
+{
+    Node n;
+    n.set<float32>(1.5);
+    EXPECT_EQ(n.dtype().id(),DataType::FLOAT32_ID);
+    EXPECT_EQ(n.as<float32>(),1.5f);
+    EXPECT_EQ(n.as_ptr<float32>(),n.as_float32_ptr());
+
+    n.set<int64>(42);
+    EXPECT_EQ(n.dtype().id(),DataType::INT64_ID);
+    EXPECT_EQ(n.as<int64>(),42);
+
+    std::vector<uint16> vals(4);
+    for(size_t i=0; i < vals.size(); i++)
+    {
+        vals[i] = (uint16)(i+1);
+    }
+    n.set<uint16>(vals);
+    EXPECT_EQ(n.dtype().number_of_elements(),4);
+    EXPECT_EQ(templated_sum<uint16>(n),10);
+
+    // strided source is compacted
+    n.set<uint16>(&vals[0],2,0,2*sizeof(uint16));
+    EXPECT_EQ(n.as_array<uint16>()[1],3);
+    EXPECT_TRUE(n.is_compact());
+
+    float64 ext[3] = {1.0, 2.0, 3.0};
+    n.set_external<float64>(ext,3);
+    EXPECT_EQ(n.as_ptr<float64>(),&ext[0]);
+    EXPECT_EQ(templated_sum<float64>(n),6.0);
+
+    // type mismatches are reported, and return empty values
+    EXPECT_THROW(n.as<int32>(),conduit::Error);
+    EXPECT_THROW(n.as_array<int32>(),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_type_traits, struct_schema)
+{
+    Schema s;
+    StructTraits<TestParticle>::schema(s,4);
+    
+    EXPECT_EQ(s.number_of_children(),4);
+    EXPECT_EQ(s["kind"].dtype().id(),DataType::INT8_ID);
+    EXPECT_EQ(s["mass"].dtype().offset(),
+              (index_t)offsetof(TestParticle,mass));
+    EXPECT_EQ(s["mass"].dtype().stride(),(index_t)sizeof(TestParticle));
+    EXPECT_EQ(s["mass"].dtype().number_of_elements(),4);
+    
+    // nested fields are strided by the outer struct
+    EXPECT_EQ(s["pos/y"].dtype().id(),DataType::FLOAT32_ID);
+    EXPECT_EQ(s["pos/y"].dtype().offset(),
+              (index_t)(offsetof(TestParticle,pos) + offsetof(TestVec3,y)));
+    EXPECT_EQ(s["pos/y"].dtype().stride(),(index_t)sizeof(TestParticle));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_type_traits, set_external_struct)
+{
+    TestParticle parts[3];
+    for(int i=0; i < 3; i++)
+    {
+        parts[i].kind  = (int8)i;
+        parts[i].pos.x = (float32)i;
+        parts[i].pos.y = (float32)(10 * i);
+        parts[i].pos.z = (float32)(100 * i);
+        parts[i].mass  = 0.5 * i;
+        parts[i].id    = 1000 + i;
+    }
+
+    Node n;
+    n.set_external_struct(parts,3);
+    EXPECT_EQ(n.data_ptr(),(void*)&parts[0]);
+
+    int32_array ids = n["id"].as_int32_array();
+    EXPECT_EQ(ids.number_of_elements(),3);
+    EXPECT_EQ(ids[2],1002);
+
+    float32_array ys = n["pos/y"].value();
+    EXPECT_EQ(ys[1],10.0f);
+
+    // changes through the node are seen by the structs
+    n["mass"].as_float64_array()[1] = 42.0;
+    EXPECT_EQ(parts[1].mass,42.0);
+
+    EXPECT_EQ(n.as_struct_ptr<TestParticle>(),&parts[0]);
+    // wrong layout is reported
+    EXPECT_THROW(n.as_struct_ptr<TestVec3>(),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_type_traits, set_struct)
+{
+    TestParticle parts[2];
+    memset(parts,0,sizeof(parts));
+    parts[0].id = 7;
+    parts[1].id = 8;
+    parts[1].pos.z = 3.0f;
+
+    Node n;
+    n.set_struct(parts,2);
+    EXPECT_NE(n.data_ptr(),(void*)&parts[0]);
+    EXPECT_EQ(n["id"].as_int32_array()[1],8);
+
+    TestParticle *copy = n.as_struct_ptr<TestParticle>();
+    EXPECT_EQ(copy[1].pos.z,3.0f);
+    EXPECT_EQ(copy[0].id,7);
+
+    // copy keeps the struct layout
+    TestParticle p = copy[1];
+    EXPECT_EQ(p.id,8);
+}
@@ -83,6 +83,43 @@ TEST(conduit_relay_io_basic, basic_bin)
     EXPECT_EQ(n_load["c"].as_uint32(), c_val);
 }
 
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_basic, packed)
+{
+    Node n;
+    n["a"] = (uint32)20;
+    n["b/c"].set(DataType::float64(5));
+    n["b/c"].as_float64_ptr()[4] = 4.0;
+
+    io::save(n, "test_conduit_relay_io_dump.conduit_packed");
+
+    Node n_load;
+    io::load("test_conduit_relay_io_dump.conduit_packed",n_load);
+    EXPECT_EQ(n_load["a"].as_uint32(), 20);
+    EXPECT_EQ(n_load["b/c"].as_float64_ptr()[4], 4.0);
+
+    // the protocol only depends on the extension
+    io::save(n, "test_conduit_relay_io_dump_packed","conduit_packed");
+    std::string protocol;
+    io::identify_protocol("test_conduit_relay_io_dump_packed",protocol);
+    EXPECT_EQ(protocol,"conduit_bin");
+
+    // but conduit_bin loads read packed files
+    n_load.reset();
+    io::load("test_conduit_relay_io_dump_packed",n_load);
+    EXPECT_EQ(n_load["a"].as_uint32(), 20);
+
+    // saving over a packed file without an extension writes conduit_bin
+    n["a"] = (uint32)30;
+    io::save(n, "test_conduit_relay_io_dump_packed");
+    EXPECT_FALSE(PackedNode::is_packed_file("test_conduit_relay_io_dump_packed"));
+    EXPECT_TRUE(utils::is_file("test_conduit_relay_io_dump_packed_json"));
+
+    n_load.reset();
+    io::load("test_conduit_relay_io_dump_packed",n_load);
+    EXPECT_EQ(n_load["a"].as_uint32(), 30);
+}
+
 //-----------------------------------------------------------------------------
 TEST(conduit_relay_io_basic, json)
 {
@@ -51,7 +51,11 @@
 #include "conduit_relay.hpp"
 #include "conduit_relay_hdf5.hpp"
 #include "hdf5.h"
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <sstream>
+#include <vector>
 #include "gtest/gtest.h"
 
 using namespace conduit;
@@ -795,3 +799,587 @@ TEST(conduit_relay_io_hdf5, hdf5_create_open_methods)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_write_append)
+{
+    std::string test_file_name = "tout_hdf5_write_append.hdf5";
+
+    // start fresh, appends extend an existing file
+    if(utils::is_file(test_file_name))
+    {
+        utils::remove_file(test_file_name);
+    }
+
+    Node opts;
+    opts["append"] = "true";
+
+    // first append creates the file and an extendible dataset
+    Node n;
+    n["step"].set(DataType::int64(3));
+
+    int64 *step_ptr = n["step"].value();
+    for(index_t step=0; step < 4; step++)
+    {
+        for(index_t i=0; i < 3; i++)
+        {
+            step_ptr[i] = step * 3 + i;
+        }
+        io::hdf5_write(n,test_file_name,opts);
+    }
+
+    // appending a strided leaf
+    std::vector<int64> vals(4,0);
+    vals[0] = 12; vals[2] = 13;
+    Node n_strided;
+    n_strided["step"].set_external(DataType::int64(2,
+                                                   0,
+                                                   2 * sizeof(int64)),
+                                   &vals[0]);
+    io::hdf5_write(n_strided,test_file_name,opts);
+
+    Node n_read;
+    io::hdf5_read(test_file_name,n_read);
+
+    EXPECT_EQ(n_read["step"].dtype().number_of_elements(),14);
+    int64_array step_vals = n_read["step"].value();
+    for(index_t i=0; i < 14; i++)
+    {
+        EXPECT_EQ(step_vals[i],i);
+    }
+
+    // a regular write truncates the file
+    io::hdf5_write(n,test_file_name);
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_EQ(n_read["step"].dtype().number_of_elements(),3);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_write_at_offset)
+{
+    std::string test_file_name = "tout_hdf5_write_at_offset.hdf5";
+
+    // fixed size dataset from a regular write
+    Node n;
+    n["fixed"].set(DataType::float64(8));
+    float64_array fixed_vals = n["fixed"].value();
+    for(index_t i=0; i < 8; i++)
+    {
+        fixed_vals[i] = 0.0;
+    }
+    io::hdf5_write(n,test_file_name);
+
+    Node n_part;
+    n_part["fixed"].set(DataType::float64(3));
+    float64_array part_vals = n_part["fixed"].value();
+    for(index_t i=0; i < 3; i++)
+    {
+        part_vals[i] = 1.5;
+    }
+
+    Node opts;
+    opts["offset"] = 4;
+    io::hdf5_write(n_part,test_file_name,opts);
+
+    Node n_read;
+    io::hdf5_read(test_file_name,n_read);
+    float64_array read_vals = n_read["fixed"].value();
+    EXPECT_EQ(read_vals.number_of_elements(),8);
+    for(index_t i=0; i < 8; i++)
+    {
+        EXPECT_EQ(read_vals[i], (i >= 4 && i < 7) ? 1.5 : 0.0);
+    }
+
+    // past the end of a fixed size dataset is incompatible
+    opts["offset"] = 6;
+    EXPECT_THROW(io::hdf5_write(n_part,test_file_name,opts),
+                 conduit::Error);
+
+    // appending to a fixed size dataset is incompatible
+    Node append_opts;
+    append_opts["append"] = "true";
+    EXPECT_THROW(io::hdf5_write(n_part,test_file_name,append_opts),
+                 conduit::Error);
+
+    // a dataset created by a partial write is extendible,
+    // an offset past its end grows it
+    opts["offset"] = 0;
+    n_part["grow"].set(DataType::int32(2));
+    n_part["grow"].as_int32_ptr()[0] = 10;
+    n_part["grow"].as_int32_ptr()[1] = 11;
+    hid_t h5_file_id = io::hdf5_open_file_for_read_write(test_file_name);
+    io::hdf5_write(n_part["grow"],h5_file_id,"grow",opts);
+    opts["offset"] = 5;
+    io::hdf5_write(n_part["grow"],h5_file_id,"grow",opts);
+    io::hdf5_close_file(h5_file_id);
+
+    n_read.reset();
+    io::hdf5_read(test_file_name + ":grow",n_read);
+    int32_array grow_vals = n_read.value();
+    EXPECT_EQ(grow_vals.number_of_elements(),7);
+    EXPECT_EQ(grow_vals[0],10);
+    EXPECT_EQ(grow_vals[1],11);
+    EXPECT_EQ(grow_vals[5],10);
+    EXPECT_EQ(grow_vals[6],11);
+
+    // offsets must be non-negative
+    opts["offset"] = -1;
+    EXPECT_THROW(io::hdf5_write(n_part,test_file_name,opts),
+                 conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_write_strided_leaves)
+{
+    std::string test_file_name = "tout_hdf5_write_strided.hdf5";
+
+    // interleaved xyz coords
+    float64 xyz[12];
+    for(index_t i=0; i < 12; i++)
+    {
+        xyz[i] = (float64) i;
+    }
+
+    Node n;
+    n["coords/x"].set_external(xyz,4,0 * sizeof(float64),3 * sizeof(float64));
+    n["coords/y"].set_external(xyz,4,1 * sizeof(float64),3 * sizeof(float64));
+    n["coords/z"].set_external(xyz,4,2 * sizeof(float64),3 * sizeof(float64));
+
+    // a stride that isn't a multiple of the element size
+    unsigned char packed[4 * 12];
+    for(index_t i=0; i < 4; i++)
+    {
+        int64 v = 100 + i;
+        memcpy(packed + i * 12, &v, sizeof(int64));
+    }
+    n["packed"].set_external(DataType::int64(4,0,12),packed);
+
+    io::hdf5_write(n,test_file_name);
+
+    Node n_read;
+    io::hdf5_read(test_file_name,n_read);
+
+    float64_array x_vals = n_read["coords/x"].value();
+    float64_array y_vals = n_read["coords/y"].value();
+    float64_array z_vals = n_read["coords/z"].value();
+    int64_array   p_vals = n_read["packed"].value();
+
+    EXPECT_EQ(x_vals.number_of_elements(),4);
+    EXPECT_EQ(p_vals.number_of_elements(),4);
+
+    for(index_t i=0; i < 4; i++)
+    {
+        EXPECT_EQ(x_vals[i], (float64) (i * 3));
+        EXPECT_EQ(y_vals[i], (float64) (i * 3 + 1));
+        EXPECT_EQ(z_vals[i], (float64) (i * 3 + 2));
+        EXPECT_EQ(p_vals[i], 100 + i);
+    }
+
+    // strided leaves also work with partial writes
+    Node opts;
+    opts["append"] = "true";
+    io::hdf5_write(n["coords"],test_file_name + ":appended",opts);
+    io::hdf5_write(n["coords"],test_file_name + ":appended",opts);
+
+    n_read.reset();
+    io::hdf5_read(test_file_name + ":appended",n_read);
+
+    z_vals = n_read["z"].value();
+    EXPECT_EQ(z_vals.number_of_elements(),8);
+    for(index_t i=0; i < 8; i++)
+    {
+        EXPECT_EQ(z_vals[i], (float64) ((i % 4) * 3 + 2));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_save_merged)
+{
+    std::string test_file_name = "tout_hdf5_save_merged.hdf5";
+
+    Node n;
+    n["a"] = 10;
+    io::save(n,test_file_name);
+
+    Node n2;
+    n2["b/c"] = 20;
+    io::save_merged(n2,test_file_name);
+
+    Node n_read;
+    io::load(test_file_name,n_read);
+    EXPECT_EQ(n_read["a"].to_int(),10);
+    EXPECT_EQ(n_read["b/c"].to_int(),20);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_file_cache)
+{
+    Node opts_before;
+    io::hdf5_options(opts_before);
+    EXPECT_EQ(opts_before["file_cache/max_open_files"].to_int(),0);
+
+    Node opts;
+    opts["file_cache/max_open_files"] = 2;
+    io::hdf5_set_options(opts);
+
+    std::string test_file_name = "tout_hdf5_file_cache.hdf5";
+
+    Node n;
+    n = 1;
+    io::hdf5_write(n,test_file_name + ":steps/0");
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    // later writes update the cached (open) file
+    Node write_opts;
+    write_opts["truncate"] = "false";
+    for(int i=1; i < 10; i++)
+    {
+        std::ostringstream oss;
+        oss << test_file_name << ":steps/" << i;
+        n = i + 1;
+        io::hdf5_write(n,oss.str(),write_opts);
+    }
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    Node n_read;
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_EQ(n_read["steps"].number_of_children(),10);
+    EXPECT_EQ(n_read["steps/9"].to_int(),10);
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    // the least recently used file is closed at the limit
+    io::hdf5_write(n,"tout_hdf5_file_cache_1.hdf5:v");
+    io::hdf5_write(n,"tout_hdf5_file_cache_2.hdf5:v");
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),2);
+
+    // a truncating write recreates the cached file
+    write_opts["truncate"] = "true";
+    io::hdf5_write(n,test_file_name + ":steps/0",write_opts);
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_EQ(n_read["steps"].number_of_children(),1);
+
+    io::hdf5_flush_cached_files();
+    io::hdf5_close_cached_files();
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),0);
+
+    opts["file_cache/flush"] = "bad";
+    EXPECT_THROW(io::hdf5_set_options(opts),conduit::Error);
+
+    // disabling the cache closes any open files
+    opts.reset();
+    opts["file_cache/max_open_files"] = 0;
+    io::hdf5_set_options(opts);
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),0);
+
+    Node opts_after;
+    io::hdf5_options(opts_after);
+    EXPECT_EQ(opts_after["file_cache/flush"].as_string(),"write");
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_file_cache_subtree_writes)
+{
+    Node opts;
+    opts["file_cache/max_open_files"] = 4;
+    io::hdf5_set_options(opts);
+
+    std::string test_file_name = "tout_hdf5_file_cache_subtrees.hdf5";
+    std::string moved_file_name = "tout_hdf5_file_cache_subtrees_moved.hdf5";
+    if(utils::is_file(moved_file_name))
+    {
+        utils::remove_file(moved_file_name);
+    }
+
+    Node n;
+    n["x"] = 1.0;
+    n["y"] = 2.0;
+    io::hdf5_write(n,test_file_name + ":steps/0");
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    // later writes go to the open file: if the file was reopened or 
+    // recreated, they would land in a new file at the old path
+    EXPECT_EQ(std::rename(test_file_name.c_str(),moved_file_name.c_str()),0);
+
+    for(int i=1; i < 5; i++)
+    {
+        std::ostringstream oss;
+        oss << test_file_name << ":steps/" << i;
+        n["x"] = (float64) i;
+        io::hdf5_write(n,oss.str());
+    }
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    // a failed write keeps the cached file usable
+    Node n_bad;
+    n_bad = "string";
+    EXPECT_THROW(io::hdf5_write(n_bad,test_file_name + ":steps/0"),
+                 conduit::Error);
+    EXPECT_EQ(io::hdf5_number_of_cached_files(),1);
+
+    io::hdf5_close_cached_files();
+    EXPECT_FALSE(utils::is_file(test_file_name));
+
+    Node n_read;
+    io::hdf5_read(moved_file_name,n_read);
+    EXPECT_EQ(n_read["steps"].number_of_children(),5);
+    for(int i=0; i < 5; i++)
+    {
+        float64 x_val = (i == 0) ? 1.0 : (float64) i;
+        EXPECT_EQ(n_read["steps"][i]["x"].to_float64(),x_val);
+        EXPECT_EQ(n_read["steps"][i]["y"].to_float64(),2.0);
+    }
+
+    opts["file_cache/max_open_files"] = 0;
+    io::hdf5_set_options(opts);
+}
+
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_write_small_leaves_as_attributes)
+{
+    std::string test_file_name = "tout_hdf5_small_leaves.hdf5";
+
+    Node n;
+    n["meta/cycle"] = 10;
+    n["meta/vals"].set(DataType::float64(100));
+    n["meta/time"] = 3.5;
+    n["meta/name"] = "run";
+    n["meta/flags"].set(DataType::int8(3));
+    n["fields/p"].set(DataType::float32(4));
+
+    Node opts;
+    opts["small_leaves/mode"] = "attributes";
+    io::hdf5_write(n,test_file_name,opts);
+
+    // only "vals" is larger than the default threshold
+    hid_t h5_file_id = io::hdf5_open_file_for_read(test_file_name);
+    H5G_info_t h5_group_info;
+    H5Gget_info_by_name(h5_file_id,"meta",&h5_group_info,H5P_DEFAULT);
+    EXPECT_EQ(h5_group_info.nlinks,(hsize_t)1);
+    EXPECT_TRUE(H5Aexists_by_name(h5_file_id,"meta","cycle",H5P_DEFAULT) > 0);
+    EXPECT_FALSE(H5Lexists(h5_file_id,"fields/p",H5P_DEFAULT) > 0);
+
+    EXPECT_TRUE(io::hdf5_has_path(h5_file_id,"meta/time"));
+    EXPECT_TRUE(io::hdf5_has_path(h5_file_id,"meta/vals"));
+    EXPECT_FALSE(io::hdf5_has_path(h5_file_id,"meta/conduit_child_order"));
+    io::hdf5_close_file(h5_file_id);
+
+    // leaves are restored in place
+    Node n_read, info;
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+    EXPECT_EQ(n_read["meta"].child_names(),n["meta"].child_names());
+    EXPECT_EQ(n_read["meta/name"].as_string(),"run");
+
+    n_read.reset();
+    io::hdf5_read(test_file_name + ":meta/time",n_read);
+    EXPECT_EQ(n_read.to_float64(),3.5);
+
+    // later writes keep the recorded order
+    Node write_opts;
+    write_opts.set(opts);
+    write_opts["truncate"] = "false";
+
+    Node n_step;
+    n_step["step"] = 2;
+    n["meta/step"] = 2;
+    io::hdf5_write(n_step,test_file_name + ":meta",write_opts);
+
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+    EXPECT_EQ(n_read["meta"].child_names(),n["meta"].child_names());
+
+    // a larger leaf written later replaces the attribute with a dataset
+    Node n_cycle;
+    n_cycle["cycle"].set(DataType::int64(100));
+    io::hdf5_write(n_cycle,test_file_name + ":meta",write_opts);
+
+    h5_file_id = io::hdf5_open_file_for_read(test_file_name);
+    EXPECT_FALSE(H5Aexists_by_name(h5_file_id,"meta","cycle",H5P_DEFAULT) > 0);
+    io::hdf5_close_file(h5_file_id);
+
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_EQ(n_read["meta/cycle"].dtype().number_of_elements(),100);
+    EXPECT_EQ(n_read["meta"].child_names(),n["meta"].child_names());
+
+    // the lazy tree reads attribute leaves on demand
+    io::HDF5LazyTree lazy;
+    lazy.open(test_file_name);
+    EXPECT_TRUE(lazy.has_path("meta/name"));
+    EXPECT_EQ(lazy.fetch("meta/name").as_string(),"run");
+    EXPECT_EQ(lazy.fetch("meta/step").to_int(),2);
+    lazy.close();
+
+    opts["small_leaves/mode"] = "bad";
+    EXPECT_THROW(io::hdf5_write(n,test_file_name,opts),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_create_virtual_index)
+{
+    // one file per "rank", rank 1 has no pressure values
+    std::vector<std::string> rank_files;
+    for(int r=0; r < 3; r++)
+    {
+        std::ostringstream oss;
+        oss << "tout_hdf5_vds_rank_" << r << ".hdf5";
+        rank_files.push_back(oss.str());
+
+        index_t num_vals = (r == 1) ? 0 : (r+1) * 10;
+        Node n;
+        n["fields/p"].set(std::vector<float64>(num_vals,(float64)r));
+        n["fields/ids"].set(std::vector<int32>(5,r));
+        n["meta/rank"] = (int32)r;
+        n["meta/name"] = "rank";
+        io::hdf5_write(n,rank_files.back());
+    }
+
+    std::vector<std::string> paths;
+    paths.push_back("fields");
+    paths.push_back("/meta/rank");
+
+    std::string index_file_name = "tout_hdf5_vds_index.hdf5";
+    io::hdf5_create_virtual_index(index_file_name,rank_files,paths);
+
+    Node n_read;
+    io::hdf5_read(index_file_name,n_read);
+    EXPECT_FALSE(n_read.has_path("meta/name"));
+
+    float64_array p_vals = n_read["fields/p"].value();
+    EXPECT_EQ(p_vals.number_of_elements(),40);
+    EXPECT_EQ(p_vals[0],0.0);
+    EXPECT_EQ(p_vals[9],0.0);
+    EXPECT_EQ(p_vals[10],2.0);
+    EXPECT_EQ(p_vals[39],2.0);
+
+    int32_array ids_vals = n_read["fields/ids"].value();
+    EXPECT_EQ(ids_vals.number_of_elements(),15);
+    EXPECT_EQ(ids_vals[7],1);
+
+    int32_array rank_vals = n_read["meta/rank"].value();
+    EXPECT_EQ(rank_vals.number_of_elements(),3);
+    EXPECT_EQ(rank_vals[2],2);
+
+    // the first row of each source is recorded
+    hid_t h5_file_id = io::hdf5_open_file_for_read(index_file_name);
+    hid_t h5_dset_id = H5Dopen(h5_file_id,"fields/p",H5P_DEFAULT);
+    hid_t h5_attr_id = H5Aopen(h5_dset_id,
+                               "conduit_source_offsets",
+                               H5P_DEFAULT);
+    int64 offsets[4] = {-1,-1,-1,-1};
+    H5Aread(h5_attr_id,H5T_NATIVE_INT64,offsets);
+    EXPECT_EQ(offsets[0],0);
+    EXPECT_EQ(offsets[1],10);
+    EXPECT_EQ(offsets[2],10);
+    EXPECT_EQ(offsets[3],40);
+    H5Aclose(h5_attr_id);
+    H5Dclose(h5_dset_id);
+    io::hdf5_close_file(h5_file_id);
+
+    // sources must agree on the dtype
+    Node n_bad;
+    n_bad["fields/p"].set(std::vector<int32>(10,0));
+    n_bad["fields/ids"].set(std::vector<int32>(5,0));
+    n_bad["meta/rank"] = (int32)3;
+    io::hdf5_write(n_bad,"tout_hdf5_vds_rank_bad.hdf5");
+    rank_files.push_back("tout_hdf5_vds_rank_bad.hdf5");
+
+    EXPECT_THROW(io::hdf5_create_virtual_index(index_file_name,
+                                               rank_files,
+                                               paths),
+                 conduit::Error);
+
+    // datasets that are empty in all sources can't be mapped, and no
+    // index file is created
+    std::vector<std::string> empty_files;
+    for(int r=0; r < 2; r++)
+    {
+        std::ostringstream oss;
+        oss << "tout_hdf5_vds_empty_rank_" << r << ".hdf5";
+        empty_files.push_back(oss.str());
+
+        Node n;
+        n["fields/ids"].set(std::vector<int32>(5,r));
+        n["fields/p"].set(DataType::empty());
+        io::hdf5_write(n,empty_files.back());
+    }
+
+    std::string empty_index_file_name = "tout_hdf5_vds_empty_index.hdf5";
+    if(utils::is_file(empty_index_file_name))
+    {
+        utils::remove_file(empty_index_file_name);
+    }
+
+    std::vector<std::string> field_paths;
+    field_paths.push_back("fields");
+
+    EXPECT_THROW(io::hdf5_create_virtual_index(empty_index_file_name,
+                                               empty_files,
+                                               field_paths),
+                 conduit::Error);
+    EXPECT_FALSE(utils::is_file(empty_index_file_name));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_create_virtual_index_attribute_leaves)
+{
+    // small leaves written as attributes can't be mapped
+    Node opts;
+    opts["small_leaves/mode"] = "attributes";
+
+    std::vector<std::string> rank_files;
+    for(int r=0; r < 2; r++)
+    {
+        std::ostringstream oss;
+        oss << "tout_hdf5_vds_attr_rank_" << r << ".hdf5";
+        rank_files.push_back(oss.str());
+
+        Node n;
+        n["fields/p"].set(std::vector<float64>(100,(float64)r));
+        n["meta/rank"] = (int32)r;
+        io::hdf5_write(n,rank_files.back(),opts);
+    }
+
+    std::string index_file_name = "tout_hdf5_vds_attr_index.hdf5";
+
+    // the leaf by name
+    std::vector<std::string> paths;
+    paths.push_back("meta/rank");
+    bool attr_error = false;
+    try
+    {
+        io::hdf5_create_virtual_index(index_file_name,rank_files,paths);
+    }
+    catch(conduit::Error &e)
+    {
+        CONDUIT_INFO(e.message());
+        attr_error = e.message().find("attribute") != std::string::npos;
+    }
+    EXPECT_TRUE(attr_error);
+
+    // a group that holds it, and the whole tree
+    paths[0] = "meta";
+    EXPECT_THROW(io::hdf5_create_virtual_index(index_file_name,
+                                               rank_files,
+                                               paths),
+                 conduit::Error);
+
+    paths.clear();
+    EXPECT_THROW(io::hdf5_create_virtual_index(index_file_name,
+                                               rank_files,
+                                               paths),
+                 conduit::Error);
+
+    // datasets still work
+    paths.push_back("fields");
+    io::hdf5_create_virtual_index(index_file_name,rank_files,paths);
+
+    Node n_read;
+    io::hdf5_read(index_file_name,n_read);
+    EXPECT_EQ(n_read["fields/p"].dtype().number_of_elements(),200);
+    EXPECT_EQ(n_read["fields/p"].as_float64_ptr()[150],1.0);
+}
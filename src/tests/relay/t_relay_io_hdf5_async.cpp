@@ -0,0 +1,177 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//-----------------------------------------------------------------------------
+///
+/// file: t_relay_io_hdf5_async.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit_relay.hpp"
+#include "conduit_relay_hdf5.hpp"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace conduit;
+using namespace conduit::relay;
+
+//-----------------------------------------------------------------------------
+std::string
+async_test_file_name(int step)
+{
+    std::ostringstream oss;
+    oss << "tout_hdf5_async_" << step << ".hdf5";
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_async, write_snapshots)
+{
+    io::HDF5AsyncWriter writer;
+    EXPECT_EQ(writer.max_pending(),2);
+
+    Node n;
+    n["state/step"] = 0;
+    n["state/vals"].set(std::vector<float64>(100000,0.0));
+
+    std::vector<index_t> handles;
+    for(int i=0; i < 4; i++)
+    {
+        n["state/step"] = i;
+        float64_array vals = n["state/vals"].value();
+        vals[0] = i;
+
+        handles.push_back(writer.write(n,async_test_file_name(i) + ":"));
+        // the queue is bounded
+        EXPECT_LE(writer.number_of_pending_writes(),2);
+        // writes use a snapshot, so we can change n right away
+    }
+
+    while(!writer.test(handles[3]))
+    {
+        // compute ...
+    }
+
+    for(int i=0; i < 3; i++)
+    {
+        writer.wait(handles[i]);
+    }
+    EXPECT_EQ(writer.number_of_pending_writes(),0);
+
+    for(int i=0; i < 4; i++)
+    {
+        Node n_read;
+        io::hdf5_read(async_test_file_name(i),n_read);
+        EXPECT_EQ(n_read["state/step"].to_int(),i);
+        EXPECT_EQ(n_read["state/vals"].as_float64_ptr()[0],(float64)i);
+        EXPECT_EQ(n_read["state/vals"].dtype().number_of_elements(),100000);
+    }
+
+    // handles are retired once reported, waiting again is a no-op
+    writer.wait(handles[0]);
+    EXPECT_TRUE(writer.test(handles[0]));
+    EXPECT_THROW(writer.wait(100),conduit::Error);
+    EXPECT_THROW(writer.set_max_pending(0),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_async, write_external_and_opts)
+{
+    io::HDF5AsyncWriter writer;
+    writer.set_max_pending(1);
+
+    Node n;
+    n["fields/p"].set(std::vector<int32>(1000,7));
+
+    Node opts;
+    opts["chunking/enabled"] = "false";
+
+    index_t h = writer.write_external(n,
+                                      async_test_file_name(10) + ":",
+                                      opts);
+    writer.wait(h);
+
+    Node n_read, info;
+    io::hdf5_read(async_test_file_name(10),n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+
+    // the destructor finishes pending writes
+    {
+        io::HDF5AsyncWriter scoped_writer;
+        scoped_writer.write(n,async_test_file_name(11) + ":");
+    }
+
+    n_read.reset();
+    io::hdf5_read(async_test_file_name(11),n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_async, write_errors)
+{
+    io::HDF5AsyncWriter writer;
+
+    Node n;
+    n["a"] = 1;
+
+    // errors are reported by the handle's wait or test
+    index_t h_bad = writer.write(n,"tout_hdf5_async_missing_dir/f.hdf5:");
+    index_t h_ok  = writer.write(n,async_test_file_name(20) + ":");
+
+    EXPECT_THROW(writer.wait(h_bad),conduit::Error);
+    writer.wait(h_ok);
+
+    // a reported error isn't reported again
+    EXPECT_TRUE(writer.test(h_bad));
+
+    writer.write(n,"tout_hdf5_async_missing_dir/f.hdf5:");
+    writer.write(n,async_test_file_name(21) + ":");
+    EXPECT_THROW(writer.wait_all(),conduit::Error);
+    EXPECT_EQ(writer.number_of_pending_writes(),0);
+
+    // the writer is usable after errors
+    writer.wait(writer.write(n,async_test_file_name(22) + ":"));
+    writer.wait_all();
+}
+
@@ -0,0 +1,200 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2014-2018, Lawrence Livermore National Security, LLC.
+// 
+// Produced at the Lawrence Livermore National Laboratory
+// 
+// LLNL-CODE-666778
+// 
+// All rights reserved.
+// 
+// This file is part of Conduit. 
+// 
+// For details, see: http://software.llnl.gov/conduit/.
+// 
+// Please also read conduit/LICENSE
+// 
+// Redistribution and use in source and binary forms, with or without 
+// modification, are permitted provided that the following conditions are met:
+// 
+// * Redistributions of source code must retain the above copyright notice, 
+//   this list of conditions and the disclaimer below.
+// 
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+// 
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE 
+// POSSIBILITY OF SUCH DAMAGE.
+// 
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: t_relay_io_hdf5_lazy.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "conduit_relay.hpp"
+#include "conduit_relay_hdf5.hpp"
+#include "hdf5.h"
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+using namespace conduit;
+using namespace conduit::relay;
+
+//-----------------------------------------------------------------------------
+void
+write_lazy_test_file(const std::string &file_name)
+{
+    Node n;
+    n["fields/a"].set(std::vector<float64>(100,1.0));
+    n["fields/b"].set(std::vector<int32>(50,2));
+    n["meta/name"] = "lazy";
+    n["meta/empty"].set(DataType::object());
+    n["none"];
+    io::hdf5_write(n,file_name);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_lazy, schema_and_fetch)
+{
+    std::string test_file_name = "tout_hdf5_lazy.hdf5";
+    write_lazy_test_file(test_file_name);
+
+    io::HDF5LazyTree tree;
+    EXPECT_FALSE(tree.is_open());
+    tree.open(test_file_name);
+    EXPECT_TRUE(tree.is_open());
+
+    // structure is available without loading any data
+    const Schema &s = tree.schema();
+    EXPECT_TRUE(s.has_path("fields/a"));
+    EXPECT_TRUE(s.has_path("meta/empty"));
+    EXPECT_EQ(s["fields/a"].dtype().id(),DataType::FLOAT64_ID);
+    EXPECT_EQ(s["fields/a"].dtype().number_of_elements(),100);
+    EXPECT_EQ(s["fields/b"].dtype().id(),DataType::INT32_ID);
+    EXPECT_TRUE(s["meta/name"].dtype().is_string());
+    EXPECT_TRUE(s["meta/empty"].dtype().is_object());
+    EXPECT_TRUE(s["none"].dtype().is_empty());
+    EXPECT_EQ(tree.number_of_cached_leaves(),0);
+    EXPECT_EQ(tree.cached_bytes(),0);
+
+    EXPECT_TRUE(tree.has_path("fields/b"));
+    EXPECT_FALSE(tree.has_path("fields/c"));
+
+    const Node &a = tree.fetch("fields/a");
+    EXPECT_EQ(a.dtype().number_of_elements(),100);
+    EXPECT_EQ(a.as_float64_ptr()[99],1.0);
+    EXPECT_TRUE(tree.is_loaded("fields/a"));
+    EXPECT_FALSE(tree.is_loaded("fields"));
+    EXPECT_EQ(tree.number_of_cached_leaves(),1);
+    EXPECT_EQ(tree.cached_bytes(),800);
+
+    // a cached leaf is not read again
+    EXPECT_EQ(&tree.fetch("fields/a"),&a);
+
+    // fetching a subtree loads all of its leaves
+    const Node &meta = tree.fetch("meta");
+    EXPECT_EQ(meta["name"].as_string(),"lazy");
+    EXPECT_TRUE(meta["empty"].dtype().is_object());
+
+    // the whole tree matches a regular read
+    Node n_read, info;
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(tree.fetch("").diff(n_read,info));
+    EXPECT_TRUE(tree.is_loaded(""));
+
+    EXPECT_THROW(tree.fetch("fields/c"),conduit::Error);
+
+    tree.close();
+    EXPECT_FALSE(tree.is_open());
+    EXPECT_EQ(tree.number_of_cached_leaves(),0);
+    EXPECT_THROW(tree.fetch("fields/a"),conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_lazy, cache_budget)
+{
+    std::string test_file_name = "tout_hdf5_lazy_budget.hdf5";
+    write_lazy_test_file(test_file_name);
+
+    io::HDF5LazyTree tree;
+    tree.open(test_file_name);
+    tree.set_cache_budget(1000);
+    EXPECT_EQ(tree.cache_budget(),1000);
+
+    // 800 + 200 bytes fit
+    tree.fetch("fields/a");
+    tree.fetch("fields/b");
+    EXPECT_EQ(tree.cached_bytes(),1000);
+    EXPECT_EQ(tree.number_of_cached_leaves(),2);
+
+    // touch a, so b is the least recently used
+    tree.fetch("fields/a");
+    EXPECT_EQ(tree.fetch("meta/name").as_string(),"lazy");
+    EXPECT_TRUE(tree.is_loaded("fields/a"));
+    EXPECT_FALSE(tree.is_loaded("fields/b"));
+    EXPECT_TRUE(tree.is_loaded("meta/name"));
+    EXPECT_LE(tree.cached_bytes(),1000);
+
+    // a is evicted to make room for b
+    EXPECT_EQ(tree.fetch("fields/b").as_int32_ptr()[49],2);
+    EXPECT_FALSE(tree.is_loaded("fields/a"));
+    EXPECT_TRUE(tree.is_loaded("fields/b"));
+
+    // the requested path is always loaded, even over budget
+    const Node &fields = tree.fetch("fields");
+    EXPECT_EQ(fields["a"].dtype().number_of_elements(),100);
+    EXPECT_EQ(fields["b"].dtype().number_of_elements(),50);
+    EXPECT_TRUE(tree.is_loaded("fields"));
+    EXPECT_FALSE(tree.is_loaded("meta"));
+    EXPECT_EQ(tree.cached_bytes(),1000);
+
+    // lowering the budget evicts right away
+    tree.set_cache_budget(300);
+    EXPECT_EQ(tree.number_of_cached_leaves(),1);
+    EXPECT_TRUE(tree.is_loaded("fields/b"));
+
+    tree.evict_all();
+    EXPECT_EQ(tree.number_of_cached_leaves(),0);
+    EXPECT_EQ(tree.cached_bytes(),0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5_lazy, open_hdf5_path)
+{
+    std::string test_file_name = "tout_hdf5_lazy_path.hdf5";
+    write_lazy_test_file(test_file_name);
+
+    io::HDF5LazyTree tree;
+
+    // a group inside the file
+    tree.open(test_file_name + ":fields");
+    EXPECT_TRUE(tree.has_path("b"));
+    EXPECT_FALSE(tree.has_path("fields"));
+    EXPECT_EQ(tree.fetch("b").dtype().number_of_elements(),50);
+
+    // a dataset
+    tree.open(test_file_name + ":fields/a");
+    EXPECT_EQ(tree.schema().dtype().number_of_elements(),100);
+    EXPECT_EQ(tree.fetch("").as_float64_ptr()[0],1.0);
+
+    EXPECT_THROW(tree.open(test_file_name + ":bad"),conduit::Error);
+    EXPECT_FALSE(tree.is_open());
+}
+
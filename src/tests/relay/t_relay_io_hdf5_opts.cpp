@@ -56,6 +56,13 @@
 #include <cstdlib> 
 
 #include <sstream>
+#include <vector>
+
+#if defined(CONDUIT_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
 
 using namespace conduit;
 using namespace conduit::relay;
@@ -79,6 +86,26 @@ rand_size(int smin, int smax)
     return smin + rand_float64() * (smax - smin + 1);
 }
 
+//-----------------------------------------------------------------------------
+// wall clock time in seconds. the hdf5 options mostly change the time
+// spent waiting on i/o, which cpu time (std::clock) does not include
+//-----------------------------------------------------------------------------
+float64
+wall_time()
+{
+#if defined(CONDUIT_PLATFORM_WINDOWS)
+    LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return float64(count.QuadPart) / float64(freq.QuadPart);
+#else
+    timeval tv;
+    gettimeofday(&tv,NULL);
+    return float64(tv.tv_sec) + float64(tv.tv_usec) * 1e-6;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 void
 rand_fill(float64_array &vals)
@@ -153,10 +180,346 @@ TEST(conduit_relay_io_hdf5, conduit_hdf5_write_synth)
     std::string ofile = opts["output_file"].as_string();
     
     CONDUIT_INFO("Writing to " << ofile);
+
+    // report wall times, to compare hdf5 options passed via --opts
+    float64 t_start = wall_time();
     io::hdf5_write(n,ofile);
+    float64 t_write = wall_time();
+
+    Node n_read;
+    io::hdf5_read(ofile,n_read);
+    float64 t_read = wall_time();
+
+    CONDUIT_INFO("write time (wall sec) = " << t_write - t_start);
+    CONDUIT_INFO("read time (wall sec) = "  << t_read  - t_write);
+
+    Node info;
+    EXPECT_FALSE(n.diff(n_read,info));
+}
+
+
+//-----------------------------------------------------------------------------
+// returns the layout of the dataset at path, and its chunk size and 
+// number of filters when chunked
+//-----------------------------------------------------------------------------
+H5D_layout_t
+dset_layout(hid_t h5_file_id,
+            const std::string &path,
+            hsize_t &chunk_size,
+            int &num_filters)
+{
+    hid_t h5_dset_id  = H5Dopen(h5_file_id,path.c_str(),H5P_DEFAULT);
+    hid_t h5_plist_id = H5Dget_create_plist(h5_dset_id);
+
+    H5D_layout_t res = H5Pget_layout(h5_plist_id);
+    chunk_size  = 0;
+    num_filters = 0;
+    if(res == H5D_CHUNKED)
+    {
+        H5Pget_chunk(h5_plist_id,1,&chunk_size);
+        num_filters = H5Pget_nfilters(h5_plist_id);
+    }
+
+    H5Pclose(h5_plist_id);
+    H5Dclose(h5_dset_id);
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, conduit_hdf5_write_per_call_opts)
+{
+    std::string test_file_name = "tout_hdf5_per_call_opts.hdf5";
 
+    Node defaults_before;
+    io::hdf5_options(defaults_before);
+
+    Node n;
+    n["fields/pressure"].set(std::vector<float64>(1000,1.0));
+    n["fields/mask"].set(std::vector<int8>(5000,1));
+    n["fields/small"].set(std::vector<int32>(4,2));
+    n["meta/counts"].set(std::vector<int64>(1000,3));
+
+    Node opts;
+    opts["compact_storage/enabled"] = "false";
+    opts["chunking/threshold"]  = 100;
+    opts["chunking/chunk_size"] = 3000;
+    opts["overrides/fields/mask/chunking/compression/method"] = "none";
+    opts["overrides/fields/small/compact_storage/enabled"] = "true";
+    opts["overrides/meta/chunking/enabled"] = "false";
+
+    io::hdf5_write(n,test_file_name,opts);
+
+    // the process wide defaults are untouched
+    Node defaults_after, info;
+    io::hdf5_options(defaults_after);
+    EXPECT_FALSE(defaults_before.diff(defaults_after,info));
+
+    hid_t h5_file_id = io::hdf5_open_file_for_read(test_file_name);
+
+    hsize_t chunk_size = 0;
+    int num_filters = 0;
+
+    // 8000 bytes split into 3 even chunks of at most 3000 bytes
+    EXPECT_EQ(dset_layout(h5_file_id,"fields/pressure",chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)334);
+    EXPECT_EQ(num_filters,2);
+
+    // 5000 bytes in 2 chunks: 1 byte elements, so each chunk holds 
+    // more elements, and no compression
+    EXPECT_EQ(dset_layout(h5_file_id,"fields/mask",chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)2500);
+    EXPECT_EQ(num_filters,0);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"fields/small",chunk_size,num_filters),
+              H5D_COMPACT);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"meta/counts",chunk_size,num_filters),
+              H5D_CONTIGUOUS);
+
+    io::hdf5_close_file(h5_file_id);
+
+    Node n_read;
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+
+    // overrides are relative to the node being written
+    Node sub_opts;
+    sub_opts["compact_storage/enabled"] = "false";
+    sub_opts["chunking/threshold"] = 100;
+    sub_opts["overrides/pressure/chunking/chunk_size"] = 4000;
+
+    h5_file_id = io::hdf5_open_file_for_read_write(test_file_name);
+    io::hdf5_write(n["fields"],h5_file_id,"copy/fields",sub_opts);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"copy/fields/pressure",
+                          chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)500);
+
+    // the default chunk_size (1 mb) holds the whole mask
+    EXPECT_EQ(dset_layout(h5_file_id,"copy/fields/mask",
+                          chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)5000);
+
+    // options given for a group apply to the whole subtree below it,
+    // and nested overrides apply on top of them
+    Node tree_opts;
+    tree_opts["compact_storage/enabled"] = "false";
+    tree_opts["chunking/threshold"] = 100;
+    tree_opts["overrides/copy/chunking/chunk_size"] = 2000;
+    tree_opts["overrides/copy/fields/mask/chunking/chunk_size"] = 1000;
+
+    Node n_tree;
+    n_tree["copy"].set_external(n);
+    io::hdf5_write(n_tree,h5_file_id,"tree",tree_opts);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"tree/copy/fields/pressure",
+                          chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)250);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"tree/copy/meta/counts",
+                          chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)250);
+
+    EXPECT_EQ(dset_layout(h5_file_id,"tree/copy/fields/mask",
+                          chunk_size,num_filters),
+              H5D_CHUNKED);
+    EXPECT_EQ(chunk_size,(hsize_t)1000);
+
+    io::hdf5_close_file(h5_file_id);
 }
 
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, conduit_hdf5_file_opts)
+{
+    std::string test_file_name = "tout_hdf5_file_opts.hdf5";
+
+    Node defaults_before;
+    io::hdf5_options(defaults_before);
+    EXPECT_EQ(defaults_before["file/libver/low"].as_string(),"latest");
+    EXPECT_EQ(defaults_before["file/page_size"].to_index_t(),0);
+
+    Node opts;
+    opts["file/meta_block_size"]       = 65536;
+    opts["file/small_data_block_size"] = 65536;
+    opts["file/sieve_buf_size"]        = 262144;
+    opts["file/chunk_cache/size"]      = 4194304;
+    opts["file/chunk_cache/nslots"]    = 10007;
+    opts["file/page_size"]             = 65536;
+    opts["file/page_buffer_size"]      = 1048576;
+    io::hdf5_set_options(opts);
+
+    Node n;
+    n["fields/pressure"].set(std::vector<float64>(100000,1.0));
+    n["fields/small"].set(std::vector<int32>(4,2));
+    io::hdf5_write(n,test_file_name);
+
+    hid_t h5_file_id = io::hdf5_open_file_for_read(test_file_name);
+
+    hid_t h5_fc_plist = H5Fget_create_plist(h5_file_id);
+    hsize_t page_size = 0;
+    H5Pget_file_space_page_size(h5_fc_plist,&page_size);
+    EXPECT_EQ(page_size,(hsize_t)65536);
+    H5Pclose(h5_fc_plist);
+
+    hid_t h5_fa_plist = H5Fget_access_plist(h5_file_id);
+    hsize_t meta_block_size = 0;
+    H5Pget_meta_block_size(h5_fa_plist,&meta_block_size);
+    EXPECT_EQ(meta_block_size,(hsize_t)65536);
+
+    int    mdc_nelmts  = 0;
+    size_t rdcc_nslots = 0;
+    size_t rdcc_nbytes = 0;
+    double rdcc_w0     = 0;
+    H5Pget_cache(h5_fa_plist,&mdc_nelmts,&rdcc_nslots,&rdcc_nbytes,&rdcc_w0);
+    EXPECT_EQ(rdcc_nslots,(size_t)10007);
+    EXPECT_EQ(rdcc_nbytes,(size_t)4194304);
+    H5Pclose(h5_fa_plist);
+
+    Node n_read, info;
+    io::hdf5_read(h5_file_id,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+    io::hdf5_close_file(h5_file_id);
+
+    // the page buffer is only used with files created with paging
+    opts.reset();
+    opts["file/page_size"] = 0;
+    io::hdf5_set_options(opts);
+    io::hdf5_write(n,test_file_name);
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+
+    // files readable by older hdf5 versions
+    opts.reset();
+    opts["file/libver/low"] = "earliest";
+    io::hdf5_set_options(opts);
+    io::hdf5_write(n,test_file_name);
+    n_read.reset();
+    io::hdf5_read(test_file_name,n_read);
+    EXPECT_FALSE(n.diff(n_read,info));
+
+    opts["file/libver/low"]  = "latest";
+    opts["file/libver/high"] = "earliest";
+    EXPECT_THROW(io::hdf5_set_options(opts),conduit::Error);
+    opts.reset();
+    opts["file/libver/low"]  = "bad";
+    EXPECT_THROW(io::hdf5_set_options(opts),conduit::Error);
+    opts.reset();
+    opts["file/sieve_buf_size"] = -1;
+    EXPECT_THROW(io::hdf5_set_options(opts),conduit::Error);
+
+    io::hdf5_set_options(defaults_before);
+
+    Node defaults_after;
+    io::hdf5_options(defaults_after);
+    EXPECT_FALSE(defaults_before.diff(defaults_after,info));
+}
+
+//-----------------------------------------------------------------------------
+// compares the wall time to write and read a tree with the default file
+// options against one tuned setting of each file option. reports the 
+// results, but doesn't assert on them (they depend on the file system)
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, conduit_hdf5_file_opts_bench)
+{
+    std::string test_file_name = "tout_hdf5_file_opts_bench.hdf5";
+
+    Node defaults_before;
+    io::hdf5_options(defaults_before);
+
+    // many small leaves (metadata heavy) and a few large ones
+    srand(0);
+    Node n;
+    std::ostringstream oss;
+    for(int i=0; i < 50; i++)
+    {
+        oss.str("");
+        oss << "domain_" << i;
+        Node &dom = n[oss.str()];
+        for(int j=0; j < 20; j++)
+        {
+            oss.str("");
+            oss << "small_" << j;
+            dom[oss.str()].set(DataType::float64(rand_size(1,64)));
+            float64_array vals = dom[oss.str()].value();
+            rand_fill(vals);
+        }
+        dom["values"].set(DataType::float64(20000));
+        float64_array vals = dom["values"].value();
+        rand_fill(vals);
+    }
+
+    Node configs;
+    configs["default"].set(DataType::object());
+    configs["libver_earliest/file/libver/low"] = "earliest";
+    configs["paging/file/page_size"]          = 65536;
+    configs["paging/file/page_buffer_size"]   = 4194304;
+    configs["aggregation/file/meta_block_size"]       = 1048576;
+    configs["aggregation/file/small_data_block_size"] = 1048576;
+    configs["sieve/file/sieve_buf_size"]      = 4194304;
+    // the chunk cache only applies to chunked datasets, so it is compared
+    // against chunked storage with the default cache
+    Node &chunked = configs["chunked"];
+    chunked["chunking/enabled"]   = "true";
+    chunked["chunking/threshold"] = 2000;
+    chunked["chunking/chunk_size"] = 100000;
+    chunked["chunking/compression/method"] = "none";
+    configs["chunk_cache"].set(chunked);
+    configs["chunk_cache/file/chunk_cache/size"]   = 16777216;
+    configs["chunk_cache/file/chunk_cache/nslots"] = 10007;
+
+    const int num_reps = 3;
+    Node results;
+
+    NodeConstIterator itr = configs.children();
+    while(itr.has_next())
+    {
+        const Node &config = itr.next();
+        io::hdf5_set_options(defaults_before);
+        io::hdf5_set_options(config);
+
+        // best of a few runs
+        float64 write_time = -1.0;
+        float64 read_time  = -1.0;
+        for(int r=0; r < num_reps; r++)
+        {
+            float64 t_start = wall_time();
+            io::hdf5_write(n,test_file_name);
+            float64 t_write = wall_time();
+
+            Node n_read;
+            io::hdf5_read(test_file_name,n_read);
+            float64 t_read = wall_time();
+
+            if(write_time < 0 || t_write - t_start < write_time)
+                write_time = t_write - t_start;
+            if(read_time < 0 || t_read - t_write < read_time)
+                read_time = t_read - t_write;
+
+            Node info;
+            EXPECT_FALSE(n.diff(n_read,info));
+        }
+
+        results[itr.name() + "/write"] = write_time;
+        results[itr.name() + "/read"]  = read_time;
+    }
+
+    io::hdf5_set_options(defaults_before);
+
+    CONDUIT_INFO("total data size = " << n.total_bytes_compact());
+    CONDUIT_INFO("hdf5 file options wall times (sec, best of "
+                 << num_reps << "):" << results.to_json());
+
+    Node defaults_after, info;
+    io::hdf5_options(defaults_after);
+    EXPECT_FALSE(defaults_before.diff(defaults_after,info));
+}
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
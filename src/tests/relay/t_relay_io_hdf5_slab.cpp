@@ -59,10 +59,11 @@ using namespace conduit::relay;
 
 
 //-----------------------------------------------------------------------------
-// This example tests reads of slabs from a hdf5 dataset.
+// This example tests reads of slabs from a hdf5 dataset using the hdf5
+// api directly.
 // 
-// we may provide something like this in in the relay hdf5 interface
-// in the future. 
+// relay provides this via hdf5_read() with slab options, which is tested
+// below.
 //-----------------------------------------------------------------------------
 bool
 hdf5_read_dset_slab(const std::string &file_path,
@@ -284,3 +285,143 @@ TEST(conduit_relay_io_hdf5, hdf5_dset_slab_read_test)
 
 
 
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_read_slab_opts)
+{
+    Node n;
+    n["full_data"].set(DataType::float64(20));
+    n["other"].set(DataType::int32(5));
+    float64 *vin = n["full_data"].value();
+    for(int i=0;i<20;i++)
+    {
+        vin[i] = i;
+    }
+    int32 *oin = n["other"].value();
+    for(int i=0;i<5;i++)
+    {
+        oin[i] = 100 + i;
+    }
+
+    io::hdf5_write(n,"tout_hdf5_slab_opts.hdf5");
+
+    // every other entry, starting at 1
+    Node opts;
+    opts["offset"] = 1;
+    opts["stride"] = 2;
+    opts["count"]  = 10;
+
+    Node nload;
+    io::hdf5_read("tout_hdf5_slab_opts.hdf5:full_data",opts,nload);
+    EXPECT_EQ(nload.dtype().number_of_elements(),10);
+    float64 *vload = nload.value();
+    for(int i=0;i<10;i++)
+    {
+        EXPECT_NEAR(vload[i],1.0 + i * 2.0,1e-3);
+    }
+
+    // count defaults to the rest of the dataset
+    opts.reset();
+    opts["offset"] = 15;
+    nload.reset();
+    io::hdf5_read("tout_hdf5_slab_opts.hdf5:full_data",opts,nload);
+    EXPECT_EQ(nload.dtype().number_of_elements(),5);
+    EXPECT_NEAR(nload.as_float64_ptr()[0],15.0,1e-3);
+
+    // a compatible dest keeps its buffer and size
+    const void *nload_ptr = nload.data_ptr();
+    opts["offset"] = 17;
+    io::hdf5_read("tout_hdf5_slab_opts.hdf5:full_data",opts,nload);
+    EXPECT_EQ(nload.data_ptr(),nload_ptr);
+    EXPECT_NEAR(nload.as_float64_ptr()[2],19.0,1e-3);
+
+    // group read with per dataset options
+    opts.reset();
+    opts["datasets/full_data/offset"] = 18;
+    Node gload;
+    io::hdf5_read("tout_hdf5_slab_opts.hdf5",opts,gload);
+    EXPECT_EQ(gload["full_data"].dtype().number_of_elements(),2);
+    EXPECT_NEAR(gload["full_data"].as_float64_ptr()[1],19.0,1e-3);
+    EXPECT_EQ(gload["other"].dtype().number_of_elements(),5);
+    EXPECT_EQ(gload["other"].as_int32_ptr()[4],104);
+
+    // out of bounds
+    opts.reset();
+    opts["offset"] = 10;
+    opts["count"]  = 11;
+    EXPECT_THROW(io::hdf5_read("tout_hdf5_slab_opts.hdf5:full_data",
+                               opts,
+                               nload),
+                 conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(conduit_relay_io_hdf5, hdf5_read_slab_2d_strided_dest)
+{
+    // create a 2d dataset (6 x 4) directly with hdf5
+    hid_t h5_file_id = io::hdf5_create_file("tout_hdf5_slab_2d.hdf5");
+    hsize_t dims[2] = {6,4};
+    hid_t h5_dspace_id = H5Screate_simple(2,dims,NULL);
+    hid_t h5_dset_id = H5Dcreate(h5_file_id,
+                                 "grid",
+                                 H5T_NATIVE_DOUBLE,
+                                 h5_dspace_id,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT,
+                                 H5P_DEFAULT);
+    double vals[24];
+    for(int i=0;i<24;i++)
+    {
+        vals[i] = i;
+    }
+    H5Dwrite(h5_dset_id,
+             H5T_NATIVE_DOUBLE,
+             H5S_ALL,
+             H5S_ALL,
+             H5P_DEFAULT,
+             vals);
+    H5Dclose(h5_dset_id);
+    H5Sclose(h5_dspace_id);
+    io::hdf5_close_file(h5_file_id);
+
+    // rows 1,3,5 and columns 2,3
+    Node opts;
+    int64 offset[2] = {1,2};
+    int64 stride[2] = {2,1};
+    int64 count[2]  = {3,2};
+    opts["offset"].set(offset,2);
+    opts["stride"].set(stride,2);
+    opts["count"].set(count,2);
+
+    Node nload;
+    io::hdf5_read("tout_hdf5_slab_2d.hdf5:grid",opts,nload);
+    EXPECT_EQ(nload.dtype().number_of_elements(),6);
+    float64 expected[6] = {6,7,14,15,22,23};
+    float64 *vload = nload.value();
+    for(int i=0;i<6;i++)
+    {
+        EXPECT_NEAR(vload[i],expected[i],1e-3);
+    }
+
+    // read into an interleaved (strided) destination
+    float64 interleaved[12];
+    for(int i=0;i<12;i++)
+    {
+        interleaved[i] = -1.0;
+    }
+    Node strided;
+    strided.set_external(interleaved,6,sizeof(float64),2*sizeof(float64));
+    io::hdf5_read("tout_hdf5_slab_2d.hdf5:grid",opts,strided);
+    EXPECT_EQ(strided.data_ptr(),(void*)interleaved);
+    for(int i=0;i<6;i++)
+    {
+        EXPECT_NEAR(interleaved[2*i],-1.0,1e-3);
+        EXPECT_NEAR(interleaved[2*i+1],expected[i],1e-3);
+    }
+
+    // option arity must match the dataset rank
+    opts.reset();
+    opts["offset"] = 1;
+    EXPECT_THROW(io::hdf5_read("tout_hdf5_slab_2d.hdf5:grid",opts,nload),
+                 conduit::Error);
+}